@@ -0,0 +1,262 @@
+/* ============================================================================================
+ * MS5611Altitude.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Pressure reference management and altitude conversion. The ground reference comes from
+ * a startup average that stops early once the standard error of the mean is small enough,
+ * and can follow slow weather drift while the application reports the vehicle on ground.
+ * Altitudes are computed against the QNH with one table-driven conversion per sample; the
+ * ground-relative output is the difference to the ground's own altitude, so neither needs
+ * a division once the reference is set.
+ */
+
+#include <MS5611Altitude.h>
+
+#define MS5611_ALTITUDE_K_CM          4433077   /**< 44330.77 m, standard-atmosphere scale height term */
+
+/* m^0.190263 for m = 1 + i/64, i = 0..65, Q30 (two guard entries for the quadratic step) */
+static const uint32_t MS5611_Altitude_Mantissa[66] = {
+	1073741824U, 1076913902U, 1080046708U, 1083141310U, 1086198735U, 1089219967U,
+	1092205950U, 1095157588U, 1098075754U, 1100961284U, 1103814982U, 1106637622U,
+	1109429950U, 1112192685U, 1114926518U, 1117632115U, 1120310122U, 1122961158U,
+	1125585823U, 1128184697U, 1130758339U, 1133307291U, 1135832074U, 1138333196U,
+	1140811147U, 1143266401U, 1145699417U, 1148110641U, 1150500503U, 1152869423U,
+	1155217806U, 1157546046U, 1159854525U, 1162143614U, 1164413673U, 1166665052U,
+	1168898091U, 1171113122U, 1173310464U, 1175490432U, 1177653328U, 1179799449U,
+	1181929083U, 1184042511U, 1186140005U, 1188221831U, 1190288249U, 1192339511U,
+	1194375863U, 1196397546U, 1198404793U, 1200397833U, 1202376889U, 1204342178U,
+	1206293912U, 1208232298U, 1210157540U, 1212069833U, 1213969373U, 1215856346U,
+	1217730937U, 1219593327U, 1221443691U, 1223282202U, 1225109027U, 1226924333U
+};
+
+/* 2^(0.190263 * e) for e = -7..0, Q30 */
+static const uint32_t MS5611_Altitude_Exponent[8] = {
+	426555729U, 486688013U, 555297246U, 633578439U, 722895065U, 824802806U, 941076654U, 1073741824U
+};
+
+/**
+ * @brief  Returns the per-reference factor of the altitude converter
+ * @param  reference Reference pressure, Pa
+ * @retval uint64_t 2^46 / reference
+ */
+uint64_t MS5611_Altitude_Inverse(int32_t reference){
+	if (reference < MS5611_REFERENCE_PRESSURE_MIN)
+		reference = MS5611_REFERENCE_PRESSURE_MIN;
+
+	return ((uint64_t) 1 << 46) / (uint64_t) reference;
+}
+
+/**
+ * @brief  Standard-atmosphere altitude of a pressure above a reference level
+ * @param  pressure Pressure, Pa
+ * @param  inverse MS5611_Altitude_Inverse of the reference pressure
+ * @retval int32_t Altitude, cm
+ */
+int32_t MS5611_Altitude_Cm(int32_t pressure, uint64_t inverse){
+	uint64_t ratio;
+	uint32_t mantissa;
+	uint32_t t;
+	uint8_t msb;
+	uint8_t index;
+	int64_t f0, f1, f2;
+	int64_t power;
+
+	if (pressure < 1)
+		pressure = 1;
+
+	/* p / p0 in Q30, clamped to 2^-7 .. 2 */
+	ratio = ((uint64_t) pressure * inverse) >> 16;
+	if (ratio >= (1ULL << 31))
+		ratio = (1ULL << 31) - 1U;
+	else if (ratio < (1ULL << 23))
+		ratio = 1ULL << 23;
+
+	/* ratio = 2^e * m with m in [1, 2): e selects the exponent factor, m the table segment */
+	msb = (uint8_t) (31 - __builtin_clz((uint32_t) ratio));
+	mantissa = (uint32_t) ratio << (30 - msb);
+	index = (uint8_t) ((mantissa >> 24) & 0x3F);
+	t = mantissa & 0x00FFFFFFU;
+
+	/* Newton forward quadratic through three table points, t in Q24 */
+	f0 = MS5611_Altitude_Mantissa[index];
+	f1 = MS5611_Altitude_Mantissa[index + 1];
+	f2 = MS5611_Altitude_Mantissa[index + 2];
+	power = f0 + (((f1 - f0) * t) >> 24) +
+	        (((((int64_t) t * ((int64_t) t - (1L << 24))) >> 25) * (f2 - 2 * f1 + f0)) >> 24);
+	power = (power * MS5611_Altitude_Exponent[msb - 23]) >> 30;
+
+	return (int32_t) ((MS5611_ALTITUDE_K_CM * ((1LL << 30) - power) + (1LL << 29)) >> 30);
+}
+
+/**
+ * @brief  Initializes a reference manager and starts the startup average
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @param  budget Startup samples at most, 1..MS5611_REFERENCE_BUDGET_MAX
+ * @param  min_samples Startup samples at least before early termination
+ * @param  se_threshold Standard error of the mean that ends the average early, Pa Q4; 0 disables
+ * @retval None
+ */
+void MS5611_Reference_Init(MS5611_Reference_TypeDef *ref, uint16_t budget, uint16_t min_samples, uint16_t se_threshold){
+	if (budget == 0)
+		budget = 1;
+	else if (budget > MS5611_REFERENCE_BUDGET_MAX)
+		budget = MS5611_REFERENCE_BUDGET_MAX;
+
+	ref->budget = budget;
+	ref->min_samples = (min_samples < 2) ? 2 : min_samples;
+	ref->se_threshold = se_threshold;
+	ref->drift_shift = 8;
+	ref->drift_gate = 50;
+	ref->on_ground = 0;
+	ref->ground = MS5611_REFERENCE_QNH_STD;
+	ref->ground_captured = MS5611_REFERENCE_QNH_STD;
+	ref->ground_q8 = MS5611_REFERENCE_QNH_STD << 8;
+	ref->ground_msl_cm = 0;
+	ref->qnh = MS5611_REFERENCE_QNH_STD;
+	ref->qnh_inverse = MS5611_Altitude_Inverse(MS5611_REFERENCE_QNH_STD);
+	MS5611_Reference_Rezero(ref);
+}
+
+/**
+ * @brief  Restarts the startup average, keeping configuration and QNH
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @retval None
+ */
+void MS5611_Reference_Rezero(MS5611_Reference_TypeDef *ref){
+	ref->state = MS5611_REF_AVERAGING;
+	ref->count = 0;
+	ref->first = 0;
+	ref->sum = 0;
+	ref->sum_sq = 0;
+}
+
+/**
+ * @brief  Sets the QNH used for the msl output
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @param  qnh QNH, Pa
+ * @retval None
+ */
+void MS5611_Reference_Set_QNH(MS5611_Reference_TypeDef *ref, int32_t qnh){
+	ref->qnh = qnh;
+	ref->qnh_inverse = MS5611_Altitude_Inverse(qnh);
+	ref->ground_msl_cm = MS5611_Altitude_Cm(ref->ground, ref->qnh_inverse);
+}
+
+/**
+ * @brief  Sets the ground hint that enables drift tracking
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @param  on_ground Non-zero while the vehicle is known to be stationary on the ground
+ * @retval None
+ */
+void MS5611_Reference_Set_Ground_Hint(MS5611_Reference_TypeDef *ref, uint8_t on_ground){
+	ref->on_ground = on_ground;
+}
+
+/**
+ * @brief  Sets the ground reference
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @param  ground Ground pressure, Pa
+ * @retval None
+ */
+static void MS5611_Reference_Set_Ground(MS5611_Reference_TypeDef *ref, int32_t ground){
+	ref->ground = ground;
+	ref->ground_msl_cm = MS5611_Altitude_Cm(ground, ref->qnh_inverse);
+}
+
+/**
+ * @brief  Adds one startup sample and completes the average when converged
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @param  pressure Compensated pressure, Pa
+ * @retval None
+ */
+static void MS5611_Reference_Average(MS5611_Reference_TypeDef *ref, int32_t pressure){
+	int32_t deviation;
+	uint64_t n;
+	uint8_t done;
+
+	if (ref->count == 0)
+		ref->first = pressure;
+
+	deviation = pressure - ref->first;
+	if (deviation > 32767)
+		deviation = 32767;
+	else if (deviation < -32767)
+		deviation = -32767;
+
+	ref->sum += deviation;
+	ref->sum_sq += (int64_t) deviation * deviation;
+	ref->count++;
+	n = ref->count;
+
+	/* SE^2 = (n*S2 - S1^2) / (n^2 (n-1)) <= (thr/16)^2, cross-multiplied */
+	done = (ref->count >= ref->budget);
+	if (!done && ref->se_threshold != 0 && ref->count >= ref->min_samples)
+		done = 256U * (uint64_t) ((int64_t) n * ref->sum_sq - ref->sum * ref->sum) <=
+		       (uint64_t) ref->se_threshold * ref->se_threshold * n * n * (n - 1U);
+
+	if (!done)
+		return;
+
+	/* The one division of the reference, rounded to nearest */
+	ref->ground_captured = ref->first + (int32_t) ((ref->sum >= 0) ? (ref->sum + (int64_t) (n / 2U)) / (int64_t) n :
+	                                                                -((-ref->sum + (int64_t) (n / 2U)) / (int64_t) n));
+	ref->ground_q8 = ref->ground_captured << 8;
+	MS5611_Reference_Set_Ground(ref, ref->ground_captured);
+	ref->state = MS5611_REF_READY;
+}
+
+/**
+ * @brief  Feeds one compensated pressure sample
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @param  pressure Compensated pressure, Pa
+ * @param  out Pointer to store the altitudes, written only when the result is MS5611_REF_READY
+ * @retval MS5611RefStateTypeDef State after this sample
+ */
+MS5611RefStateTypeDef MS5611_Reference_Update(MS5611_Reference_TypeDef *ref, int32_t pressure, MS5611_Altitude_TypeDef *out){
+	int32_t offset;
+
+	if (ref->state == MS5611_REF_AVERAGING) {
+		MS5611_Reference_Average(ref, pressure);
+		if (ref->state == MS5611_REF_AVERAGING)
+			return MS5611_REF_AVERAGING;
+	} else if (ref->on_ground) {
+		/* Weather drift: follow the ground slowly while the vehicle is known to sit on it */
+		offset = pressure - ref->ground;
+		if ((uint32_t) (offset < 0 ? -offset : offset) <= ref->drift_gate) {
+			int32_t tracked;
+
+			ref->ground_q8 += ((pressure << 8) - ref->ground_q8) >> ref->drift_shift;
+			tracked = (ref->ground_q8 + 128) >> 8;
+			if (tracked != ref->ground)
+				MS5611_Reference_Set_Ground(ref, tracked);
+		}
+	}
+
+	out->msl_cm = MS5611_Altitude_Cm(pressure, ref->qnh_inverse);
+	out->agl_cm = out->msl_cm - ref->ground_msl_cm;
+
+	return MS5611_REF_READY;
+}
+
+/**
+ * @brief  Ground pressure change tracked since the startup average
+ * @param  ref Pointer to MS5611_Reference_TypeDef structure
+ * @retval int32_t Drift, Pa
+ */
+int32_t MS5611_Reference_Drift(const MS5611_Reference_TypeDef *ref){
+	return ref->ground - ref->ground_captured;
+}
@@ -0,0 +1,143 @@
+/* ============================================================================================
+ * MS5611Altitude.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611ALTITUDE_H_
+#define _MS5611ALTITUDE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// --- Reference Configuration ---
+#define MS5611_REFERENCE_BUDGET_MAX   1024U     /**< Largest startup sample budget */
+#define MS5611_REFERENCE_QNH_STD      101325    /**< Standard sea-level pressure, Pa */
+#define MS5611_REFERENCE_PRESSURE_MIN 1000      /**< Smallest accepted reference, Pa */
+
+// --- Reference States ---
+typedef enum MS5611RefStates{
+  MS5611_REF_AVERAGING,   /**< Collecting startup samples, no ground reference yet */
+  MS5611_REF_READY        /**< Ground reference set, altitude outputs valid */
+}MS5611RefStateTypeDef;
+
+// --- Altitude Output ---
+typedef struct {
+  int32_t msl_cm;         /**< Altitude above the QNH level (pressure altitude with the standard QNH), cm */
+  int32_t agl_cm;         /**< Altitude above the ground reference, cm */
+} MS5611_Altitude_TypeDef;
+
+// --- Pressure Reference Manager ---
+typedef struct {
+  uint16_t budget;          /**< Startup samples at most */
+  uint16_t min_samples;     /**< Startup samples at least, before early termination */
+  uint16_t se_threshold;    /**< Early termination when the standard error of the mean is below this, Pa Q4 */
+  uint8_t drift_shift;      /**< Ground drift tracking EWMA, alpha = 2^-drift_shift */
+  uint32_t drift_gate;      /**< Samples further than this from the ground (Pa) are not tracked */
+  uint8_t on_ground;        /**< Application hint, non-zero enables drift tracking */
+
+  // Managed state, do not set
+  MS5611RefStateTypeDef state;  /**< Averaging or ready */
+  uint16_t count;           /**< Startup samples taken */
+  int32_t first;            /**< First startup sample, sums run relative to it */
+  int64_t sum;              /**< Sum of startup deviations */
+  int64_t sum_sq;           /**< Sum of squared startup deviations */
+  int32_t ground;           /**< Ground reference pressure, Pa */
+  int32_t ground_captured;  /**< Ground pressure when the startup average completed, Pa */
+  int32_t ground_q8;        /**< Drift tracking state, Pa Q8 */
+  int32_t qnh;              /**< QNH, Pa */
+  uint64_t qnh_inverse;     /**< MS5611_Altitude_Inverse(qnh) */
+  int32_t ground_msl_cm;    /**< Altitude of the ground reference above the QNH level, cm */
+} MS5611_Reference_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Returns the per-reference factor of the altitude converter
+ * @note   The only division of the converter; call when the reference changes
+ * @param  reference Reference pressure, Pa
+ * @retval uint64_t 2^46 / reference
+ */
+uint64_t MS5611_Altitude_Inverse(int32_t reference);
+
+/**
+ * @brief  Standard-atmosphere altitude of a pressure above a reference level
+ * @note   44330.77 m * (1 - (p / p0)^0.190263) in integer arithmetic without division:
+ *         quadratic interpolation of m^0.190263 on a 64-segment table plus a power-of-two
+ *         factor, rounded to the nearest cm. Within 0.8 cm of the formula for p / p0 in
+ *         1/128 .. 2 (tools/ms5611_altitude_check.c), clamped outside.
+ * @param  pressure Pressure, Pa
+ * @param  inverse MS5611_Altitude_Inverse of the reference pressure
+ * @retval int32_t Altitude, cm
+ */
+int32_t MS5611_Altitude_Cm(int32_t pressure, uint64_t inverse);
+
+/**
+ * @brief  Initializes a reference manager and starts the startup average
+ * @note   Defaults: standard QNH, drift tracking off, drift EWMA 2^-8, drift gate 50 Pa
+ * @param  ref Pointer to reference manager
+ * @param  budget Startup samples at most, 1..MS5611_REFERENCE_BUDGET_MAX
+ * @param  min_samples Startup samples at least before early termination
+ * @param  se_threshold Standard error of the mean that ends the average early, Pa Q4; 0 disables
+ */
+void MS5611_Reference_Init(MS5611_Reference_TypeDef *ref, uint16_t budget, uint16_t min_samples, uint16_t se_threshold);
+
+/**
+ * @brief  Restarts the startup average, keeping configuration and QNH
+ * @param  ref Pointer to reference manager
+ */
+void MS5611_Reference_Rezero(MS5611_Reference_TypeDef *ref);
+
+/**
+ * @brief  Sets the QNH used for the msl output
+ * @param  ref Pointer to reference manager
+ * @param  qnh QNH, Pa
+ */
+void MS5611_Reference_Set_QNH(MS5611_Reference_TypeDef *ref, int32_t qnh);
+
+/**
+ * @brief  Sets the ground hint that enables drift tracking
+ * @param  ref Pointer to reference manager
+ * @param  on_ground Non-zero while the vehicle is known to be stationary on the ground
+ */
+void MS5611_Reference_Set_Ground_Hint(MS5611_Reference_TypeDef *ref, uint8_t on_ground);
+
+/**
+ * @brief  Feeds one compensated pressure sample
+ * @note   No division per sample: the startup variance check is cross-multiplied, and
+ *         the converter uses the reciprocal prepared when the QNH changes
+ * @param  ref Pointer to reference manager
+ * @param  pressure Compensated pressure, Pa
+ * @param  out Pointer to store the altitudes, written only when the result is MS5611_REF_READY
+ * @retval MS5611RefStateTypeDef State after this sample
+ */
+MS5611RefStateTypeDef MS5611_Reference_Update(MS5611_Reference_TypeDef *ref, int32_t pressure, MS5611_Altitude_TypeDef *out);
+
+/**
+ * @brief  Ground pressure change tracked since the startup average
+ * @param  ref Pointer to reference manager
+ * @retval int32_t Drift, Pa
+ */
+int32_t MS5611_Reference_Drift(const MS5611_Reference_TypeDef *ref);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611ALTITUDE_H_ */
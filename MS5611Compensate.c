@@ -0,0 +1,401 @@
+/* ============================================================================================
+ * MS5611Compensate.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#include <MS5611Compensate.h>
+
+#if MS5611_CONFIG_KERNEL_REFERENCE
+/**
+ * @brief  Converts raw ADC data to compensated pressure and temperature
+ * @note   Datasheet first and second order compensation, no HAL dependency
+ * @param  prom Pointer to promData structure with calibration values
+ * @param  sample Pointer to MS5611_Raw_Data_TypeDef structure
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Compensate(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value){
+	int32_t dT;
+	int32_t TEMP;
+	int64_t OFF;
+	int64_t SENS;
+
+	dT = sample->temperature - ((int32_t) (prom->tref << 8));
+
+	TEMP = 2000 + (((int64_t) dT * prom->tempsens) >> 23);
+
+	OFF = ((int64_t) prom->off << 16) + (((int64_t) prom->tco * dT) >> 7);
+	SENS = ((int64_t) prom->sens << 15) + (((int64_t) prom->tcs * dT) >> 8);
+
+
+	if (TEMP < 2000) {
+		int32_t T2 = ((int64_t) dT * (int64_t) dT) >> 31;
+		int32_t TEMPM = TEMP - 2000;
+		int64_t OFF2 = (5 * (int64_t) TEMPM * (int64_t) TEMPM) >> 1;
+		int64_t SENS2 = (5 * (int64_t) TEMPM * (int64_t) TEMPM) >> 2;
+		if (TEMP < -1500) {
+			int32_t TEMPP = TEMP + 1500;
+			int32_t TEMPP2 = TEMPP * TEMPP;
+			OFF2 = OFF2 + (int64_t) 7 * TEMPP2;
+			SENS2 = SENS2 + (((int64_t) 11 * TEMPP2) >> 1);
+		}
+		TEMP -= T2;
+		OFF -= OFF2;
+		SENS -= SENS2;
+	}
+
+	value->pressure = ((((int64_t) sample->pressure * SENS) >> 21) - OFF) >> 15;
+	value->temperature = TEMP;
+
+}
+#endif /* MS5611_CONFIG_KERNEL_REFERENCE */
+
+/**
+ * @brief  Expands PROM words into a prepared calibration block
+ * @note   Call once per sensor after the PROM is read; MS5611_Init does this for its handle
+ * @param  prom Pointer to promData structure with calibration values
+ * @param  cal Pointer to MS5611_Calibration_TypeDef structure to fill
+ * @retval None
+ */
+void MS5611_Calibration_Prepare(const struct promData *prom, MS5611_Calibration_TypeDef *cal){
+	cal->off_base = (int64_t) prom->off << 16;
+	cal->sens_base = (int64_t) prom->sens << 15;
+	cal->tco = prom->tco;
+	cal->tcs = prom->tcs;
+	cal->tempsens = prom->tempsens;
+	cal->d2_ref = (uint32_t) prom->tref << 8;
+	cal->reserved = 0;
+}
+
+/**
+ * @brief  Converts raw ADC data using a prepared calibration block
+ * @note   Same arithmetic as MS5611_Compensate with the PROM shifts and widenings hoisted
+ *         into MS5611_Calibration_Prepare, so only data-dependent work remains per sample
+ * @param  cal Pointer to MS5611_Calibration_TypeDef structure
+ * @param  sample Pointer to MS5611_Raw_Data_TypeDef structure
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Compensate_Cached(const MS5611_Calibration_TypeDef *cal, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value){
+	int32_t dT;
+	int32_t TEMP;
+	int64_t OFF;
+	int64_t SENS;
+
+	dT = (int32_t) (sample->temperature - cal->d2_ref);
+
+	TEMP = 2000 + (int32_t) ((dT * cal->tempsens) >> 23);
+
+	OFF = cal->off_base + ((cal->tco * dT) >> 7);
+	SENS = cal->sens_base + ((cal->tcs * dT) >> 8);
+
+	/* OFF2/SENS2 depend on TEMP alone; a per-TEMP table was measured and not adopted (README) */
+	if (TEMP < 2000) {
+		int32_t T2 = ((int64_t) dT * (int64_t) dT) >> 31;
+		int32_t TEMPM = TEMP - 2000;
+		int64_t OFF2 = (5 * (int64_t) TEMPM * (int64_t) TEMPM) >> 1;
+		int64_t SENS2 = (5 * (int64_t) TEMPM * (int64_t) TEMPM) >> 2;
+		if (TEMP < -1500) {
+			int32_t TEMPP = TEMP + 1500;
+			int32_t TEMPP2 = TEMPP * TEMPP;
+			OFF2 = OFF2 + (int64_t) 7 * TEMPP2;
+			SENS2 = SENS2 + (((int64_t) 11 * TEMPP2) >> 1);
+		}
+		TEMP -= T2;
+		OFF -= OFF2;
+		SENS -= SENS2;
+	}
+
+	value->pressure = ((((int64_t) sample->pressure * SENS) >> 21) - OFF) >> 15;
+	value->temperature = TEMP;
+}
+
+#if MS5611_CONFIG_KERNEL_BATCH
+/**
+ * @brief  Converts column arrays of raw samples
+ * @note   Prepares the calibration once per call and runs MS5611_Compensate_Cached
+ * @param  prom Pointer to promData structure with calibration values
+ * @param  d1 Raw pressure words
+ * @param  d2 Raw temperature words
+ * @param  pressure Array to store compensated pressure
+ * @param  temperature Array to store compensated temperature
+ * @param  count Number of samples
+ * @retval None
+ */
+void MS5611_Compensate_Batch(const struct promData *prom, const uint32_t *d1, const uint32_t *d2,
+                             int32_t *pressure, int32_t *temperature, uint32_t count){
+	MS5611_Calibration_TypeDef cal;
+	MS5611_Raw_Data_TypeDef sample;
+	MS5611_Converted_Data_TypeDef value;
+	uint32_t i;
+
+	MS5611_Calibration_Prepare(prom, &cal);
+	for (i = 0; i < count; i++) {
+		sample.pressure = d1[i];
+		sample.temperature = d2[i];
+		MS5611_Compensate_Cached(&cal, &sample, &value);
+		pressure[i] = value.pressure;
+		temperature[i] = value.temperature;
+	}
+}
+#endif /* MS5611_CONFIG_KERNEL_BATCH */
+
+/**
+ * @brief  Computes the 4-bit PROM CRC
+ * @note   Algorithm from TE application note AN520, CRC word itself masked out
+ * @param  prom Pointer to promData structure
+ * @retval uint8_t CRC, compare with prom->crc & 0x000F
+ */
+uint8_t MS5611_Prom_CRC4(const struct promData *prom){
+	const uint16_t *words = (const uint16_t *) prom;
+	uint16_t remainder = 0;
+	uint16_t word;
+	uint8_t cnt, bit;
+
+	for (cnt = 0; cnt < 16; cnt++) {
+		word = (cnt >> 1 == 7) ? (words[7] & 0xFF00) : words[cnt >> 1];
+		if (cnt & 1)
+			remainder ^= word & 0x00FF;
+		else
+			remainder ^= word >> 8;
+
+		for (bit = 8; bit > 0; bit--) {
+			if (remainder & 0x8000)
+				remainder = (uint16_t) ((remainder << 1) ^ 0x3000);
+			else
+				remainder = (uint16_t) (remainder << 1);
+		}
+	}
+
+	return (uint8_t) ((remainder >> 12) & 0x000F);
+}
+
+#if MS5611_CONFIG_KERNEL_INT32
+/* --- 32-bit compensation ---------------------------------------------------------------
+ * Every int64_t of MS5611_Compensate is carried as two 32-bit words in two's complement.
+ * Add, subtract, multiply and shift below are exact modulo 2^64, and no intermediate of the
+ * reference exceeds int64 for 24-bit D1/D2 and any PROM (|SENS| < 2^36, |OFF| < 2^37,
+ * |D1 * SENS| < 2^60), so both paths yield identical bits. Products are built from 16x16
+ * partial products, which a Cortex-M0+ MULS handles without overflow.
+ */
+
+typedef struct {
+	uint32_t lo;
+	uint32_t hi;
+} MS5611_Wide_TypeDef;
+
+/**
+ * @brief  Full 32x32 -> 64 unsigned multiply from 16-bit partial products
+ * @param  a Multiplicand
+ * @param  b Multiplier
+ * @retval MS5611_Wide_TypeDef Product
+ */
+static MS5611_Wide_TypeDef MS5611_Wide_Mul(uint32_t a, uint32_t b){
+	MS5611_Wide_TypeDef r;
+	uint32_t al = a & 0xFFFF, ah = a >> 16;
+	uint32_t bl = b & 0xFFFF, bh = b >> 16;
+	uint32_t ll = al * bl;
+	uint32_t lh = al * bh;
+	uint32_t hl = ah * bl;
+	uint32_t mid = (ll >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+
+	r.lo = (ll & 0xFFFF) | (mid << 16);
+	r.hi = ah * bh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+
+	return r;
+}
+
+/**
+ * @brief  Signed 32 x unsigned 32 multiply, two's complement 64-bit result
+ * @param  a Signed multiplicand
+ * @param  b Unsigned multiplier
+ * @retval MS5611_Wide_TypeDef Product
+ */
+static MS5611_Wide_TypeDef MS5611_Wide_Mul_Signed(int32_t a, uint32_t b){
+	MS5611_Wide_TypeDef r = MS5611_Wide_Mul((uint32_t) a, b);
+
+	/* (uint32_t) a = a + 2^32 for negative a, so the product is b * 2^32 too large */
+	if (a < 0)
+		r.hi -= b;
+
+	return r;
+}
+
+/**
+ * @brief  64-bit addition
+ * @param  a First operand
+ * @param  b Second operand
+ * @retval MS5611_Wide_TypeDef a + b
+ */
+static MS5611_Wide_TypeDef MS5611_Wide_Add(MS5611_Wide_TypeDef a, MS5611_Wide_TypeDef b){
+	MS5611_Wide_TypeDef r;
+
+	r.lo = a.lo + b.lo;
+	r.hi = a.hi + b.hi + (r.lo < a.lo);
+
+	return r;
+}
+
+/**
+ * @brief  64-bit subtraction
+ * @param  a Minuend
+ * @param  b Subtrahend
+ * @retval MS5611_Wide_TypeDef a - b
+ */
+static MS5611_Wide_TypeDef MS5611_Wide_Sub(MS5611_Wide_TypeDef a, MS5611_Wide_TypeDef b){
+	MS5611_Wide_TypeDef r;
+
+	r.lo = a.lo - b.lo;
+	r.hi = a.hi - b.hi - (a.lo < b.lo);
+
+	return r;
+}
+
+/**
+ * @brief  Arithmetic right shift, as int64_t >> n
+ * @param  a Operand
+ * @param  n Shift, 1..31
+ * @retval MS5611_Wide_TypeDef a >> n, rounded toward minus infinity
+ */
+static MS5611_Wide_TypeDef MS5611_Wide_Shr(MS5611_Wide_TypeDef a, uint8_t n){
+	MS5611_Wide_TypeDef r;
+
+	r.lo = (a.lo >> n) | (a.hi << (32 - n));
+	r.hi = (uint32_t) ((int32_t) a.hi >> n);
+
+	return r;
+}
+
+/**
+ * @brief  Converts raw ADC data using 32-bit arithmetic only
+ * @note   Bit-exact with MS5611_Compensate for every PROM and 24-bit D1/D2; see above.
+ *         TEMP + 1500 squared wraps in int32 in both paths below -478.4 degC.
+ * @param  prom Pointer to promData structure with calibration values
+ * @param  sample Pointer to MS5611_Raw_Data_TypeDef structure
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Compensate_Int32(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value){
+	MS5611_Wide_TypeDef OFF;
+	MS5611_Wide_TypeDef SENS;
+	MS5611_Wide_TypeDef base;
+	int32_t dT;
+	int32_t TEMP;
+
+	dT = sample->temperature - ((int32_t) (prom->tref << 8));
+
+	TEMP = 2000 + (int32_t) MS5611_Wide_Shr(MS5611_Wide_Mul_Signed(dT, prom->tempsens), 23).lo;
+
+	base.lo = (uint32_t) prom->off << 16;
+	base.hi = (uint32_t) prom->off >> 16;
+	OFF = MS5611_Wide_Add(base, MS5611_Wide_Shr(MS5611_Wide_Mul_Signed(dT, prom->tco), 7));
+
+	base.lo = (uint32_t) prom->sens << 15;
+	base.hi = 0;
+	SENS = MS5611_Wide_Add(base, MS5611_Wide_Shr(MS5611_Wide_Mul_Signed(dT, prom->tcs), 8));
+
+	if (TEMP < 2000) {
+		uint32_t absDT = (dT < 0) ? 0U - (uint32_t) dT : (uint32_t) dT;
+		int32_t T2 = (int32_t) MS5611_Wide_Shr(MS5611_Wide_Mul(absDT, absDT), 31).lo;
+		uint32_t TEMPM = 2000U - (uint32_t) TEMP;
+		MS5611_Wide_TypeDef square = MS5611_Wide_Mul(TEMPM, TEMPM);
+		MS5611_Wide_TypeDef square5 = MS5611_Wide_Mul(square.lo, 5);
+		MS5611_Wide_TypeDef OFF2;
+		MS5611_Wide_TypeDef SENS2;
+
+		square5.hi += square.hi * 5;
+		OFF2 = MS5611_Wide_Shr(square5, 1);
+		SENS2 = MS5611_Wide_Shr(square5, 2);
+
+		if (TEMP < -1500) {
+			int32_t TEMPP = TEMP + 1500;
+			int32_t TEMPP2 = (int32_t) ((uint32_t) TEMPP * (uint32_t) TEMPP);
+			OFF2 = MS5611_Wide_Add(OFF2, MS5611_Wide_Mul_Signed(TEMPP2, 7));
+			SENS2 = MS5611_Wide_Add(SENS2, MS5611_Wide_Shr(MS5611_Wide_Mul_Signed(TEMPP2, 11), 1));
+		}
+		TEMP -= T2;
+		OFF = MS5611_Wide_Sub(OFF, OFF2);
+		SENS = MS5611_Wide_Sub(SENS, SENS2);
+	}
+
+	/* D1 * SENS modulo 2^64: low word times D1 in full, high word times D1 truncated */
+	base = MS5611_Wide_Mul(SENS.lo, sample->pressure);
+	base.hi += SENS.hi * sample->pressure;
+
+	value->pressure = (int32_t) MS5611_Wide_Shr(MS5611_Wide_Sub(MS5611_Wide_Shr(base, 21), OFF), 15).lo;
+	value->temperature = TEMP;
+}
+#endif /* MS5611_CONFIG_KERNEL_INT32 */
+
+#if MS5611_CONFIG_FLOAT
+/**
+ * @brief  Converts raw ADC data in single-precision floating point
+ * @note   Same formula with the shifts as exact power-of-two scale factors and no intermediate
+ *         flooring. D1, D2 and dT are exact in a float; rounding stays below 0.04 Pa against an
+ *         exact evaluation. It differs more from MS5611_Compensate, which floors TEMP before the
+ *         second-order terms: up to ~10 Pa at -40 degC, under 1 Pa above 20 degC.
+ *         Only worthwhile where floats run on an FPU (Cortex-M4F/M33).
+ * @param  prom Pointer to promData structure with calibration values
+ * @param  sample Pointer to MS5611_Raw_Data_TypeDef structure
+ * @param  value Pointer to MS5611_Float_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Compensate_Float(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, MS5611_Float_Data_TypeDef *value){
+	float dT;
+	float TEMP;
+	float OFF;
+	float SENS;
+
+	dT = (float) (int32_t) (sample->temperature - ((int32_t) (prom->tref << 8)));
+
+	TEMP = 2000.0f + dT * (float) prom->tempsens * 0x1p-23f;
+
+	OFF = (float) prom->off * 65536.0f + (float) prom->tco * dT * 0x1p-7f;
+	SENS = (float) prom->sens * 32768.0f + (float) prom->tcs * dT * 0x1p-8f;
+
+	if (TEMP < 2000.0f) {
+		float TEMPM = TEMP - 2000.0f;
+		float TEMPM2 = TEMPM * TEMPM;
+		float OFF2 = 2.5f * TEMPM2;
+		float SENS2 = 1.25f * TEMPM2;
+		if (TEMP < -1500.0f) {
+			float TEMPP = TEMP + 1500.0f;
+			float TEMPP2 = TEMPP * TEMPP;
+			OFF2 += 7.0f * TEMPP2;
+			SENS2 += 5.5f * TEMPP2;
+		}
+		TEMP -= dT * dT * 0x1p-31f;
+		OFF -= OFF2;
+		SENS -= SENS2;
+	}
+
+	value->pressure = ((float) sample->pressure * SENS * 0x1p-21f - OFF) * 0x1p-15f;
+	value->temperature = TEMP * 0.01f;
+}
+
+/**
+ * @brief  Converts an integer result to Pa and degC
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure
+ * @param  out Pointer to MS5611_Float_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Converted_To_Float(const MS5611_Converted_Data_TypeDef *value, MS5611_Float_Data_TypeDef *out){
+	out->pressure = (float) value->pressure;
+	out->temperature = (float) value->temperature * 0.01f;
+}
+
+#endif /* MS5611_CONFIG_FLOAT */
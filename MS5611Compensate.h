@@ -0,0 +1,181 @@
+/* ============================================================================================
+ * MS5611Compensate.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611COMPENSATE_H_
+#define _MS5611COMPENSATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "MS5611Config.h"
+
+// --- PROM Data Structure ---
+struct promData{
+  uint16_t reserved;
+  uint16_t sens;
+  uint16_t off;
+  uint16_t tcs;
+  uint16_t tco;
+  uint16_t tref;
+  uint16_t tempsens;
+  uint16_t crc;
+};
+
+// --- Raw Sensor Values ---
+typedef struct MS5611UncompensatedValues{
+  uint32_t pressure;     /**< Uncompensated pressure */
+  uint32_t temperature;  /**< Uncompensated temperature */
+} MS5611_Raw_Data_TypeDef;
+
+// --- Compensated Sensor Values ---
+typedef struct MS5611Readings{
+  int32_t pressure;      /**< Compensated pressure */
+  int32_t temperature;   /**< Compensated temperature */
+} MS5611_Converted_Data_TypeDef;
+
+// --- Sample Record Flags ---
+#define MS5611_SAMPLE_D1_RAIL         0x01  /**< D1 was 0 or full scale */
+#define MS5611_SAMPLE_D2_RAIL         0x02  /**< D2 was 0 or full scale */
+#define MS5611_SAMPLE_GLITCH          0x04  /**< Glitch filter flagged or replaced D1 or D2 */
+#define MS5611_SAMPLE_D2_REUSED       0x08  /**< Temperature taken from an earlier pair (decimation) */
+#define MS5611_SAMPLE_RETRIED         0x10  /**< Bus errors occurred since the previous sample */
+#define MS5611_SAMPLE_RECOVERED       0x20  /**< First sample after a bus-fault recovery */
+#define MS5611_SAMPLE_OSR_CHANGED     0x40  /**< OSR differs from the previous sample */
+#define MS5611_SAMPLE_INVALID         0x80  /**< Rail word or result outside the sensor range, drop it */
+
+#define MS5611_SAMPLE_PRESSURE_MIN    1000      /**< Sensor range, Pa */
+#define MS5611_SAMPLE_PRESSURE_MAX    120000
+#define MS5611_SAMPLE_TEMPERATURE_MIN (-4000)   /**< Sensor range, 0.01 degC */
+#define MS5611_SAMPLE_TEMPERATURE_MAX 8500
+
+// --- Extended Sample Record, 24 bytes ---
+typedef struct {
+  MS5611_Converted_Data_TypeDef value;  /**< Compensated sample */
+  uint32_t stamp;                       /**< D1 read timestamp, ticks */
+  uint32_t d2_age;                      /**< Ticks from the D2 read to the D1 read */
+  uint32_t sequence;                    /**< Sample sequence number */
+  uint8_t osr;                          /**< MS5611_OSR_* of the pair */
+  uint8_t flags;                        /**< MS5611_SAMPLE_* flags */
+  uint8_t retries;                      /**< Bus errors since the previous sample, saturating */
+  uint8_t reserved;
+} MS5611_Sample_TypeDef;
+
+// --- Prepared Calibration, expanded from the PROM once per sensor ---
+typedef struct {
+  int64_t off_base;      /**< C2 * 2^16 */
+  int64_t sens_base;     /**< C1 * 2^15 */
+  int64_t tco;           /**< C4, widened */
+  int64_t tcs;           /**< C3, widened */
+  int64_t tempsens;      /**< C6, widened */
+  uint32_t d2_ref;       /**< C5 * 2^8 */
+  uint32_t reserved;     /**< Pads the block to a multiple of 8 bytes */
+} MS5611_Calibration_TypeDef;
+
+// --- Compensated Sensor Values, floating point ---
+typedef struct {
+  float pressure;        /**< Compensated pressure, Pa */
+  float temperature;     /**< Compensated temperature, degC */
+} MS5611_Float_Data_TypeDef;
+
+// --- Function Prototypes ---
+
+#if MS5611_CONFIG_KERNEL_REFERENCE
+/**
+ * @brief  Converts one raw sample using the given PROM calibration
+ * @param  prom Pointer to PROM data structure
+ * @param  sample Pointer to raw data structure
+ * @param  value Pointer to converted data structure
+ */
+void MS5611_Compensate(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value);
+#endif /* MS5611_CONFIG_KERNEL_REFERENCE */
+
+/**
+ * @brief  Expands PROM words into a prepared calibration block
+ * @param  prom Pointer to PROM data structure
+ * @param  cal Pointer to calibration block to fill
+ */
+void MS5611_Calibration_Prepare(const struct promData *prom, MS5611_Calibration_TypeDef *cal);
+
+/**
+ * @brief  Converts one raw sample using a prepared calibration block
+ * @note   Bit-exact with MS5611_Compensate
+ * @param  cal Pointer to calibration block
+ * @param  sample Pointer to raw data structure
+ * @param  value Pointer to converted data structure
+ */
+void MS5611_Compensate_Cached(const MS5611_Calibration_TypeDef *cal, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value);
+
+#if MS5611_CONFIG_KERNEL_INT32
+/**
+ * @brief  Converts one raw sample with 32-bit arithmetic only, for cores without a 64-bit multiply
+ * @note   Bit-exact with MS5611_Compensate over every PROM and 24-bit D1/D2
+ * @param  prom Pointer to PROM data structure
+ * @param  sample Pointer to raw data structure
+ * @param  value Pointer to converted data structure
+ */
+void MS5611_Compensate_Int32(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value);
+#endif /* MS5611_CONFIG_KERNEL_INT32 */
+
+#if MS5611_CONFIG_FLOAT
+/**
+ * @brief  Converts one raw sample in single-precision floating point
+ * @note   Output is not floored to whole Pa / 0.01 degC; see MS5611Compensate.c for accuracy
+ * @param  prom Pointer to PROM data structure
+ * @param  sample Pointer to raw data structure
+ * @param  value Pointer to floating-point data structure, Pa and degC
+ */
+void MS5611_Compensate_Float(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, MS5611_Float_Data_TypeDef *value);
+
+/**
+ * @brief  Converts an integer result to Pa and degC
+ * @param  value Pointer to converted data structure
+ * @param  out Pointer to floating-point data structure
+ */
+void MS5611_Converted_To_Float(const MS5611_Converted_Data_TypeDef *value, MS5611_Float_Data_TypeDef *out);
+#endif /* MS5611_CONFIG_FLOAT */
+
+/**
+ * @brief  Computes the 4-bit PROM CRC (AN520)
+ * @param  prom Pointer to PROM data structure
+ * @retval uint8_t CRC, compare with prom->crc & 0x000F
+ */
+uint8_t MS5611_Prom_CRC4(const struct promData *prom);
+
+#if MS5611_CONFIG_KERNEL_BATCH
+/**
+ * @brief  Converts column arrays of raw samples using the given PROM calibration
+ * @note   Bit-exact with MS5611_Compensate
+ * @param  prom Pointer to PROM data structure
+ * @param  d1 Raw pressure words
+ * @param  d2 Raw temperature words
+ * @param  pressure Array to store compensated pressure
+ * @param  temperature Array to store compensated temperature
+ * @param  count Number of samples
+ */
+void MS5611_Compensate_Batch(const struct promData *prom, const uint32_t *d1, const uint32_t *d2,
+                             int32_t *pressure, int32_t *temperature, uint32_t count);
+#endif /* MS5611_CONFIG_KERNEL_BATCH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611COMPENSATE_H_ */
@@ -0,0 +1,97 @@
+/* ============================================================================================
+ * MS5611Config.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Build-time feature selection. Every switch defaults to 1 (everything built) and can be
+ * overridden with -D on the compiler command line. Defining MS5611_CONFIG_MINIMAL changes
+ * the default of every switch to 0, so a budget build names only what it needs, e.g.
+ * -DMS5611_CONFIG_MINIMAL -DMS5611_CONFIG_ASYNC=1. tools/footprint.sh reports the cost of
+ * each switch.
+ *
+ * The driver converts with MS5611_Compensate_Cached, which is always built, or with
+ * MS5611_Compensate_Int32 when MS5611_USE_INT32_COMPENSATION is defined. The
+ * MS5611_CONFIG_KERNEL_* switches only decide which of the other kernels are compiled.
+ */
+
+#ifndef _MS5611CONFIG_H_
+#define _MS5611CONFIG_H_
+
+#if defined(MS5611_CONFIG_MINIMAL)
+#define MS5611_CONFIG_DEFAULT         0
+#else
+#define MS5611_CONFIG_DEFAULT         1
+#endif
+
+// --- Floating-Point Output (MS5611_Compensate_Float, *_To_Float, *_Convert_Float) ---
+#ifndef MS5611_CONFIG_FLOAT
+#define MS5611_CONFIG_FLOAT           MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Statistics (MS5611Stats module, per-handle latency and jitter statistics) ---
+#ifndef MS5611_CONFIG_STATS
+#define MS5611_CONFIG_STATS           MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Glitch Filters (MS5611Filter module, acquisition engine filter hooks) ---
+#ifndef MS5611_CONFIG_FILTER
+#define MS5611_CONFIG_FILTER          MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Per-Handle Calibration; 0 shares the calibration of the last MS5611_Init ---
+#ifndef MS5611_CONFIG_MULTI_INSTANCE
+#define MS5611_CONFIG_MULTI_INSTANCE  MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Non-Blocking Acquisition Engine, adaptive OSR and bus-fault recovery ---
+#ifndef MS5611_CONFIG_ASYNC
+#define MS5611_CONFIG_ASYNC           MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Thermal Lag Model (MS5611Thermal module, acquisition engine model hook) ---
+#ifndef MS5611_CONFIG_THERMAL
+#define MS5611_CONFIG_THERMAL         MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Sample Hub (MS5611Hub module, acquisition engine hub hook) ---
+#ifndef MS5611_CONFIG_HUB
+#define MS5611_CONFIG_HUB             MS5611_CONFIG_DEFAULT
+#endif
+
+// --- Reference Kernel (MS5611_Compensate, datasheet arithmetic line by line) ---
+#ifndef MS5611_CONFIG_KERNEL_REFERENCE
+#define MS5611_CONFIG_KERNEL_REFERENCE  MS5611_CONFIG_DEFAULT
+#endif
+
+// --- 32-Bit Kernel (MS5611_Compensate_Int32), forced on by MS5611_USE_INT32_COMPENSATION ---
+#ifndef MS5611_CONFIG_KERNEL_INT32
+#if defined(MS5611_USE_INT32_COMPENSATION)
+#define MS5611_CONFIG_KERNEL_INT32    1
+#else
+#define MS5611_CONFIG_KERNEL_INT32    MS5611_CONFIG_DEFAULT
+#endif
+#endif
+
+#if defined(MS5611_USE_INT32_COMPENSATION) && !MS5611_CONFIG_KERNEL_INT32
+#error "MS5611_USE_INT32_COMPENSATION needs MS5611_CONFIG_KERNEL_INT32"
+#endif
+
+// --- Column Kernel (MS5611_Compensate_Batch) ---
+#ifndef MS5611_CONFIG_KERNEL_BATCH
+#define MS5611_CONFIG_KERNEL_BATCH    MS5611_CONFIG_DEFAULT
+#endif
+
+#endif /* _MS5611CONFIG_H_ */
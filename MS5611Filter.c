@@ -0,0 +1,123 @@
+/* ============================================================================================
+ * MS5611Filter.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#include <MS5611Filter.h>
+
+#if MS5611_CONFIG_FILTER
+
+#if (MS5611_GLITCH_WINDOW < 3) || (MS5611_GLITCH_WINDOW > 9) || ((MS5611_GLITCH_WINDOW & 1) == 0)
+#error "MS5611_GLITCH_WINDOW must be odd and between 3 and 9"
+#endif
+
+/**
+ * @brief  Returns the median of n words, sorting the buffer in place
+ * @param  buffer Pointer to words to sort
+ * @param  n Number of words (odd)
+ * @retval uint32_t Median value
+ */
+static uint32_t MS5611_Median(uint32_t *buffer, uint8_t n){
+	uint8_t i, j;
+
+	for (i = 1; i < n; i++) {
+		uint32_t key = buffer[i];
+		for (j = i; j > 0 && buffer[j - 1] > key; j--)
+			buffer[j] = buffer[j - 1];
+		buffer[j] = key;
+	}
+
+	return buffer[n >> 1];
+}
+
+/**
+ * @brief  Resets a glitch filter
+ * @param  filter Pointer to MS5611_Glitch_Filter_TypeDef structure
+ * @param  min_threshold Deviation from the median that is never flagged, in ADC counts
+ * @param  policy Outlier replacement policy
+ * @retval None
+ */
+void MS5611_Glitch_Filter_Init(MS5611_Glitch_Filter_TypeDef *filter, uint32_t min_threshold, MS5611GlitchPolicyTypeDef policy){
+	uint8_t i;
+
+	for (i = 0; i < MS5611_GLITCH_WINDOW; i++)
+		filter->history[i] = 0;
+
+	filter->last_good = 0;
+	filter->min_threshold = min_threshold;
+	filter->index = 0;
+	filter->count = 0;
+	filter->policy = policy;
+}
+
+/**
+ * @brief  Runs one raw D1 or D2 word through the Hampel rejection stage
+ * @note   Rail words (0, 0xFFFFFF) never enter the window. Other words always do,
+ *         so a genuine step is followed after (W+1)/2 samples.
+ * @param  filter Pointer to MS5611_Glitch_Filter_TypeDef structure
+ * @param  raw_data Pointer to raw ADC word, replaced in place when rejected
+ * @retval uint8_t MS5611_QUALITY_* flags for this sample
+ */
+uint8_t MS5611_Glitch_Filter_Apply(MS5611_Glitch_Filter_TypeDef *filter, uint32_t *raw_data){
+	uint32_t window[MS5611_GLITCH_WINDOW];
+	uint32_t median;
+	uint32_t mad;
+	uint32_t threshold;
+	uint32_t deviation;
+	uint32_t sample = *raw_data;
+	uint8_t i;
+
+	if (sample == 0 || sample >= MS5611_ADC_MAX) {
+		if (filter->count == 0)
+			return MS5611_QUALITY_RAIL;
+
+		*raw_data = filter->last_good;
+		return MS5611_QUALITY_RAIL | MS5611_QUALITY_REPLACED;
+	}
+
+	filter->history[filter->index] = sample;
+	filter->index = (uint8_t) ((filter->index + 1U) % MS5611_GLITCH_WINDOW);
+
+	if (filter->count < MS5611_GLITCH_WINDOW) {
+		filter->count++;
+		filter->last_good = sample;
+		return MS5611_QUALITY_WARMUP;
+	}
+
+	for (i = 0; i < MS5611_GLITCH_WINDOW; i++)
+		window[i] = filter->history[i];
+	median = MS5611_Median(window, MS5611_GLITCH_WINDOW);
+
+	for (i = 0; i < MS5611_GLITCH_WINDOW; i++)
+		window[i] = (window[i] > median) ? window[i] - median : median - window[i];
+	mad = MS5611_Median(window, MS5611_GLITCH_WINDOW);
+
+	threshold = (mad * MS5611_GLITCH_K_Q4) >> 4;
+	if (threshold < filter->min_threshold)
+		threshold = filter->min_threshold;
+
+	deviation = (sample > median) ? sample - median : median - sample;
+	if (deviation <= threshold) {
+		filter->last_good = sample;
+		return MS5611_QUALITY_OK;
+	}
+
+	*raw_data = (filter->policy == MS5611_GLITCH_MEDIAN) ? median : filter->last_good;
+	return MS5611_QUALITY_OUTLIER | MS5611_QUALITY_REPLACED;
+}
+
+#endif /* MS5611_CONFIG_FILTER */
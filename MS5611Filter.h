@@ -0,0 +1,91 @@
+/* ============================================================================================
+ * MS5611Filter.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611FILTER_H_
+#define _MS5611FILTER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "MS5611Config.h"
+
+// --- Glitch Filter Configuration ---
+#ifndef MS5611_GLITCH_WINDOW
+#define MS5611_GLITCH_WINDOW          5     /**< Hampel window length, odd, 3..9 */
+#endif
+
+#ifndef MS5611_GLITCH_K_Q4
+#define MS5611_GLITCH_K_Q4            71    /**< Hampel k * 1.4826 in Q4 (k = 3) */
+#endif
+
+#define MS5611_ADC_MAX                0xFFFFFF  /**< Full-scale 24-bit ADC word */
+
+// --- Sample Quality Flags ---
+#define MS5611_QUALITY_OK             0x00  /**< Sample accepted unchanged */
+#define MS5611_QUALITY_RAIL           0x01  /**< ADC word was 0 or 0xFFFFFF */
+#define MS5611_QUALITY_OUTLIER        0x02  /**< Sample exceeded the Hampel threshold */
+#define MS5611_QUALITY_REPLACED       0x04  /**< Output value was substituted */
+#define MS5611_QUALITY_WARMUP         0x08  /**< Window not yet full, sample not verified */
+
+// --- Outlier Replacement Policy ---
+typedef enum MS5611GlitchPolicy{
+  MS5611_GLITCH_HOLD,     /**< Replace outliers with the last accepted value */
+  MS5611_GLITCH_MEDIAN    /**< Replace outliers with the window median */
+}MS5611GlitchPolicyTypeDef;
+
+// --- Glitch Filter State (one per ADC channel) ---
+typedef struct {
+  uint32_t history[MS5611_GLITCH_WINDOW];  /**< Last raw words, rail values excluded */
+  uint32_t last_good;                      /**< Last accepted output */
+  uint32_t min_threshold;                  /**< Deviation always accepted, in ADC counts */
+  uint8_t index;                           /**< Next write position in history */
+  uint8_t count;                           /**< Valid entries in history */
+  MS5611GlitchPolicyTypeDef policy;        /**< Outlier replacement policy */
+} MS5611_Glitch_Filter_TypeDef;
+
+// --- Function Prototypes ---
+#if MS5611_CONFIG_FILTER
+
+/**
+ * @brief  Resets a glitch filter
+ * @param  filter Pointer to filter state
+ * @param  min_threshold Deviation from the median, in ADC counts, that is never flagged
+ * @param  policy Outlier replacement policy
+ */
+void MS5611_Glitch_Filter_Init(MS5611_Glitch_Filter_TypeDef *filter, uint32_t min_threshold, MS5611GlitchPolicyTypeDef policy);
+
+/**
+ * @brief  Runs one raw D1 or D2 word through the Hampel rejection stage
+ * @note   Worst case is two insertion sorts of MS5611_GLITCH_WINDOW words,
+ *         i.e. W*(W-1) compare/move steps (20 for W = 5), independent of data;
+ *         about 0.1 us per call on an x86 host (tools/ms5611_filter_check), target cycles not measured
+ * @param  filter Pointer to filter state
+ * @param  raw_data Pointer to raw ADC word, replaced in place when rejected
+ * @retval uint8_t MS5611_QUALITY_* flags for this sample
+ */
+uint8_t MS5611_Glitch_Filter_Apply(MS5611_Glitch_Filter_TypeDef *filter, uint32_t *raw_data);
+#endif /* MS5611_CONFIG_FILTER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611FILTER_H_ */
@@ -0,0 +1,264 @@
+/* ============================================================================================
+ * MS5611Fusion.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Redundant barometer fusion. Every sensor is extrapolated to the timestamp of the newest
+ * sample, sensors further than the gate from the median are excluded, and the rest are
+ * blended with inverse-variance weights. Each sensor's variance is tracked online from
+ * its residual against the fused output, so a noisy sensor loses weight and a failed one
+ * is gated out until it agrees with the group again. Two sensors have no majority: when
+ * they disagree, the previous fused output decides, or both are blended when it cannot.
+ */
+
+#include <MS5611Fusion.h>
+
+#define MS5611_FUSION_VARIANCE_INIT   400U    /**< Initial variance, 25 Pa^2 in Q4 */
+
+/**
+ * @brief  Returns the k-th smallest value, reordering the buffer
+ * @param  values Buffer of n values
+ * @param  n Number of values
+ * @param  k Rank, 0-based
+ * @retval int32_t Selected value
+ */
+static int32_t MS5611_Fusion_Select(int32_t *values, uint8_t n, uint8_t k){
+	uint8_t left = 0;
+	uint8_t right = n - 1;
+
+	while (left < right) {
+		int32_t pivot = values[(left + right) >> 1];
+		uint8_t i = left;
+		uint8_t j = right;
+
+		while (i <= j) {
+			while (values[i] < pivot)
+				i++;
+			while (values[j] > pivot)
+				j--;
+			if (i <= j) {
+				int32_t t = values[i];
+				values[i] = values[j];
+				values[j] = t;
+				i++;
+				if (j == 0)
+					break;
+				j--;
+			}
+		}
+
+		if (k <= j)
+			right = j;
+		else if (k >= i)
+			left = i;
+		else
+			break;
+	}
+
+	return values[k];
+}
+
+/**
+ * @brief  Integer square root
+ * @param  x Input
+ * @retval uint32_t floor(sqrt(x))
+ */
+static uint32_t MS5611_Fusion_Sqrt(uint32_t x){
+	uint32_t result = 0;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > x)
+		bit >>= 2;
+
+	while (bit != 0) {
+		if (x >= result + bit) {
+			x -= result + bit;
+			result = (result >> 1) + bit;
+		} else {
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return result;
+}
+
+/**
+ * @brief  Initializes the fusion state
+ * @param  fusion Pointer to MS5611_Fusion_TypeDef structure
+ * @param  sensors Number of sensors, 1..MS5611_FUSION_MAX_SENSORS
+ * @param  max_age Samples older than this (ticks) are excluded as stale
+ * @param  gate_pa Deviation from the median always tolerated, Pa
+ * @retval None
+ */
+void MS5611_Fusion_Init(MS5611_Fusion_TypeDef *fusion, uint8_t sensors, uint32_t max_age, uint32_t gate_pa){
+	uint8_t i;
+
+	if (sensors > MS5611_FUSION_MAX_SENSORS)
+		sensors = MS5611_FUSION_MAX_SENSORS;
+
+	fusion->sensors = sensors;
+	fusion->max_age = max_age;
+	fusion->gate_pa = gate_pa;
+	fusion->gate_sigma = 4;
+	fusion->fused = 0;
+	fusion->fused_stamp = 0;
+	fusion->active = 0;
+
+	for (i = 0; i < MS5611_FUSION_MAX_SENSORS; i++) {
+		fusion->channel[i].pressure[0] = 0;
+		fusion->channel[i].pressure[1] = 0;
+		fusion->channel[i].stamp[0] = 0;
+		fusion->channel[i].stamp[1] = 0;
+		fusion->channel[i].count = 0;
+		fusion->channel[i].excluded = 1;
+		fusion->channel[i].variance = MS5611_FUSION_VARIANCE_INIT;
+		fusion->channel[i].exclusions = 0;
+	}
+}
+
+/**
+ * @brief  Adds one sample of one sensor and computes a fused output at its timestamp
+ * @param  fusion Pointer to MS5611_Fusion_TypeDef structure
+ * @param  sensor Sensor index
+ * @param  pressure Compensated pressure, Pa
+ * @param  stamp Sample timestamp, ticks of a clock shared by all sensors
+ * @param  fused Pointer to store the fused pressure
+ * @retval uint8_t Number of sensors that contributed, 0 when no output was produced
+ */
+uint8_t MS5611_Fusion_Update(MS5611_Fusion_TypeDef *fusion, uint8_t sensor, int32_t pressure, uint32_t stamp, int32_t *fused){
+	MS5611_Fusion_Channel_TypeDef *ch;
+	int32_t aligned[MS5611_FUSION_MAX_SENSORS];
+	int32_t scratch[MS5611_FUSION_MAX_SENSORS];
+	int32_t variances[MS5611_FUSION_MAX_SENSORS];
+	uint8_t member[MS5611_FUSION_MAX_SENSORS];
+	uint8_t candidates = 0;
+	int64_t weightedSum = 0;
+	int64_t weightSum = 0;
+	int32_t median;
+	int32_t reference;
+	uint32_t gate;
+	uint8_t vote = 1;
+	uint8_t active = 0;
+	uint8_t i;
+
+	if (sensor >= fusion->sensors)
+		return 0;
+
+	ch = &fusion->channel[sensor];
+	ch->pressure[0] = ch->pressure[1];
+	ch->stamp[0] = ch->stamp[1];
+	ch->pressure[1] = pressure;
+	ch->stamp[1] = stamp;
+	if (ch->count < 2)
+		ch->count++;
+
+	/* Align every fresh sensor to the new timestamp */
+	for (i = 0; i < fusion->sensors; i++) {
+		int32_t age;
+
+		ch = &fusion->channel[i];
+		ch->excluded = 1;
+		if (ch->count == 0)
+			continue;
+
+		age = (int32_t) (stamp - ch->stamp[1]);
+		if (age < 0)
+			age = 0;
+		if ((uint32_t) age > fusion->max_age)
+			continue;
+
+		aligned[candidates] = ch->pressure[1];
+		if (ch->count == 2 && age > 0 && ch->stamp[1] != ch->stamp[0])
+			aligned[candidates] += (int32_t) (((int64_t) (ch->pressure[1] - ch->pressure[0]) * age) /
+			                                  (int32_t) (ch->stamp[1] - ch->stamp[0]));
+
+		scratch[candidates] = aligned[candidates];
+		member[candidates] = i;
+		variances[candidates] = (int32_t) ch->variance;
+		candidates++;
+	}
+
+	if (candidates == 0)
+		return 0;
+
+	median = MS5611_Fusion_Select(scratch, candidates, (uint8_t) ((candidates - 1) >> 1));
+	/* Group sigma from the median variance, so a failing sensor cannot widen the gate */
+	gate = (uint32_t) MS5611_Fusion_Select(variances, candidates, (uint8_t) ((candidates - 1) >> 1));
+	gate = fusion->gate_pa + fusion->gate_sigma * MS5611_Fusion_Sqrt(gate >> 4);
+	reference = median;
+
+	/* Two disagreeing sensors cannot outvote each other: the lower median would pick
+	 * whichever reads low. Judge them against the previous output instead, or, without
+	 * a fresh one, decline to vote and blend both by their variance history. */
+	if (candidates == 2 && (uint32_t) (aligned[0] > aligned[1] ? aligned[0] - aligned[1] : aligned[1] - aligned[0]) > gate) {
+		if (fusion->active != 0 && stamp - fusion->fused_stamp <= fusion->max_age)
+			reference = fusion->fused;
+		else
+			vote = 0;
+	}
+
+	/* Inverse-variance blend of the sensors inside the gate, relative to the reference */
+	for (;;) {
+		for (i = 0; i < candidates; i++) {
+			int32_t deviation = aligned[i] - reference;
+			uint32_t variance;
+			int64_t weight;
+
+			ch = &fusion->channel[member[i]];
+			if (vote && (uint32_t) (deviation < 0 ? -deviation : deviation) > gate)
+				continue;
+
+			variance = (ch->variance < MS5611_FUSION_VARIANCE_MIN) ? MS5611_FUSION_VARIANCE_MIN : ch->variance;
+			weight = (int64_t) ((1UL << 30) / variance);
+			weightedSum += weight * deviation;
+			weightSum += weight;
+			ch->excluded = 0;
+			active++;
+		}
+
+		/* Neither agrees with the previous output: no basis to drop one, blend both */
+		if (active != 0 || !vote)
+			break;
+		vote = 0;
+	}
+
+	for (i = 0; i < candidates; i++)
+		if (fusion->channel[member[i]].excluded)
+			fusion->channel[member[i]].exclusions++;
+
+	fusion->fused = reference + (int32_t) (weightedSum / weightSum);
+	fusion->fused_stamp = stamp;
+	fusion->active = active;
+
+	/* Residual variance update, including excluded sensors so they can rejoin */
+	for (i = 0; i < candidates; i++) {
+		int32_t residual = aligned[i] - fusion->fused;
+		int64_t target;
+
+		if (residual > MS5611_FUSION_RESIDUAL_CLAMP)
+			residual = MS5611_FUSION_RESIDUAL_CLAMP;
+		else if (residual < -MS5611_FUSION_RESIDUAL_CLAMP)
+			residual = -MS5611_FUSION_RESIDUAL_CLAMP;
+
+		ch = &fusion->channel[member[i]];
+		target = (int64_t) residual * residual * 16;
+		ch->variance = (uint32_t) ((int64_t) ch->variance + ((target - (int64_t) ch->variance) >> MS5611_FUSION_VARIANCE_SHIFT));
+	}
+
+	*fused = fusion->fused;
+	return active;
+}
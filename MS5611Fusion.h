@@ -0,0 +1,88 @@
+/* ============================================================================================
+ * MS5611Fusion.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611FUSION_H_
+#define _MS5611FUSION_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// --- Fusion Configuration ---
+#ifndef MS5611_FUSION_MAX_SENSORS
+#define MS5611_FUSION_MAX_SENSORS     8
+#endif
+
+#define MS5611_FUSION_VARIANCE_SHIFT  5       /**< Residual variance EWMA, alpha = 1/32 */
+#define MS5611_FUSION_VARIANCE_MIN    16U     /**< Variance floor, 1 Pa^2 in Q4 */
+#define MS5611_FUSION_RESIDUAL_CLAMP  10000   /**< Residual clamp for the variance update, Pa */
+
+// --- Per-Sensor Channel State ---
+typedef struct {
+  int32_t pressure[2];      /**< Last two samples, [1] newest, Pa */
+  uint32_t stamp[2];        /**< Their timestamps, ticks */
+  uint8_t count;            /**< Valid samples, 0..2 */
+  uint8_t excluded;         /**< Non-zero when left out of the last fusion step */
+  uint32_t variance;        /**< Residual variance against the fused output, Pa^2 Q4 */
+  uint32_t exclusions;      /**< Fusion steps this sensor was excluded from */
+} MS5611_Fusion_Channel_TypeDef;
+
+// --- Fusion State ---
+typedef struct {
+  uint8_t sensors;                                           /**< Number of sensors in use */
+  uint32_t max_age;                                          /**< Samples older than this are stale, ticks */
+  uint32_t gate_pa;                                          /**< Deviation from the median always tolerated, Pa */
+  uint8_t gate_sigma;                                        /**< Extra tolerance in units of the group sigma */
+  int32_t fused;                                             /**< Last fused pressure, Pa */
+  uint32_t fused_stamp;                                      /**< Time of the last fused pressure */
+  uint8_t active;                                            /**< Sensors used in the last step */
+  MS5611_Fusion_Channel_TypeDef channel[MS5611_FUSION_MAX_SENSORS];
+} MS5611_Fusion_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Initializes the fusion state
+ * @param  fusion Pointer to fusion state
+ * @param  sensors Number of sensors, 1..MS5611_FUSION_MAX_SENSORS
+ * @param  max_age Samples older than this (ticks) are excluded as stale
+ * @param  gate_pa Deviation from the median always tolerated, Pa
+ */
+void MS5611_Fusion_Init(MS5611_Fusion_TypeDef *fusion, uint8_t sensors, uint32_t max_age, uint32_t gate_pa);
+
+/**
+ * @brief  Adds one sample of one sensor and computes a fused output at its timestamp
+ * @note   O(N) per call: extrapolation, median selection and blend are single passes
+ *         (median by quickselect, expected linear) over N <= MS5611_FUSION_MAX_SENSORS
+ * @param  fusion Pointer to fusion state
+ * @param  sensor Sensor index
+ * @param  pressure Compensated pressure, Pa
+ * @param  stamp Sample timestamp, ticks of a clock shared by all sensors
+ * @param  fused Pointer to store the fused pressure
+ * @retval uint8_t Number of sensors that contributed, 0 when no output was produced
+ */
+uint8_t MS5611_Fusion_Update(MS5611_Fusion_TypeDef *fusion, uint8_t sensor, int32_t pressure, uint32_t stamp, int32_t *fused);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611FUSION_H_ */
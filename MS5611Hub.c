@@ -0,0 +1,207 @@
+/* ============================================================================================
+ * MS5611Hub.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Single-producer sample hub. The producer writes each sample into the ring once and then
+ * advances head with a release store; it never waits for consumers. Every subscriber keeps
+ * its own cursor. A consumer reads an entry in place and afterwards checks head again: if
+ * the producer has come within one ring length of the entry's sequence, the entry may have
+ * been overwritten during the read and it is dropped, seqlock style. Falling more than a
+ * ring behind skips forward and is counted as an overflow.
+ */
+
+#include <MS5611Hub.h>
+
+#if MS5611_CONFIG_HUB
+
+#if (MS5611_HUB_DEPTH < 2) || ((MS5611_HUB_DEPTH & (MS5611_HUB_DEPTH - 1)) != 0)
+#error "MS5611_HUB_DEPTH must be a power of two"
+#endif
+
+#define MS5611_HUB_MASK               (MS5611_HUB_DEPTH - 1U)
+
+/**
+ * @brief  Loads head with acquire ordering, so ring contents written before it are visible
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @retval uint32_t Samples published
+ */
+static uint32_t MS5611_Hub_Head(MS5611_Hub_TypeDef *hub){
+	return __atomic_load_n(&hub->head, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief  Checks whether the entry at a sequence could have been overwritten
+ * @note   The acquire fence orders the preceding entry reads before the head reload
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @param  sequence Sequence of the entry that was read
+ * @retval uint8_t 1 if the entry is still intact
+ */
+static uint8_t MS5611_Hub_Intact(MS5611_Hub_TypeDef *hub, uint32_t sequence){
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return (uint32_t) (__atomic_load_n(&hub->head, __ATOMIC_RELAXED) - sequence) < MS5611_HUB_DEPTH;
+}
+
+/**
+ * @brief  Moves a lagging cursor to the oldest entry that cannot be in the middle of a write
+ * @param  sub Pointer to MS5611_Hub_Subscriber_TypeDef structure
+ * @param  head Current head
+ * @retval None
+ */
+static void MS5611_Hub_Catch_Up(MS5611_Hub_Subscriber_TypeDef *sub, uint32_t head){
+	uint32_t oldest = head - (MS5611_HUB_DEPTH - 1U);
+
+	if ((uint32_t) (head - sub->cursor) >= MS5611_HUB_DEPTH) {
+		sub->lost += oldest - sub->cursor;
+		sub->overflows++;
+		sub->cursor = oldest;
+	}
+}
+
+/**
+ * @brief  Initializes an empty hub
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @retval None
+ */
+void MS5611_Hub_Init(MS5611_Hub_TypeDef *hub){
+	hub->head = 0;
+}
+
+/**
+ * @brief  Publishes one sample, never blocks
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @param  raw Raw ADC pair
+ * @param  sample Sample record
+ * @retval None
+ */
+void MS5611_Hub_Publish(MS5611_Hub_TypeDef *hub, const MS5611_Raw_Data_TypeDef *raw, const MS5611_Sample_TypeDef *sample){
+	uint32_t head = hub->head;
+	MS5611_Hub_Entry_TypeDef *entry = &hub->ring[head & MS5611_HUB_MASK];
+
+	entry->raw = *raw;
+	entry->sample = *sample;
+
+	__atomic_store_n(&hub->head, head + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief  Attaches a subscriber, starting at the next published sample
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @param  sub Pointer to MS5611_Hub_Subscriber_TypeDef structure
+ * @param  policy Delivery policy
+ * @param  factor Decimation or averaging factor, ignored for MS5611_HUB_ALL
+ * @retval None
+ */
+void MS5611_Hub_Subscribe(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub, MS5611HubPolicyTypeDef policy, uint16_t factor){
+	sub->policy = policy;
+	sub->factor = (policy == MS5611_HUB_ALL || factor == 0) ? 1 : factor;
+	sub->pending = 0;
+	sub->cursor = MS5611_Hub_Head(hub);
+	sub->pressure_sum = 0;
+	sub->temperature_sum = 0;
+	sub->flags = 0;
+	sub->delivered = 0;
+	sub->overflows = 0;
+	sub->lost = 0;
+}
+
+/**
+ * @brief  Returns the next unread entry in place, without copying
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @param  sub Pointer to MS5611_Hub_Subscriber_TypeDef structure
+ * @retval const MS5611_Hub_Entry_TypeDef* Entry, or NULL when caught up
+ */
+const MS5611_Hub_Entry_TypeDef *MS5611_Hub_Peek(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub){
+	uint32_t head = MS5611_Hub_Head(hub);
+
+	if (head == sub->cursor)
+		return NULL;
+
+	MS5611_Hub_Catch_Up(sub, head);
+
+	return &hub->ring[sub->cursor & MS5611_HUB_MASK];
+}
+
+/**
+ * @brief  Consumes the entry returned by MS5611_Hub_Peek
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @param  sub Pointer to MS5611_Hub_Subscriber_TypeDef structure
+ * @retval uint8_t 1 if the entry was intact while used, 0 if the producer overwrote it
+ */
+uint8_t MS5611_Hub_Release(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub){
+	uint8_t intact = MS5611_Hub_Intact(hub, sub->cursor);
+
+	if (!intact)
+		sub->lost++;
+	else
+		sub->delivered++;
+
+	sub->cursor++;
+	return intact;
+}
+
+/**
+ * @brief  Reads the next output according to the subscriber policy
+ * @note   Averages are taken over the valid samples received; lost samples and samples
+ *         flagged MS5611_SAMPLE_INVALID are left out, lost ones are counted in sub->lost
+ * @param  hub Pointer to MS5611_Hub_TypeDef structure
+ * @param  sub Pointer to MS5611_Hub_Subscriber_TypeDef structure
+ * @param  out Pointer to store the output
+ * @retval uint8_t 1 when an output was stored, 0 when more samples are needed
+ */
+uint8_t MS5611_Hub_Read(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub, MS5611_Hub_Entry_TypeDef *out){
+	const MS5611_Hub_Entry_TypeDef *entry;
+	MS5611_Hub_Entry_TypeDef copy;
+
+	while ((entry = MS5611_Hub_Peek(hub, sub)) != NULL) {
+		copy = *entry;
+		if (!MS5611_Hub_Intact(hub, sub->cursor)) {
+			sub->lost++;
+			sub->cursor++;
+			continue;
+		}
+		sub->cursor++;
+
+		if (sub->policy == MS5611_HUB_AVERAGE) {
+			if (copy.sample.flags & MS5611_SAMPLE_INVALID)
+				continue;
+			sub->pressure_sum += copy.sample.value.pressure;
+			sub->temperature_sum += copy.sample.value.temperature;
+			sub->flags |= copy.sample.flags;
+		}
+
+		if (++sub->pending < sub->factor)
+			continue;
+
+		if (sub->policy == MS5611_HUB_AVERAGE) {
+			copy.sample.value.pressure = (int32_t) (sub->pressure_sum / sub->factor);
+			copy.sample.value.temperature = (int32_t) (sub->temperature_sum / sub->factor);
+			copy.sample.flags = sub->flags;
+			sub->pressure_sum = 0;
+			sub->temperature_sum = 0;
+			sub->flags = 0;
+		}
+
+		sub->pending = 0;
+		sub->delivered++;
+		*out = copy;
+		return 1;
+	}
+
+	return 0;
+}
+
+#endif /* MS5611_CONFIG_HUB */
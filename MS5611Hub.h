@@ -0,0 +1,129 @@
+/* ============================================================================================
+ * MS5611Hub.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611HUB_H_
+#define _MS5611HUB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MS5611Config.h"
+#include "MS5611Compensate.h"
+
+// --- Hub Configuration ---
+#ifndef MS5611_HUB_DEPTH
+#define MS5611_HUB_DEPTH              32    /**< Ring entries, power of two */
+#endif
+
+// --- Subscriber Policies ---
+typedef enum MS5611HubPolicy{
+  MS5611_HUB_ALL,         /**< Every sample */
+  MS5611_HUB_DECIMATE,    /**< Every factor-th sample */
+  MS5611_HUB_AVERAGE      /**< Mean of every factor samples */
+}MS5611HubPolicyTypeDef;
+
+// --- Ring Entry, written once by the producer, 32 bytes ---
+typedef struct {
+  MS5611_Raw_Data_TypeDef raw;           /**< Raw D1/D2 pair */
+  MS5611_Sample_TypeDef sample;          /**< Compensated sample with its metadata */
+} MS5611_Hub_Entry_TypeDef;
+
+// --- Hub ---
+typedef struct {
+  MS5611_Hub_Entry_TypeDef ring[MS5611_HUB_DEPTH];  /**< Shared sample ring */
+  volatile uint32_t head;                           /**< Samples published, written by the producer only */
+} MS5611_Hub_TypeDef;
+
+// --- Subscriber Cursor, owned by one consumer ---
+typedef struct {
+  MS5611HubPolicyTypeDef policy;   /**< Delivery policy */
+  uint16_t factor;                 /**< Decimation or averaging factor */
+  uint16_t pending;                /**< Samples taken into the current output */
+  uint32_t cursor;                 /**< Sequence of the next sample to read */
+  int64_t pressure_sum;            /**< Averaging accumulators */
+  int64_t temperature_sum;
+  uint8_t flags;                   /**< Flags accumulated over the current average */
+  uint32_t delivered;              /**< Outputs delivered */
+  uint32_t overflows;              /**< Overflow events (consumer fell a full ring behind) */
+  uint32_t lost;                   /**< Samples overwritten before this consumer read them */
+} MS5611_Hub_Subscriber_TypeDef;
+
+// --- Function Prototypes ---
+#if MS5611_CONFIG_HUB
+
+/**
+ * @brief  Initializes an empty hub
+ * @param  hub Pointer to hub
+ */
+void MS5611_Hub_Init(MS5611_Hub_TypeDef *hub);
+
+/**
+ * @brief  Publishes one sample, never blocks
+ * @note   Single producer. Safe from an interrupt; the oldest entry is overwritten when full.
+ * @param  hub Pointer to hub
+ * @param  raw Raw ADC pair
+ * @param  sample Sample record
+ */
+void MS5611_Hub_Publish(MS5611_Hub_TypeDef *hub, const MS5611_Raw_Data_TypeDef *raw, const MS5611_Sample_TypeDef *sample);
+
+/**
+ * @brief  Attaches a subscriber, starting at the next published sample
+ * @param  hub Pointer to hub
+ * @param  sub Pointer to subscriber cursor
+ * @param  policy Delivery policy
+ * @param  factor Decimation or averaging factor, ignored for MS5611_HUB_ALL
+ */
+void MS5611_Hub_Subscribe(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub, MS5611HubPolicyTypeDef policy, uint16_t factor);
+
+/**
+ * @brief  Returns the next unread entry in place, without copying
+ * @note   Valid until the producer wraps around; confirm with MS5611_Hub_Release
+ * @param  hub Pointer to hub
+ * @param  sub Pointer to subscriber cursor
+ * @retval const MS5611_Hub_Entry_TypeDef* Entry, or NULL when caught up
+ */
+const MS5611_Hub_Entry_TypeDef *MS5611_Hub_Peek(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub);
+
+/**
+ * @brief  Consumes the entry returned by MS5611_Hub_Peek
+ * @param  hub Pointer to hub
+ * @param  sub Pointer to subscriber cursor
+ * @retval uint8_t 1 if the entry was intact while used, 0 if the producer overwrote it
+ */
+uint8_t MS5611_Hub_Release(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub);
+
+/**
+ * @brief  Reads the next output according to the subscriber policy
+ * @param  hub Pointer to hub
+ * @param  sub Pointer to subscriber cursor
+ * @param  out Pointer to store the output; for MS5611_HUB_AVERAGE only sample.value is
+ *         averaged, the other fields are those of the last sample and flags are OR-ed
+ * @retval uint8_t 1 when an output was stored, 0 when more samples are needed
+ */
+uint8_t MS5611_Hub_Read(MS5611_Hub_TypeDef *hub, MS5611_Hub_Subscriber_TypeDef *sub, MS5611_Hub_Entry_TypeDef *out);
+#endif /* MS5611_CONFIG_HUB */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611HUB_H_ */
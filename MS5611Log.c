@@ -0,0 +1,429 @@
+/* ============================================================================================
+ * MS5611Log.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#include <MS5611Log.h>
+
+#if (MS5611_LOG_BLOCK_SIZE < 64) || (MS5611_LOG_BLOCK_SIZE > 65535)
+#error "MS5611_LOG_BLOCK_SIZE must be between 64 and 65535 bytes"
+#endif
+
+/** Largest encoding of one sample: two escaped 25-bit zigzag values */
+#define MS5611_LOG_MAX_SAMPLE_BITS    (2 * (MS5611_LOG_RICE_ESCAPE + 25))
+
+/** Rice parameters of the first block, before any deltas were seen */
+#define MS5611_LOG_RICE_K1_DEFAULT    8
+#define MS5611_LOG_RICE_K2_DEFAULT    2
+#define MS5611_LOG_RICE_K_MAX         24
+
+static const uint8_t logMagic[4] = {'M', 'S', '5', 'L'};
+
+/* Little-endian field helpers */
+static void MS5611_Log_Put16(uint8_t *p, uint16_t v){
+	p[0] = (uint8_t) v;
+	p[1] = (uint8_t) (v >> 8);
+}
+
+static void MS5611_Log_Put24(uint8_t *p, uint32_t v){
+	p[0] = (uint8_t) v;
+	p[1] = (uint8_t) (v >> 8);
+	p[2] = (uint8_t) (v >> 16);
+}
+
+static void MS5611_Log_Put32(uint8_t *p, uint32_t v){
+	MS5611_Log_Put16(p, (uint16_t) v);
+	MS5611_Log_Put16(p + 2, (uint16_t) (v >> 16));
+}
+
+static uint16_t MS5611_Log_Get16(const uint8_t *p){
+	return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static uint32_t MS5611_Log_Get24(const uint8_t *p){
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16);
+}
+
+static uint32_t MS5611_Log_Get32(const uint8_t *p){
+	return (uint32_t) MS5611_Log_Get16(p) | ((uint32_t) MS5611_Log_Get16(p + 2) << 16);
+}
+
+/**
+ * @brief  Appends up to 25 bits to the open block, least significant bit first
+ * @param  encoder Pointer to MS5611_Log_Encoder_TypeDef structure
+ * @param  value Bits to write, nothing above bit n - 1 set
+ * @param  n Number of bits (0..25)
+ * @retval None
+ */
+static void MS5611_Log_Put_Bits(MS5611_Log_Encoder_TypeDef *encoder, uint32_t value, uint8_t n){
+	encoder->bits |= value << encoder->bit_count;
+	encoder->bit_count = (uint8_t) (encoder->bit_count + n);
+
+	while (encoder->bit_count >= 8) {
+		encoder->block[encoder->used++] = (uint8_t) encoder->bits;
+		encoder->bits >>= 8;
+		encoder->bit_count = (uint8_t) (encoder->bit_count - 8);
+	}
+}
+
+/**
+ * @brief  Writes the Rice code of the zigzag difference of two 24-bit words
+ * @param  encoder Pointer to MS5611_Log_Encoder_TypeDef structure
+ * @param  current New value
+ * @param  previous Previous value
+ * @param  k Rice parameter
+ * @retval uint32_t Zigzag value written, for the parameter of the next block
+ */
+static uint32_t MS5611_Log_Put_Delta(MS5611_Log_Encoder_TypeDef *encoder, uint32_t current, uint32_t previous, uint8_t k){
+	int32_t delta = (int32_t) current - (int32_t) previous;
+	uint32_t zigzag = ((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31);
+	uint32_t q = zigzag >> k;
+
+	if (q < MS5611_LOG_RICE_ESCAPE) {
+		MS5611_Log_Put_Bits(encoder, (1U << q) - 1U, (uint8_t) (q + 1));
+		MS5611_Log_Put_Bits(encoder, zigzag & ((1U << k) - 1U), k);
+	} else {
+		MS5611_Log_Put_Bits(encoder, (1U << MS5611_LOG_RICE_ESCAPE) - 1U, MS5611_LOG_RICE_ESCAPE);
+		MS5611_Log_Put_Bits(encoder, zigzag, 25);
+	}
+
+	return zigzag;
+}
+
+/**
+ * @brief  Picks the Rice parameter for a mean zigzag value, floor(log2(mean))
+ * @param  sum Sum of the zigzag values of the previous block
+ * @param  deltas Number of values in the sum
+ * @param  k Parameter to keep when there were none
+ * @retval uint8_t Rice parameter
+ */
+static uint8_t MS5611_Log_Rice_Parameter(uint64_t sum, uint16_t deltas, uint8_t k){
+	uint32_t mean;
+
+	if (deltas == 0)
+		return k;
+
+	mean = (uint32_t) (sum / deltas);
+	for (k = 0; k < MS5611_LOG_RICE_K_MAX && (mean >> (k + 1)) != 0; k++)
+		;
+
+	return k;
+}
+
+/**
+ * @brief  Reads up to 25 bits of a payload, least significant bit first
+ * @param  payload Pointer to the payload
+ * @param  position Bit offset
+ * @param  n Number of bits (0..25)
+ * @retval uint32_t Bits read
+ */
+static uint32_t MS5611_Log_Get_Bits(const uint8_t *payload, uint32_t position, uint8_t n){
+	const uint8_t *p = &payload[position >> 3];
+	uint8_t offset = (uint8_t) (position & 7);
+	uint32_t value = 0;
+	uint8_t shift;
+
+	if (n == 0)
+		return 0;
+
+	for (shift = 0; shift < n + offset; shift = (uint8_t) (shift + 8))
+		value |= (uint32_t) *p++ << shift;
+
+	return (value >> offset) & ((1U << n) - 1U);
+}
+
+/**
+ * @brief  Reads a Rice-coded zigzag delta
+ * @param  payload Pointer to the payload
+ * @param  position Pointer to the bit offset, advanced past the code
+ * @param  end Payload length in bits
+ * @param  k Rice parameter
+ * @param  delta Pointer to store the decoded difference
+ * @retval uint8_t 1 on success, 0 when the code runs past the payload
+ */
+static uint8_t MS5611_Log_Get_Delta(const uint8_t *payload, uint32_t *position, uint32_t end, uint8_t k, int32_t *delta){
+	uint32_t q = 0;
+	uint32_t zigzag;
+	uint8_t n;
+
+	for (;;) {
+		if (*position >= end)
+			return 0;
+		if (((payload[*position >> 3] >> (*position & 7)) & 1) == 0) {
+			(*position)++;
+			break;
+		}
+		(*position)++;
+		if (++q == MS5611_LOG_RICE_ESCAPE)
+			break;
+	}
+
+	n = (q == MS5611_LOG_RICE_ESCAPE) ? 25 : k;
+	if (*position + n > end)
+		return 0;
+	zigzag = MS5611_Log_Get_Bits(payload, *position, n);
+	if (q != MS5611_LOG_RICE_ESCAPE)
+		zigzag |= q << k;
+	*position += n;
+
+	*delta = (int32_t) (zigzag >> 1) ^ -(int32_t) (zigzag & 1);
+	return 1;
+}
+
+/**
+ * @brief  Computes the CRC-32 (IEEE 802.3) of a buffer
+ * @note   Nibble table, 64 bytes of flash, two lookups per byte
+ * @param  data Pointer to data
+ * @param  length Number of bytes
+ * @retval uint32_t CRC value
+ */
+uint32_t MS5611_Log_CRC32(const uint8_t *data, uint32_t length){
+	static const uint32_t crcTable[16] = {
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+	};
+	uint32_t crc = 0xFFFFFFFF;
+
+	while (length--) {
+		crc ^= *data++;
+		crc = (crc >> 4) ^ crcTable[crc & 0x0F];
+		crc = (crc >> 4) ^ crcTable[crc & 0x0F];
+	}
+
+	return ~crc;
+}
+
+/**
+ * @brief  Initializes an encoder and writes the log header
+ * @param  encoder Pointer to MS5611_Log_Encoder_TypeDef structure
+ * @param  write Output callback
+ * @param  context Callback context
+ * @param  prom PROM words in struct promData order
+ * @param  osr MS5611_OSR_* used for recording
+ * @param  rate_hz Nominal sample rate
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Encoder_Init(MS5611_Log_Encoder_TypeDef *encoder, MS5611_Log_WriteFnTypeDef write, void *context,
+                                               const uint16_t prom[8], uint8_t osr, uint32_t rate_hz){
+	uint8_t header[MS5611_LOG_HEADER_SIZE];
+	uint8_t i;
+
+	MS5611_Log_Encoder_Resume(encoder, write, context, 0);
+
+	for (i = 0; i < 4; i++)
+		header[i] = logMagic[i];
+	header[4] = MS5611_LOG_VERSION;
+	header[5] = osr;
+	MS5611_Log_Put16(&header[6], MS5611_LOG_BLOCK_SIZE);
+	MS5611_Log_Put32(&header[8], rate_hz);
+	for (i = 0; i < 8; i++)
+		MS5611_Log_Put16(&header[12 + 2 * i], prom[i]);
+	MS5611_Log_Put32(&header[28], MS5611_Log_CRC32(header, 28));
+
+	if (write(context, header, MS5611_LOG_HEADER_SIZE) != 0)
+		return MS5611_LOG_IO_ERROR;
+
+	return MS5611_LOG_OK;
+}
+
+/**
+ * @brief  Initializes an encoder that appends blocks to an existing log
+ * @param  encoder Pointer to MS5611_Log_Encoder_TypeDef structure
+ * @param  write Output callback, positioned at the end of the log
+ * @param  context Callback context
+ * @param  next_sequence Sequence number of the first appended block
+ * @retval None
+ */
+void MS5611_Log_Encoder_Resume(MS5611_Log_Encoder_TypeDef *encoder, MS5611_Log_WriteFnTypeDef write, void *context, uint32_t next_sequence){
+	encoder->write = write;
+	encoder->context = context;
+	encoder->sequence = next_sequence;
+	encoder->last_d1 = 0;
+	encoder->last_d2 = 0;
+	encoder->sum_d1 = 0;
+	encoder->sum_d2 = 0;
+	encoder->bits = 0;
+	encoder->bit_count = 0;
+	encoder->k1 = MS5611_LOG_RICE_K1_DEFAULT;
+	encoder->k2 = MS5611_LOG_RICE_K2_DEFAULT;
+	encoder->used = 0;
+	encoder->count = 0;
+}
+
+/**
+ * @brief  Appends one raw D1/D2 pair, writing a block when it is full
+ * @note   The first sample of every block is stored verbatim, so blocks decode
+ *         independently. Deltas are Rice coded with parameters taken from the mean
+ *         delta of the previous block; a delta costs k + 1 bits plus one per 2^k.
+ * @param  encoder Pointer to MS5611_Log_Encoder_TypeDef structure
+ * @param  d1 Raw pressure word
+ * @param  d2 Raw temperature word
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Append(MS5611_Log_Encoder_TypeDef *encoder, uint32_t d1, uint32_t d2){
+	d1 &= 0xFFFFFF;
+	d2 &= 0xFFFFFF;
+
+	if (encoder->count > 0 &&
+	    ((uint32_t) encoder->used * 8U + encoder->bit_count + MS5611_LOG_MAX_SAMPLE_BITS >
+	     (MS5611_LOG_BLOCK_SIZE - MS5611_LOG_CRC_SIZE) * 8U || encoder->count == 0xFFFF)) {
+		MS5611LogStatusTypeDef status = MS5611_Log_Flush(encoder);
+		if (status != MS5611_LOG_OK)
+			return status;
+	}
+
+	if (encoder->count == 0) {
+		MS5611_Log_Put24(&encoder->block[8], d1);
+		MS5611_Log_Put24(&encoder->block[11], d2);
+		encoder->used = MS5611_LOG_BLOCK_HEADER_SIZE;
+	} else {
+		encoder->sum_d1 += MS5611_Log_Put_Delta(encoder, d1, encoder->last_d1, encoder->k1);
+		encoder->sum_d2 += MS5611_Log_Put_Delta(encoder, d2, encoder->last_d2, encoder->k2);
+	}
+
+	encoder->last_d1 = d1;
+	encoder->last_d2 = d2;
+	encoder->count++;
+
+	return MS5611_LOG_OK;
+}
+
+/**
+ * @brief  Writes the open block, if any, padded to the block size
+ * @param  encoder Pointer to MS5611_Log_Encoder_TypeDef structure
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Flush(MS5611_Log_Encoder_TypeDef *encoder){
+	uint16_t i;
+
+	if (encoder->count == 0)
+		return MS5611_LOG_OK;
+
+	if (encoder->bit_count > 0)
+		encoder->block[encoder->used++] = (uint8_t) encoder->bits;
+
+	MS5611_Log_Put32(&encoder->block[0], encoder->sequence);
+	MS5611_Log_Put16(&encoder->block[4], encoder->count);
+	MS5611_Log_Put16(&encoder->block[6], (uint16_t) (encoder->used - MS5611_LOG_BLOCK_HEADER_SIZE));
+	encoder->block[14] = encoder->k1;
+	encoder->block[15] = encoder->k2;
+	for (i = encoder->used; i < MS5611_LOG_BLOCK_SIZE - MS5611_LOG_CRC_SIZE; i++)
+		encoder->block[i] = 0;
+	MS5611_Log_Put32(&encoder->block[MS5611_LOG_BLOCK_SIZE - MS5611_LOG_CRC_SIZE],
+	                 MS5611_Log_CRC32(encoder->block, MS5611_LOG_BLOCK_SIZE - MS5611_LOG_CRC_SIZE));
+
+	encoder->k1 = MS5611_Log_Rice_Parameter(encoder->sum_d1, (uint16_t) (encoder->count - 1), encoder->k1);
+	encoder->k2 = MS5611_Log_Rice_Parameter(encoder->sum_d2, (uint16_t) (encoder->count - 1), encoder->k2);
+	encoder->sum_d1 = 0;
+	encoder->sum_d2 = 0;
+	encoder->bits = 0;
+	encoder->bit_count = 0;
+	encoder->sequence++;
+	encoder->count = 0;
+	encoder->used = 0;
+
+	if (encoder->write(encoder->context, encoder->block, MS5611_LOG_BLOCK_SIZE) != 0)
+		return MS5611_LOG_IO_ERROR;
+
+	return MS5611_LOG_OK;
+}
+
+/**
+ * @brief  Parses and verifies a log header
+ * @param  data Pointer to at least MS5611_LOG_HEADER_SIZE bytes
+ * @param  header Pointer to MS5611_Log_Header_TypeDef structure
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Decode_Header(const uint8_t *data, MS5611_Log_Header_TypeDef *header){
+	uint8_t i;
+
+	for (i = 0; i < 4; i++)
+		if (data[i] != logMagic[i])
+			return MS5611_LOG_FORMAT_ERROR;
+
+	if (MS5611_Log_Get32(&data[28]) != MS5611_Log_CRC32(data, 28))
+		return MS5611_LOG_CRC_ERROR;
+
+	header->version = data[4];
+	header->osr = data[5];
+	header->block_size = MS5611_Log_Get16(&data[6]);
+	header->rate_hz = MS5611_Log_Get32(&data[8]);
+	for (i = 0; i < 8; i++)
+		header->prom[i] = MS5611_Log_Get16(&data[12 + 2 * i]);
+
+	if (header->version != MS5611_LOG_VERSION ||
+	    header->block_size < MS5611_LOG_BLOCK_HEADER_SIZE + MS5611_LOG_CRC_SIZE)
+		return MS5611_LOG_FORMAT_ERROR;
+
+	return MS5611_LOG_OK;
+}
+
+/**
+ * @brief  Verifies and decodes one block into column arrays
+ * @param  block Pointer to block_size bytes
+ * @param  block_size Block size from the header
+ * @param  sequence Pointer to store the block sequence number
+ * @param  d1 Array to store raw pressure words
+ * @param  d2 Array to store raw temperature words
+ * @param  capacity Length of d1 and d2
+ * @param  count Pointer to store the number of decoded samples
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Decode_Block(const uint8_t *block, uint16_t block_size, uint32_t *sequence,
+                                               uint32_t *d1, uint32_t *d2, uint16_t capacity, uint16_t *count){
+	const uint8_t *payload;
+	uint32_t position = 0;
+	uint32_t end;
+	uint16_t samples;
+	uint16_t length;
+	uint16_t i;
+	uint8_t k1, k2;
+	int32_t delta;
+
+	*count = 0;
+
+	if (MS5611_Log_Get32(&block[block_size - MS5611_LOG_CRC_SIZE]) != MS5611_Log_CRC32(block, block_size - MS5611_LOG_CRC_SIZE))
+		return MS5611_LOG_CRC_ERROR;
+
+	*sequence = MS5611_Log_Get32(&block[0]);
+	samples = MS5611_Log_Get16(&block[4]);
+	length = MS5611_Log_Get16(&block[6]);
+	k1 = block[14];
+	k2 = block[15];
+
+	if (samples == 0 || samples > capacity || k1 > MS5611_LOG_RICE_K_MAX || k2 > MS5611_LOG_RICE_K_MAX ||
+	    length > block_size - MS5611_LOG_BLOCK_HEADER_SIZE - MS5611_LOG_CRC_SIZE)
+		return MS5611_LOG_FORMAT_ERROR;
+
+	d1[0] = MS5611_Log_Get24(&block[8]);
+	d2[0] = MS5611_Log_Get24(&block[11]);
+
+	payload = &block[MS5611_LOG_BLOCK_HEADER_SIZE];
+	end = (uint32_t) length * 8U;
+	for (i = 1; i < samples; i++) {
+		if (!MS5611_Log_Get_Delta(payload, &position, end, k1, &delta))
+			return MS5611_LOG_FORMAT_ERROR;
+		d1[i] = (uint32_t) ((int32_t) d1[i - 1] + delta) & 0xFFFFFF;
+
+		if (!MS5611_Log_Get_Delta(payload, &position, end, k2, &delta))
+			return MS5611_LOG_FORMAT_ERROR;
+		d2[i] = (uint32_t) ((int32_t) d2[i - 1] + delta) & 0xFFFFFF;
+	}
+
+	*count = samples;
+	return MS5611_LOG_OK;
+}
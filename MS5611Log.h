@@ -0,0 +1,174 @@
+/* ============================================================================================
+ * MS5611Log.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Raw sample log format (all fields little-endian):
+ *
+ *   Header, MS5611_LOG_HEADER_SIZE bytes
+ *     "MS5L" | version u8 | osr u8 | block_size u16 | rate_hz u32 | prom u16[8] | crc32 u32
+ *
+ *   Blocks, block_size bytes each, independently decodable
+ *     sequence u32 | count u16 | payload u16 | first D1 u24 | first D2 u24 | k1 u8 | k2 u8 |
+ *     (count - 1) x { rice(zigzag dD1, k1), rice(zigzag dD2, k2) } | zero padding | crc32 u32
+ *
+ *   The payload is a bit stream, least significant bit first. rice(v, k) writes q = v >> k
+ *   as q one bits and a zero bit, then the low k bits of v; when q reaches
+ *   MS5611_LOG_RICE_ESCAPE it writes that many one bits and all 25 bits of v instead.
+ */
+
+#ifndef _MS5611LOG_H_
+#define _MS5611LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- Log Format Constants ---
+#define MS5611_LOG_VERSION            2
+#define MS5611_LOG_HEADER_SIZE        32
+#define MS5611_LOG_BLOCK_HEADER_SIZE  16
+#define MS5611_LOG_CRC_SIZE           4
+#define MS5611_LOG_RICE_ESCAPE        16    /**< Unary prefix length that marks a verbatim value */
+
+#ifndef MS5611_LOG_BLOCK_SIZE
+#define MS5611_LOG_BLOCK_SIZE         256   /**< Bytes per block, one block of RAM in the encoder */
+#endif
+
+/** Upper bound of samples in a block of the given size (every delta encoded in one bit) */
+#define MS5611_LOG_BLOCK_CAPACITY(block_size) \
+  ((1UL + 4UL * ((block_size) - MS5611_LOG_BLOCK_HEADER_SIZE - MS5611_LOG_CRC_SIZE)) > 65535UL ? 65535UL : \
+   (1UL + 4UL * ((block_size) - MS5611_LOG_BLOCK_HEADER_SIZE - MS5611_LOG_CRC_SIZE)))
+
+/** Upper bound of samples in one block of this build */
+#define MS5611_LOG_BLOCK_MAX_SAMPLES  MS5611_LOG_BLOCK_CAPACITY(MS5611_LOG_BLOCK_SIZE)
+
+// --- Log Status ---
+typedef enum MS5611LogStatus{
+  MS5611_LOG_OK,              /**< Operation completed */
+  MS5611_LOG_IO_ERROR,        /**< Write callback reported an error */
+  MS5611_LOG_FORMAT_ERROR,    /**< Bad magic, version or block layout */
+  MS5611_LOG_CRC_ERROR        /**< CRC mismatch */
+}MS5611LogStatusTypeDef;
+
+// --- Write Callback, returns 0 on success ---
+typedef int (*MS5611_Log_WriteFnTypeDef)(void *context, const uint8_t *data, uint32_t length);
+
+// --- Log Header ---
+typedef struct {
+  uint8_t version;            /**< Format version */
+  uint8_t osr;                /**< MS5611_OSR_* used for recording */
+  uint16_t block_size;        /**< Bytes per block */
+  uint32_t rate_hz;           /**< Nominal sample rate */
+  uint16_t prom[8];           /**< PROM words, same order as struct promData */
+} MS5611_Log_Header_TypeDef;
+
+// --- Streaming Encoder ---
+typedef struct {
+  MS5611_Log_WriteFnTypeDef write;         /**< Output callback */
+  void *context;                           /**< Callback context */
+  uint32_t sequence;                       /**< Sequence number of the open block */
+  uint32_t last_d1;                        /**< Previous D1 of the open block */
+  uint32_t last_d2;                        /**< Previous D2 of the open block */
+  uint64_t sum_d1;                         /**< Sum of zigzag D1 deltas in the open block */
+  uint64_t sum_d2;                         /**< Sum of zigzag D2 deltas in the open block */
+  uint32_t bits;                           /**< Pending payload bits, not yet a whole byte */
+  uint8_t bit_count;                       /**< Number of pending bits, 0..7 */
+  uint8_t k1;                              /**< Rice parameter of D1 in the open block */
+  uint8_t k2;                              /**< Rice parameter of D2 in the open block */
+  uint16_t used;                           /**< Bytes used in the open block */
+  uint16_t count;                          /**< Samples in the open block */
+  uint8_t block[MS5611_LOG_BLOCK_SIZE];    /**< Open block */
+} MS5611_Log_Encoder_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Initializes an encoder and writes the log header
+ * @param  encoder Pointer to encoder
+ * @param  write Output callback
+ * @param  context Callback context
+ * @param  prom PROM words in struct promData order
+ * @param  osr MS5611_OSR_* used for recording
+ * @param  rate_hz Nominal sample rate
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Encoder_Init(MS5611_Log_Encoder_TypeDef *encoder, MS5611_Log_WriteFnTypeDef write, void *context,
+                                               const uint16_t prom[8], uint8_t osr, uint32_t rate_hz);
+
+/**
+ * @brief  Initializes an encoder that appends blocks to an existing log
+ * @param  encoder Pointer to encoder
+ * @param  write Output callback, positioned at the end of the log
+ * @param  context Callback context
+ * @param  next_sequence Sequence number of the first appended block
+ */
+void MS5611_Log_Encoder_Resume(MS5611_Log_Encoder_TypeDef *encoder, MS5611_Log_WriteFnTypeDef write, void *context, uint32_t next_sequence);
+
+/**
+ * @brief  Appends one raw D1/D2 pair, writing a block when it is full
+ * @param  encoder Pointer to encoder
+ * @param  d1 Raw pressure word
+ * @param  d2 Raw temperature word
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Append(MS5611_Log_Encoder_TypeDef *encoder, uint32_t d1, uint32_t d2);
+
+/**
+ * @brief  Writes the open block, if any, padded to the block size
+ * @param  encoder Pointer to encoder
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Flush(MS5611_Log_Encoder_TypeDef *encoder);
+
+/**
+ * @brief  Parses and verifies a log header
+ * @param  data Pointer to at least MS5611_LOG_HEADER_SIZE bytes
+ * @param  header Pointer to store the parsed header
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Decode_Header(const uint8_t *data, MS5611_Log_Header_TypeDef *header);
+
+/**
+ * @brief  Verifies and decodes one block into column arrays
+ * @param  block Pointer to block_size bytes
+ * @param  block_size Block size from the header
+ * @param  sequence Pointer to store the block sequence number
+ * @param  d1 Array to store raw pressure words
+ * @param  d2 Array to store raw temperature words
+ * @param  capacity Length of d1 and d2
+ * @param  count Pointer to store the number of decoded samples
+ * @retval MS5611LogStatusTypeDef Status
+ */
+MS5611LogStatusTypeDef MS5611_Log_Decode_Block(const uint8_t *block, uint16_t block_size, uint32_t *sequence,
+                                               uint32_t *d1, uint32_t *d2, uint16_t capacity, uint16_t *count);
+
+/**
+ * @brief  Computes the CRC-32 (IEEE 802.3) of a buffer
+ * @param  data Pointer to data
+ * @param  length Number of bytes
+ * @retval uint32_t CRC value
+ */
+uint32_t MS5611_Log_CRC32(const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611LOG_H_ */
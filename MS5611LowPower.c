@@ -0,0 +1,160 @@
+/* ============================================================================================
+ * MS5611LowPower.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Duty-cycled acquisition: every conversion window is spent in a low-power state woken by
+ * a timer. Awake time is measured with the handle's timestamp source. With the default DWT
+ * source the cycle counter halts in STOP mode, so the measured ticks are run time only.
+ */
+
+#include <MS5611LowPower.h>
+
+/**
+ * @brief  Starts one conversion and sleeps until its wakeup timer fires
+ * @param  lp Pointer to MS5611_LowPower_TypeDef structure
+ * @param  command CONVERT_D1_COMMAND or CONVERT_D2_COMMAND
+ * @param  raw_data Pointer to store the 24-bit raw ADC value
+ * @param  awake Pointer accumulating run ticks
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error
+ */
+static MS5611StateTypeDef MS5611_LowPower_Convert(MS5611_LowPower_TypeDef *lp, uint8_t command, uint32_t *raw_data, uint32_t *awake){
+	MS5611_HW_InitTypeDef *hw = lp->hw;
+	MS5611StateTypeDef state;
+	uint32_t start = MS5611_Get_Timestamp(hw);
+
+	if (command == CONVERT_D1_COMMAND)
+		state = MS5611_Pressure_Conversion(hw, lp->osr);
+	else
+		state = MS5611_Temperature_Conversion(hw, lp->osr);
+
+	if (state != MS5611_STATE_BUSY)
+		return MS5611_HAL_ERROR;
+
+	lp->woken = 0;
+	lp->arm_wakeup(lp->context, MS5611_Conversion_Time_Us(lp->osr));
+	*awake += MS5611_Get_Timestamp(hw) - start;
+
+	/* PRIMASK closes the check-then-sleep race: WFI still wakes on a pending
+	   interrupt, which is then serviced once interrupts are re-enabled.
+	   Spurious wakeups (other interrupts) go straight back to sleep. */
+	__disable_irq();
+	while (!lp->woken) {
+		lp->enter_low_power(lp->context);
+		__enable_irq();
+		__disable_irq();
+	}
+	__enable_irq();
+
+	start = MS5611_Get_Timestamp(hw);
+	state = MS5611_ADC_Read(hw, raw_data);
+	*awake += MS5611_Get_Timestamp(hw) - start;
+
+	return state;
+}
+
+/**
+ * @brief  Initializes a low-power acquisition context
+ * @note   Current model defaults to 3300 mV, 5 mA run, 5 uA STOP; adjust per board
+ * @param  lp Pointer to MS5611_LowPower_TypeDef structure
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @param  osr MS5611_OSR_* value
+ * @param  arm_wakeup Wakeup timer hook
+ * @param  enter_low_power Low-power entry hook
+ * @param  context Hook context
+ * @retval None
+ */
+void MS5611_LowPower_Init(MS5611_LowPower_TypeDef *lp, MS5611_HW_InitTypeDef *MS5611_Handler, uint8_t osr,
+                          MS5611_LP_ArmWakeupFnTypeDef arm_wakeup, MS5611_LP_SleepFnTypeDef enter_low_power, void *context){
+	lp->hw = MS5611_Handler;
+	lp->osr = osr;
+	lp->temperature_decimation = 1;
+	lp->arm_wakeup = arm_wakeup;
+	lp->enter_low_power = enter_low_power;
+	lp->on_energy = NULL;
+	lp->context = context;
+	lp->supply_mv = 3300;
+	lp->run_current_ua = 5000;
+	lp->sleep_current_ua = 5;
+	lp->sensor_current_ua = MS5611_LP_SENSOR_CONVERSION_UA;
+	lp->woken = 0;
+	lp->remaining = 0;
+	lp->raw.pressure = 0;
+	lp->raw.temperature = 0;
+}
+
+/**
+ * @brief  Wakeup notification, call from the LPTIM interrupt callback
+ * @param  lp Pointer to MS5611_LowPower_TypeDef structure
+ * @retval None
+ */
+void MS5611_LowPower_Wakeup(MS5611_LowPower_TypeDef *lp){
+	lp->woken = 1;
+}
+
+/**
+ * @brief  Acquires one sample, sleeping through every conversion window
+ * @note   After a STOP mode wakeup the application must restore its clocks inside
+ *         enter_low_power before returning, as SPI runs from the system clock
+ * @param  lp Pointer to MS5611_LowPower_TypeDef structure
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure to store the sample
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_LowPower_Sample(MS5611_LowPower_TypeDef *lp, MS5611_Converted_Data_TypeDef *value){
+	MS5611_LowPower_Report_TypeDef report;
+	uint32_t conversionUs = MS5611_Conversion_Time_Us(lp->osr);
+	uint32_t awake = 0;
+	uint32_t start;
+	uint64_t energy;
+
+	report.conversions = 1;
+
+	if (lp->remaining == 0) {
+		if (MS5611_LowPower_Convert(lp, CONVERT_D2_COMMAND, &lp->raw.temperature, &awake) != MS5611_STATE_READY)
+			return MS5611_HAL_ERROR;
+		lp->remaining = lp->temperature_decimation ? lp->temperature_decimation : 1;
+		report.conversions = 2;
+	}
+
+	if (MS5611_LowPower_Convert(lp, CONVERT_D1_COMMAND, &lp->raw.pressure, &awake) != MS5611_STATE_READY) {
+		lp->remaining = 0;
+		return MS5611_HAL_ERROR;
+	}
+	lp->remaining--;
+
+	start = MS5611_Get_Timestamp(lp->hw);
+	MS5611_Instance_Data_Convert(lp->hw, &lp->raw, value);
+	awake += MS5611_Get_Timestamp(lp->hw) - start;
+
+	if (lp->on_energy == NULL)
+		return MS5611_STATE_READY;
+
+	report.osr = lp->osr;
+	report.awake_ticks = awake;
+	report.awake_us = (lp->hw->TicksPerUs != 0) ? awake / lp->hw->TicksPerUs : 0;
+	report.sleep_us = conversionUs * report.conversions;
+	report.duty_permille = (uint32_t) ((uint64_t) report.awake_us * 1000U / (report.awake_us + report.sleep_us));
+
+	/* mV * uA * us = 1e-15 J, so divide by 1e6 for nJ */
+	energy = (uint64_t) lp->run_current_ua * report.awake_us +
+	         (uint64_t) lp->sleep_current_ua * report.sleep_us +
+	         (uint64_t) lp->sensor_current_ua * report.sleep_us;
+	report.energy_nj = (uint32_t) (energy * lp->supply_mv / 1000000U);
+
+	lp->on_energy(lp->context, &report);
+
+	return MS5611_STATE_READY;
+}
@@ -0,0 +1,100 @@
+/* ============================================================================================
+ * MS5611LowPower.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611LOWPOWER_H_
+#define _MS5611LOWPOWER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "MS5611SPI.h"
+
+// --- Default Current Model ---
+#define MS5611_LP_SENSOR_CONVERSION_UA  1400U  /**< MS5611 supply current during conversion */
+
+// --- Energy Report, one per pressure sample ---
+typedef struct {
+  uint8_t osr;              /**< OSR of the sample */
+  uint8_t conversions;      /**< Conversions in this sample (2 with temperature, else 1) */
+  uint32_t awake_ticks;     /**< MCU run time spent on this sample, timestamp ticks */
+  uint32_t awake_us;        /**< MCU run time spent on this sample */
+  uint32_t sleep_us;        /**< Time spent in the low-power state */
+  uint32_t duty_permille;   /**< awake_us / (awake_us + sleep_us) in 1/1000 */
+  uint32_t energy_nj;       /**< Estimated MCU + sensor energy for this sample */
+} MS5611_LowPower_Report_TypeDef;
+
+// --- Platform Hooks ---
+typedef void (*MS5611_LP_ArmWakeupFnTypeDef)(void *context, uint32_t us);  /**< Arm LPTIM to wake after us */
+typedef void (*MS5611_LP_SleepFnTypeDef)(void *context);                   /**< Enter STOP/SLEEP (WFI), called with interrupts masked */
+typedef void (*MS5611_LP_ReportFnTypeDef)(void *context, const MS5611_LowPower_Report_TypeDef *report);
+
+// --- Low-Power Acquisition Context ---
+typedef struct {
+  MS5611_HW_InitTypeDef *hw;                  /**< Sensor handle */
+  uint8_t osr;                                /**< OSR for both conversions */
+  uint8_t temperature_decimation;             /**< Pressure samples per temperature conversion */
+  MS5611_LP_ArmWakeupFnTypeDef arm_wakeup;    /**< Wakeup timer hook */
+  MS5611_LP_SleepFnTypeDef enter_low_power;   /**< Low-power entry hook */
+  MS5611_LP_ReportFnTypeDef on_energy;        /**< Optional per-sample energy report */
+  void *context;                              /**< Hook context */
+  uint32_t supply_mv;                         /**< Supply voltage for the energy estimate */
+  uint32_t run_current_ua;                    /**< MCU current while running */
+  uint32_t sleep_current_ua;                  /**< MCU current in the low-power state */
+  uint32_t sensor_current_ua;                 /**< Sensor current during conversion */
+
+  // Driver-managed state, do not set
+  volatile uint8_t woken;                     /**< Set by MS5611_LowPower_Wakeup */
+  uint8_t remaining;                          /**< Pressure samples left before the next temperature */
+  MS5611_Raw_Data_TypeDef raw;                /**< Last raw pair */
+} MS5611_LowPower_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Initializes a low-power acquisition context
+ * @param  lp Pointer to context
+ * @param  MS5611_Handler Pointer to hardware initialization structure, already passed to MS5611_Init
+ * @param  osr MS5611_OSR_* value
+ * @param  arm_wakeup Wakeup timer hook
+ * @param  enter_low_power Low-power entry hook
+ * @param  context Hook context
+ */
+void MS5611_LowPower_Init(MS5611_LowPower_TypeDef *lp, MS5611_HW_InitTypeDef *, uint8_t osr,
+                          MS5611_LP_ArmWakeupFnTypeDef arm_wakeup, MS5611_LP_SleepFnTypeDef enter_low_power, void *context);
+
+/**
+ * @brief  Wakeup notification, call from the LPTIM interrupt callback
+ * @param  lp Pointer to context
+ */
+void MS5611_LowPower_Wakeup(MS5611_LowPower_TypeDef *lp);
+
+/**
+ * @brief  Acquires one sample, sleeping through every conversion window
+ * @param  lp Pointer to context
+ * @param  value Pointer to store the compensated sample
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_LowPower_Sample(MS5611_LowPower_TypeDef *lp, MS5611_Converted_Data_TypeDef *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611LOWPOWER_H_ */
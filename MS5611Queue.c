@@ -0,0 +1,285 @@
+/* ============================================================================================
+ * MS5611Queue.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * SPI transaction queue. Operations are described by small descriptors (command byte,
+ * reply length, destination, completion callback) and appended to a ring. One engine per
+ * bus drains the ring from the SPI completion interrupt: each completion releases chip
+ * select, unpacks the reply and starts the next descriptor at once, so a PROM burst or the
+ * ADC reads of several sensors run back to back without returning to the task. Transfers
+ * use interrupt mode, or DMA when MS5611_QUEUE_USE_DMA is defined.
+ */
+
+#include <MS5611Queue.h>
+
+#define MS5611_QUEUE_MASK             (MS5611_QUEUE_DEPTH - 1U)
+
+#if defined(MS5611_QUEUE_USE_DMA)
+#define MS5611_QUEUE_TRANSFER         HAL_SPI_TransmitReceive_DMA
+#else
+#define MS5611_QUEUE_TRANSFER         HAL_SPI_TransmitReceive_IT
+#endif
+
+/**
+ * @brief  Completes the descriptor at the tail and releases the bus
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  state READY on success, HAL_ERROR on bus error
+ * @retval None
+ */
+static void MS5611_Queue_Finish(MS5611_Queue_TypeDef *q, MS5611StateTypeDef state){
+	MS5611_Queue_Txn_TypeDef txn = q->txn[q->tail & MS5611_QUEUE_MASK];
+	uint32_t now;
+
+	disableCS_MS5611(txn.hw->CS_GPIOport, txn.hw->CS_GPIOpin);
+	now = MS5611_Get_Timestamp(txn.hw);
+	q->busy_ticks += now - q->start;
+	q->last_complete = now;
+
+	if (state == MS5611_STATE_READY) {
+		q->transactions++;
+
+		if ((txn.command & 0xE0) == CONVERT_D1_COMMAND) {
+			txn.hw->Stamp.conversion_start = now;
+			txn.hw->ConversionCommand = txn.command;
+		} else if (txn.command == READ_ADC_COMMAND) {
+			txn.hw->Stamp.adc_read = now;
+		}
+
+		/* Replies are big-endian on the wire; unpack into native words */
+		if (txn.dest != NULL && txn.rx_length == 2)
+			*(uint16_t *) txn.dest = (uint16_t) (((uint16_t) q->rx[1] << 8) | q->rx[2]);
+		else if (txn.dest != NULL && txn.rx_length == 3)
+			*(uint32_t *) txn.dest = ((uint32_t) q->rx[1] << 16) | ((uint32_t) q->rx[2] << 8) | (uint32_t) q->rx[3];
+	} else {
+		q->errors++;
+	}
+
+	/* Free the slot before the callback, so it can submit follow-up transactions */
+	q->tail++;
+
+	if (txn.done != NULL)
+		txn.done(txn.context, &txn, state);
+}
+
+/**
+ * @brief  Starts the descriptor at the tail, or marks the engine idle when the ring is empty
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  first Non-zero when the bus was idle before this call
+ * @retval None
+ */
+static void MS5611_Queue_Start(MS5611_Queue_TypeDef *q, uint8_t first){
+	MS5611_Queue_Txn_TypeDef *txn;
+	uint32_t primask;
+
+	for (;;) {
+		primask = __get_PRIMASK();
+		__disable_irq();
+		if (q->tail == q->head) {
+			q->running = 0;
+			__set_PRIMASK(primask);
+			return;
+		}
+		__set_PRIMASK(primask);
+
+		txn = &q->txn[q->tail & MS5611_QUEUE_MASK];
+		q->tx[0] = txn->command;
+		q->tx[1] = 0;
+		q->tx[2] = 0;
+		q->tx[3] = 0;
+
+		enableCS_MS5611(txn->hw->CS_GPIOport, txn->hw->CS_GPIOpin);
+		q->start = MS5611_Get_Timestamp(txn->hw);
+
+		if (!first) {
+			uint32_t gap = q->start - q->last_complete;
+
+			q->gap_ticks += gap;
+			q->gaps++;
+			if (gap > q->gap_max)
+				q->gap_max = gap;
+		}
+
+		if (MS5611_QUEUE_TRANSFER(q->SPIhandler, q->tx, q->rx, (uint16_t) (1U + txn->rx_length)) == HAL_OK)
+			return;
+
+		MS5611_Queue_Finish(q, MS5611_HAL_ERROR);
+		first = 0;
+	}
+}
+
+/**
+ * @brief  Appends descriptors as one unit and starts the bus if it was idle
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  txn Descriptors to append
+ * @param  count Number of descriptors
+ * @retval MS5611StateTypeDef READY when queued, BUSY when the ring lacks space
+ */
+static MS5611StateTypeDef MS5611_Queue_Push(MS5611_Queue_TypeDef *q, const MS5611_Queue_Txn_TypeDef *txn, uint8_t count){
+	uint32_t primask = __get_PRIMASK();
+	uint8_t kick;
+	uint8_t i;
+
+	__disable_irq();
+	if (MS5611_QUEUE_DEPTH - (q->head - q->tail) < count) {
+		q->rejected++;
+		__set_PRIMASK(primask);
+		return MS5611_STATE_BUSY;
+	}
+
+	for (i = 0; i < count; i++)
+		q->txn[(q->head + i) & MS5611_QUEUE_MASK] = txn[i];
+	q->head += count;
+
+	kick = !q->running;
+	if (kick) {
+		q->running = 1;
+		q->bursts++;
+	}
+	__set_PRIMASK(primask);
+
+	if (kick)
+		MS5611_Queue_Start(q, 1);
+
+	return MS5611_STATE_READY;
+}
+
+/**
+ * @brief  Initializes an empty transaction queue
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  hspi SPI bus drained by the queue
+ * @retval None
+ */
+void MS5611_Queue_Init(MS5611_Queue_TypeDef *q, SPI_HandleTypeDef *hspi){
+	q->SPIhandler = hspi;
+	q->head = 0;
+	q->tail = 0;
+	q->running = 0;
+	q->start = 0;
+	q->last_complete = 0;
+	MS5611_Queue_Stats_Reset(q);
+}
+
+/**
+ * @brief  Clears the queue statistics
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @retval None
+ */
+void MS5611_Queue_Stats_Reset(MS5611_Queue_TypeDef *q){
+	q->transactions = 0;
+	q->bursts = 0;
+	q->errors = 0;
+	q->rejected = 0;
+	q->busy_ticks = 0;
+	q->gap_ticks = 0;
+	q->gap_max = 0;
+	q->gaps = 0;
+}
+
+/**
+ * @brief  Appends one transaction and starts the bus if it was idle
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  hw Sensor handle on the queue's bus
+ * @param  command Command byte
+ * @param  rx_length Reply bytes: 0, 2 or 3
+ * @param  dest Reply destination, uint16_t* for 2 bytes, uint32_t* for 3, or NULL
+ * @param  done Completion callback, or NULL
+ * @param  context Callback context
+ * @retval MS5611StateTypeDef READY when queued, BUSY when full, FAILED on invalid arguments
+ */
+MS5611StateTypeDef MS5611_Queue_Submit(MS5611_Queue_TypeDef *q, MS5611_HW_InitTypeDef *hw, uint8_t command, uint8_t rx_length,
+                                       void *dest, MS5611_Queue_DoneFnTypeDef done, void *context){
+	MS5611_Queue_Txn_TypeDef txn;
+
+	if (hw->SPIhandler != q->SPIhandler || rx_length == 1 || rx_length > 3)
+		return MS5611_STATE_FAILED;
+
+	txn.hw = hw;
+	txn.command = command;
+	txn.rx_length = rx_length;
+	txn.dest = dest;
+	txn.done = done;
+	txn.context = context;
+
+	return MS5611_Queue_Push(q, &txn, 1);
+}
+
+/**
+ * @brief  Queues the 8 PROM reads of one sensor as a single burst
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  hw Sensor handle on the queue's bus
+ * @param  prom PROM structure to fill
+ * @param  done Completion callback, or NULL
+ * @param  context Callback context
+ * @retval MS5611StateTypeDef READY when queued, BUSY when fewer than 8 descriptors are free
+ */
+MS5611StateTypeDef MS5611_Queue_PROM_Read(MS5611_Queue_TypeDef *q, MS5611_HW_InitTypeDef *hw, struct promData *prom,
+                                          MS5611_Queue_DoneFnTypeDef done, void *context){
+	MS5611_Queue_Txn_TypeDef chain[8];
+	uint16_t *words = (uint16_t *) prom;
+	uint8_t address;
+
+	if (hw->SPIhandler != q->SPIhandler)
+		return MS5611_STATE_FAILED;
+
+	for (address = 0; address < 8; address++) {
+		chain[address].hw = hw;
+		chain[address].command = PROM_READ(address);
+		chain[address].rx_length = 2;
+		chain[address].dest = &words[address];
+		chain[address].done = (address == 7) ? done : NULL;
+		chain[address].context = context;
+	}
+
+	return MS5611_Queue_Push(q, chain, 8);
+}
+
+/**
+ * @brief  Returns whether every submitted transaction has completed
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @retval uint8_t Non-zero when idle
+ */
+uint8_t MS5611_Queue_Idle(const MS5611_Queue_TypeDef *q){
+	return q->head == q->tail && !q->running;
+}
+
+/**
+ * @brief  Completion hook, call from HAL_SPI_TxRxCpltCallback
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  hspi SPI handle passed to the HAL callback
+ * @retval None
+ */
+void MS5611_Queue_SPI_Complete(MS5611_Queue_TypeDef *q, SPI_HandleTypeDef *hspi){
+	if (hspi != q->SPIhandler || !q->running)
+		return;
+
+	MS5611_Queue_Finish(q, MS5611_STATE_READY);
+	MS5611_Queue_Start(q, 0);
+}
+
+/**
+ * @brief  Error hook, call from HAL_SPI_ErrorCallback
+ * @param  q Pointer to MS5611_Queue_TypeDef structure
+ * @param  hspi SPI handle passed to the HAL callback
+ * @retval None
+ */
+void MS5611_Queue_SPI_Error(MS5611_Queue_TypeDef *q, SPI_HandleTypeDef *hspi){
+	if (hspi != q->SPIhandler || !q->running)
+		return;
+
+	MS5611_Queue_Finish(q, MS5611_HAL_ERROR);
+	MS5611_Queue_Start(q, 0);
+}
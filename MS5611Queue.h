@@ -0,0 +1,140 @@
+/* ============================================================================================
+ * MS5611Queue.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611QUEUE_H_
+#define _MS5611QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "MS5611SPI.h"
+
+// --- Queue Configuration ---
+#ifndef MS5611_QUEUE_DEPTH
+#define MS5611_QUEUE_DEPTH            16    /**< Descriptors, power of two */
+#endif
+
+typedef struct MS5611_Queue_Txn MS5611_Queue_Txn_TypeDef;
+
+// --- Completion Callback, called from the SPI interrupt ---
+typedef void (*MS5611_Queue_DoneFnTypeDef)(void *context, const MS5611_Queue_Txn_TypeDef *txn, MS5611StateTypeDef state);
+
+// --- Transaction Descriptor: one CS-framed command with its reply ---
+struct MS5611_Queue_Txn {
+  MS5611_HW_InitTypeDef *hw;        /**< Sensor, selects the chip select */
+  uint8_t command;                  /**< Command byte */
+  uint8_t rx_length;                /**< Reply bytes: 0, 2 (PROM word) or 3 (ADC result) */
+  void *dest;                       /**< uint16_t* for 2 bytes, uint32_t* for 3, NULL to discard */
+  MS5611_Queue_DoneFnTypeDef done;  /**< Completion callback, may be NULL */
+  void *context;                    /**< Callback context */
+};
+
+// --- Transaction Queue of one SPI bus ---
+typedef struct {
+  SPI_HandleTypeDef *SPIhandler;                     /**< Bus drained by this queue */
+  MS5611_Queue_Txn_TypeDef txn[MS5611_QUEUE_DEPTH];  /**< Descriptor ring */
+  volatile uint32_t head;                            /**< Descriptors submitted */
+  volatile uint32_t tail;                            /**< Descriptors completed */
+  volatile uint8_t running;                          /**< Non-zero while a transfer is in flight */
+  uint8_t tx[4];                                     /**< Transfer buffers, must stay valid during IT/DMA */
+  uint8_t rx[4];
+  uint32_t start;                                    /**< Start of the transfer in flight, ticks */
+  uint32_t last_complete;                            /**< End of the previous transfer, ticks */
+
+  // Statistics, cleared by MS5611_Queue_Stats_Reset
+  uint32_t transactions;                             /**< Transfers completed */
+  uint32_t bursts;                                   /**< Runs from an idle queue back to idle */
+  uint32_t errors;                                   /**< Transfers that failed to start or ended in error */
+  uint32_t rejected;                                 /**< Submissions refused because the ring was full */
+  uint64_t busy_ticks;                               /**< Sum of transfer start to completion, interrupt entry included */
+  uint64_t gap_ticks;                                /**< Sum of completion to next start inside a burst, ticks */
+  uint32_t gap_max;                                  /**< Longest idle time inside a burst, ticks */
+  uint32_t gaps;                                     /**< Idle intervals accounted in gap_ticks */
+} MS5611_Queue_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Initializes an empty transaction queue
+ * @param  q Pointer to queue
+ * @param  hspi SPI bus drained by the queue, shared by every sensor submitted to it
+ */
+void MS5611_Queue_Init(MS5611_Queue_TypeDef *q, SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief  Clears the queue statistics
+ * @param  q Pointer to queue
+ */
+void MS5611_Queue_Stats_Reset(MS5611_Queue_TypeDef *q);
+
+/**
+ * @brief  Appends one transaction and starts the bus if it was idle
+ * @note   Safe from tasks and from completion callbacks
+ * @param  q Pointer to queue
+ * @param  hw Sensor handle on the queue's bus
+ * @param  command Command byte
+ * @param  rx_length Reply bytes: 0, 2 or 3
+ * @param  dest Reply destination, uint16_t* for 2 bytes, uint32_t* for 3, or NULL
+ * @param  done Completion callback, or NULL
+ * @param  context Callback context
+ * @retval MS5611StateTypeDef READY when queued, BUSY when full, FAILED on invalid arguments
+ */
+MS5611StateTypeDef MS5611_Queue_Submit(MS5611_Queue_TypeDef *q, MS5611_HW_InitTypeDef *hw, uint8_t command, uint8_t rx_length,
+                                       void *dest, MS5611_Queue_DoneFnTypeDef done, void *context);
+
+/**
+ * @brief  Queues the 8 PROM reads of one sensor as a single burst
+ * @note   Words are unpacked in native byte order; done is called once, after the last word
+ * @param  q Pointer to queue
+ * @param  hw Sensor handle on the queue's bus
+ * @param  prom PROM structure to fill
+ * @param  done Completion callback, or NULL
+ * @param  context Callback context
+ * @retval MS5611StateTypeDef READY when queued, BUSY when fewer than 8 descriptors are free
+ */
+MS5611StateTypeDef MS5611_Queue_PROM_Read(MS5611_Queue_TypeDef *q, MS5611_HW_InitTypeDef *hw, struct promData *prom,
+                                          MS5611_Queue_DoneFnTypeDef done, void *context);
+
+/**
+ * @brief  Returns whether every submitted transaction has completed
+ * @param  q Pointer to queue
+ * @retval uint8_t Non-zero when idle
+ */
+uint8_t MS5611_Queue_Idle(const MS5611_Queue_TypeDef *q);
+
+/**
+ * @brief  Completion hook, call from HAL_SPI_TxRxCpltCallback
+ * @param  q Pointer to queue
+ * @param  hspi SPI handle passed to the HAL callback
+ */
+void MS5611_Queue_SPI_Complete(MS5611_Queue_TypeDef *q, SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief  Error hook, call from HAL_SPI_ErrorCallback
+ * @param  q Pointer to queue
+ * @param  hspi SPI handle passed to the HAL callback
+ */
+void MS5611_Queue_SPI_Error(MS5611_Queue_TypeDef *q, SPI_HandleTypeDef *hspi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611QUEUE_H_ */
@@ -0,0 +1,275 @@
+/* ============================================================================================
+ * MS5611RTOS.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * CMSIS-RTOS2 adaptation layer. Transfers run in SPI interrupt mode and the calling task
+ * sleeps on a thread flag (a direct-to-task notification under FreeRTOS) until the HAL
+ * completion callback fires. Conversion waits use osDelay, so the task is never runnable
+ * while the sensor is busy. Reset and PROM read take the same path, so nothing in this
+ * layer calls HAL_Delay or a polled SPI function.
+ */
+
+#include <MS5611RTOS.h>
+
+/**
+ * @brief  Runs one CS-framed SPI transfer in interrupt mode and sleeps until it ends
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  length Bytes to transfer from ctx->tx into ctx->rx
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+static MS5611StateTypeDef MS5611_RTOS_Transfer(MS5611_RTOS_TypeDef *ctx, uint16_t length){
+	MS5611_HW_InitTypeDef *hw = ctx->hw;
+	MS5611StateTypeDef state = MS5611_STATE_READY;
+	uint32_t flags;
+
+	if (ctx->bus_mutex != NULL && osMutexAcquire(ctx->bus_mutex, ctx->timeout_ms) != osOK)
+		return MS5611_HAL_ERROR;
+
+	ctx->waiter = osThreadGetId();
+	osThreadFlagsClear(MS5611_RTOS_FLAG_SPI_DONE | MS5611_RTOS_FLAG_SPI_ERROR);
+
+	enableCS_MS5611(hw->CS_GPIOport, hw->CS_GPIOpin);
+
+	if (HAL_SPI_TransmitReceive_IT(hw->SPIhandler, ctx->tx, ctx->rx, length) != HAL_OK) {
+		state = MS5611_HAL_ERROR;
+	} else {
+		flags = osThreadFlagsWait(MS5611_RTOS_FLAG_SPI_DONE | MS5611_RTOS_FLAG_SPI_ERROR, osFlagsWaitAny, ctx->timeout_ms);
+		if ((flags & osFlagsError) || !(flags & MS5611_RTOS_FLAG_SPI_DONE)) {
+			HAL_SPI_Abort(hw->SPIhandler);
+			state = MS5611_HAL_ERROR;
+		}
+	}
+
+	disableCS_MS5611(hw->CS_GPIOport, hw->CS_GPIOpin);
+	ctx->waiter = NULL;
+
+	if (ctx->bus_mutex != NULL)
+		osMutexRelease(ctx->bus_mutex);
+
+	return state;
+}
+
+/**
+ * @brief  Sleeps for at least the given time
+ * @param  us Microseconds
+ * @retval None
+ */
+static void MS5611_RTOS_Delay_Us(uint32_t us){
+	/* Round up, plus one tick because osDelay may return up to one tick early */
+	osDelay((uint32_t) (((uint64_t) us * osKernelGetTickFreq() + 999999U) / 1000000U) + 1U);
+}
+
+/**
+ * @brief  Initializes the RTOS adaptation context
+ * @note   Defaults: 10 ms transfer timeout, OSR 4096, temperature every sample
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @param  bus_mutex Bus mutex, or NULL when the sensor is alone on its SPI bus
+ * @retval None
+ */
+void MS5611_RTOS_Init(MS5611_RTOS_TypeDef *ctx, MS5611_HW_InitTypeDef *MS5611_Handler, osMutexId_t bus_mutex){
+	ctx->hw = MS5611_Handler;
+	ctx->bus_mutex = bus_mutex;
+	ctx->timeout_ms = 10;
+	ctx->osr = MS5611_OSR_4096;
+	ctx->temperature_decimation = 1;
+	ctx->on_sample = NULL;
+	ctx->context = NULL;
+	ctx->waiter = NULL;
+}
+
+/**
+ * @brief  Completion hook, call from HAL_SPI_TxRxCpltCallback
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  hspi SPI handle passed to the HAL callback
+ * @retval None
+ */
+void MS5611_RTOS_SPI_Complete(MS5611_RTOS_TypeDef *ctx, SPI_HandleTypeDef *hspi){
+	if (hspi == ctx->hw->SPIhandler && ctx->waiter != NULL)
+		osThreadFlagsSet(ctx->waiter, MS5611_RTOS_FLAG_SPI_DONE);
+}
+
+/**
+ * @brief  Error hook, call from HAL_SPI_ErrorCallback
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  hspi SPI handle passed to the HAL callback
+ * @retval None
+ */
+void MS5611_RTOS_SPI_Error(MS5611_RTOS_TypeDef *ctx, SPI_HandleTypeDef *hspi){
+	if (hspi == ctx->hw->SPIhandler && ctx->waiter != NULL)
+		osThreadFlagsSet(ctx->waiter, MS5611_RTOS_FLAG_SPI_ERROR);
+}
+
+/**
+ * @brief  Starts a conversion, sleeping on a thread flag while the command is sent
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  command CONVERT_D1_COMMAND or CONVERT_D2_COMMAND
+ * @param  osr MS5611_OSR_* value
+ * @retval MS5611StateTypeDef BUSY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_Start_Conversion(MS5611_RTOS_TypeDef *ctx, uint8_t command, uint8_t osr){
+	ctx->tx[0] = command | osr;
+
+	if (MS5611_RTOS_Transfer(ctx, 1) != MS5611_STATE_READY)
+		return MS5611_HAL_ERROR;
+
+	ctx->hw->Stamp.conversion_start = MS5611_Get_Timestamp(ctx->hw);
+	ctx->hw->ConversionCommand = ctx->tx[0];
+
+	return MS5611_STATE_BUSY;
+}
+
+/**
+ * @brief  Reads the ADC result, sleeping on a thread flag during the transfer
+ * @note   Command and 3 result bytes go out as one 4-byte transfer, one interrupt
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  raw_data Pointer to store the 24-bit raw ADC value
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_ADC_Read(MS5611_RTOS_TypeDef *ctx, uint32_t *raw_data){
+	ctx->tx[0] = READ_ADC_COMMAND;
+	ctx->tx[1] = 0;
+	ctx->tx[2] = 0;
+	ctx->tx[3] = 0;
+
+	if (MS5611_RTOS_Transfer(ctx, 4) != MS5611_STATE_READY)
+		return MS5611_HAL_ERROR;
+
+	ctx->hw->Stamp.adc_read = MS5611_Get_Timestamp(ctx->hw);
+	*raw_data = ((uint32_t) ctx->rx[1] << 16) | ((uint32_t) ctx->rx[2] << 8) | (uint32_t) ctx->rx[3];
+
+	return MS5611_STATE_READY;
+}
+
+/**
+ * @brief  Converts and reads one channel, sleeping through the conversion time
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  command CONVERT_D1_COMMAND or CONVERT_D2_COMMAND
+ * @param  osr MS5611_OSR_* value
+ * @param  raw_data Pointer to store the 24-bit raw ADC value
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_Measure(MS5611_RTOS_TypeDef *ctx, uint8_t command, uint8_t osr, uint32_t *raw_data){
+	if (MS5611_RTOS_Start_Conversion(ctx, command, osr) != MS5611_STATE_BUSY)
+		return MS5611_HAL_ERROR;
+
+	MS5611_RTOS_Delay_Us(MS5611_Conversion_Time_Us(osr));
+
+	return MS5611_RTOS_ADC_Read(ctx, raw_data);
+}
+
+/**
+ * @brief  Resets the sensor and sleeps through the PROM reload
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_Reset(MS5611_RTOS_TypeDef *ctx){
+	ctx->tx[0] = RESET_COMMAND;
+
+	if (MS5611_RTOS_Transfer(ctx, 1) != MS5611_STATE_READY)
+		return MS5611_HAL_ERROR;
+
+	MS5611_RTOS_Delay_Us(MS5611_RESET_TIME_US);
+
+	return MS5611_STATE_READY;
+}
+
+/**
+ * @brief  Reads the PROM, sleeping on a thread flag during each of the 8 transfers
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @param  prom Pointer to the promData structure to fill
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_PROM_Read(MS5611_RTOS_TypeDef *ctx, struct promData *prom){
+	uint16_t *words = (uint16_t *) prom;
+	uint8_t address;
+
+	for (address = 0; address < 8; address++) {
+		ctx->tx[0] = PROM_READ(address);
+		ctx->tx[1] = 0;
+		ctx->tx[2] = 0;
+
+		if (MS5611_RTOS_Transfer(ctx, 3) != MS5611_STATE_READY)
+			return MS5611_HAL_ERROR;
+
+		words[address] = (uint16_t) (((uint16_t) ctx->rx[1] << 8) | ctx->rx[2]);
+	}
+
+	return MS5611_STATE_READY;
+}
+
+/**
+ * @brief  Task-context replacement for MS5611_Init: reset, PROM read and calibration
+ * @note   Must run in a thread; the CPU is released during every transfer and the reset
+ * @param  ctx Pointer to MS5611_RTOS_TypeDef structure
+ * @retval MS5611StateTypeDef READY, FAILED for an empty PROM or a GetTimestamp without
+ *         TicksPerUs, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_RTOS_Sensor_Init(MS5611_RTOS_TypeDef *ctx){
+	struct promData prom;
+
+	if (MS5611_Timestamp_Init(ctx->hw) != MS5611_STATE_READY)
+		return MS5611_STATE_FAILED;
+
+	if (MS5611_RTOS_Reset(ctx) != MS5611_STATE_READY)
+		return MS5611_HAL_ERROR;
+	if (MS5611_RTOS_PROM_Read(ctx, &prom) != MS5611_STATE_READY)
+		return MS5611_HAL_ERROR;
+
+	return MS5611_Set_Prom(ctx->hw, &prom);
+}
+
+/**
+ * @brief  Sensor task body, pass to osThreadNew with the context as argument
+ * @note   Initializes the sensor with MS5611_RTOS_Sensor_Init first, retrying every
+ *         MS5611_RTOS_INIT_RETRY_MS until it succeeds
+ * @param  argument Pointer to MS5611_RTOS_TypeDef structure
+ * @retval None
+ */
+void MS5611_RTOS_Task(void *argument){
+	MS5611_RTOS_TypeDef *ctx = (MS5611_RTOS_TypeDef *) argument;
+	MS5611_Raw_Data_TypeDef raw = {0, 0};
+	MS5611_Converted_Data_TypeDef value;
+	uint8_t remaining = 0;
+
+	while (MS5611_RTOS_Sensor_Init(ctx) != MS5611_STATE_READY)
+		MS5611_RTOS_Delay_Us(MS5611_RTOS_INIT_RETRY_MS * 1000U);
+
+	for (;;) {
+		if (remaining == 0) {
+			if (MS5611_RTOS_Measure(ctx, CONVERT_D2_COMMAND, ctx->osr, &raw.temperature) != MS5611_STATE_READY) {
+				osDelay(1);
+				continue;
+			}
+			remaining = ctx->temperature_decimation ? ctx->temperature_decimation : 1;
+		}
+
+		if (MS5611_RTOS_Measure(ctx, CONVERT_D1_COMMAND, ctx->osr, &raw.pressure) != MS5611_STATE_READY) {
+			remaining = 0;
+			osDelay(1);
+			continue;
+		}
+#if MS5611_CONFIG_STATS
+		MS5611_Timing_Update(ctx->hw);
+#endif
+		remaining--;
+
+		MS5611_Instance_Data_Convert(ctx->hw, &raw, &value);
+		if (ctx->on_sample != NULL)
+			ctx->on_sample(ctx->context, &raw, &value);
+	}
+}
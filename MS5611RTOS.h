@@ -0,0 +1,142 @@
+/* ============================================================================================
+ * MS5611RTOS.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611RTOS_H_
+#define _MS5611RTOS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "MS5611SPI.h"
+#include "cmsis_os2.h"
+
+// --- Thread Flags used by the adaptation layer ---
+#define MS5611_RTOS_FLAG_SPI_DONE     0x00000100U  /**< SPI transfer completed */
+#define MS5611_RTOS_FLAG_SPI_ERROR    0x00000200U  /**< SPI transfer failed */
+
+// --- Sensor Task Configuration ---
+#define MS5611_RTOS_INIT_RETRY_MS     100U         /**< Wait between failed initializations in the task */
+
+// --- Sample Callback, called from the sensor task ---
+typedef void (*MS5611_RTOS_SampleFnTypeDef)(void *context, const MS5611_Raw_Data_TypeDef *raw, const MS5611_Converted_Data_TypeDef *value);
+
+// --- RTOS Adaptation Context ---
+typedef struct {
+  MS5611_HW_InitTypeDef *hw;               /**< Sensor handle */
+  osMutexId_t bus_mutex;                   /**< Bus mutex, NULL when the SPI bus is not shared */
+  uint32_t timeout_ms;                     /**< Wait limit for one SPI transfer */
+  uint8_t osr;                             /**< OSR used by the sensor task */
+  uint8_t temperature_decimation;          /**< Pressure samples per temperature conversion in the task */
+  MS5611_RTOS_SampleFnTypeDef on_sample;   /**< Sample callback of the sensor task */
+  void *context;                           /**< Sample callback context */
+
+  // Driver-managed state, do not set
+  osThreadId_t waiter;                     /**< Task blocked on the current transfer */
+  uint8_t tx[4];                           /**< Transfer buffers, must stay valid during IT */
+  uint8_t rx[4];
+} MS5611_RTOS_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Initializes the RTOS adaptation context
+ * @param  ctx Pointer to context
+ * @param  MS5611_Handler Pointer to hardware initialization structure, already passed to MS5611_Init
+ * @param  bus_mutex Bus mutex, or NULL when the sensor is alone on its SPI bus
+ */
+void MS5611_RTOS_Init(MS5611_RTOS_TypeDef *ctx, MS5611_HW_InitTypeDef *, osMutexId_t bus_mutex);
+
+/**
+ * @brief  Completion hook, call from HAL_SPI_TxRxCpltCallback
+ * @param  ctx Pointer to context
+ * @param  hspi SPI handle passed to the HAL callback
+ */
+void MS5611_RTOS_SPI_Complete(MS5611_RTOS_TypeDef *ctx, SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief  Error hook, call from HAL_SPI_ErrorCallback
+ * @param  ctx Pointer to context
+ * @param  hspi SPI handle passed to the HAL callback
+ */
+void MS5611_RTOS_SPI_Error(MS5611_RTOS_TypeDef *ctx, SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief  Starts a conversion, sleeping on a thread flag while the command is sent
+ * @param  ctx Pointer to context
+ * @param  command CONVERT_D1_COMMAND or CONVERT_D2_COMMAND
+ * @param  osr MS5611_OSR_* value
+ * @retval MS5611StateTypeDef BUSY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_Start_Conversion(MS5611_RTOS_TypeDef *ctx, uint8_t command, uint8_t osr);
+
+/**
+ * @brief  Reads the ADC result, sleeping on a thread flag during the transfer
+ * @param  ctx Pointer to context
+ * @param  raw_data Pointer to store 24-bit raw ADC result
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_ADC_Read(MS5611_RTOS_TypeDef *ctx, uint32_t *raw_data);
+
+/**
+ * @brief  Converts and reads one channel, sleeping through the conversion time
+ * @param  ctx Pointer to context
+ * @param  command CONVERT_D1_COMMAND or CONVERT_D2_COMMAND
+ * @param  osr MS5611_OSR_* value
+ * @param  raw_data Pointer to store 24-bit raw ADC result
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_Measure(MS5611_RTOS_TypeDef *ctx, uint8_t command, uint8_t osr, uint32_t *raw_data);
+
+/**
+ * @brief  Resets the sensor and sleeps through the PROM reload
+ * @param  ctx Pointer to context
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_Reset(MS5611_RTOS_TypeDef *ctx);
+
+/**
+ * @brief  Reads the PROM, sleeping on a thread flag during each transfer
+ * @param  ctx Pointer to context
+ * @param  prom Pointer to PROM data structure
+ * @retval MS5611StateTypeDef READY on success, HAL_ERROR on bus error or timeout
+ */
+MS5611StateTypeDef MS5611_RTOS_PROM_Read(MS5611_RTOS_TypeDef *ctx, struct promData *prom);
+
+/**
+ * @brief  Task-context replacement for MS5611_Init, no HAL_Delay and no polled SPI
+ * @param  ctx Pointer to context
+ * @retval MS5611StateTypeDef READY, FAILED for an empty PROM or a GetTimestamp without
+ *         TicksPerUs, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_RTOS_Sensor_Init(MS5611_RTOS_TypeDef *ctx);
+
+/**
+ * @brief  Sensor task body, pass to osThreadNew with the context as argument
+ * @note   Initializes the sensor, then runs forever, calling on_sample for every pressure sample
+ *         and, with MS5611_CONFIG_STATS, recording each D1 read in the handle's Timing
+ * @param  argument Pointer to MS5611_RTOS_TypeDef context
+ */
+void MS5611_RTOS_Task(void *argument);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611RTOS_H_ */
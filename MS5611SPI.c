@@ -26,8 +26,62 @@
 
 #include <MS5611SPI.h>
 
-/* Private PROM data structure */
+/* Compensation used by the convert functions; the 32-bit path suits cores without a 64-bit multiply */
+#if defined(MS5611_USE_INT32_COMPENSATION)
+#define MS5611_COMPENSATE(prom, cal, sample, value)   MS5611_Compensate_Int32(prom, sample, value)
+#else
+#define MS5611_COMPENSATE(prom, cal, sample, value)   MS5611_Compensate_Cached(cal, sample, value)
+#endif
+
+/* Private PROM data structure and its prepared calibration */
 static struct promData promData;
+static MS5611_Calibration_TypeDef calData;
+
+/* Calibration used for a handle: its own copy, or the shared one in single-instance builds */
+#if MS5611_CONFIG_MULTI_INSTANCE
+#define MS5611_HANDLE_PROM(handle)    (&(handle)->Prom)
+#define MS5611_HANDLE_CAL(handle)     (&(handle)->Cal)
+#else
+#define MS5611_HANDLE_PROM(handle)    ((void) (handle), &promData)
+#define MS5611_HANDLE_CAL(handle)     ((void) (handle), &calData)
+#endif
+
+/* PROM read commands: command and two clock bytes per word, one blocking transfer each */
+static const uint8_t MS5611PromCommands[8][3] = {
+	{PROM_READ(0), 0, 0}, {PROM_READ(1), 0, 0}, {PROM_READ(2), 0, 0}, {PROM_READ(3), 0, 0},
+	{PROM_READ(4), 0, 0}, {PROM_READ(5), 0, 0}, {PROM_READ(6), 0, 0}, {PROM_READ(7), 0, 0}
+};
+
+#if MS5611_CONFIG_STATS
+/**
+ * @brief  Records one pressure read in the handle's latency and jitter statistics
+ * @note   Internal: called by MS5611_ADC_Read() and by the RTOS task after each D1 read
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @retval None
+ */
+void MS5611_Timing_Update(MS5611_HW_InitTypeDef *MS5611_Handler){
+	MS5611_Timing_Stats_TypeDef *timing = &MS5611_Handler->Timing;
+	uint32_t latency = MS5611_Handler->Stamp.adc_read - MS5611_Handler->Stamp.conversion_start;
+
+	if (timing->samples == 0 || latency < timing->latency_min)
+		timing->latency_min = latency;
+	if (latency > timing->latency_max)
+		timing->latency_max = latency;
+	timing->latency_sum += latency;
+
+	if (timing->samples > 0) {
+		uint32_t interval = MS5611_Handler->Stamp.adc_read - timing->last_read;
+
+		if (timing->samples == 1 || interval < timing->interval_min)
+			timing->interval_min = interval;
+		if (interval > timing->interval_max)
+			timing->interval_max = interval;
+	}
+
+	timing->last_read = MS5611_Handler->Stamp.adc_read;
+	timing->samples++;
+}
+#endif
 
 /**
  * @brief  Initializes the MS5611 sensor and reads PROM calibration values
@@ -38,6 +92,10 @@ static struct promData promData;
 MS5611StateTypeDef MS5611_Init(MS5611_HW_InitTypeDef *MS5611_Handler) {
 
 	uint8_t SPITransmitData;
+	struct promData prom;
+
+	if (MS5611_Timestamp_Init(MS5611_Handler) != MS5611_STATE_READY)
+		return MS5611_STATE_FAILED;
 
 	enableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 	SPITransmitData = RESET_COMMAND;
@@ -51,7 +109,52 @@ MS5611StateTypeDef MS5611_Init(MS5611_HW_InitTypeDef *MS5611_Handler) {
 	HAL_Delay(3);
 	disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 
-	MS5611PromRead(MS5611_Handler, &promData);
+	if (MS5611PromRead(MS5611_Handler, &prom) != MS5611_STATE_READY)
+		return MS5611_HAL_ERROR;
+
+	return MS5611_Set_Prom(MS5611_Handler, &prom);
+}
+
+/**
+ * @brief  Enables the handle's timestamp source and clears its statistics
+ * @note   Part of MS5611_Init, for initialization paths that reset the sensor themselves.
+ *         A caller-supplied GetTimestamp needs its TicksPerUs; with 0 every conversion
+ *         wait would end at once, so the handle is rejected.
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @retval MS5611StateTypeDef READY, FAILED when GetTimestamp is set and TicksPerUs is 0
+ */
+MS5611StateTypeDef MS5611_Timestamp_Init(MS5611_HW_InitTypeDef *MS5611_Handler){
+	if (MS5611_Handler->GetTimestamp == NULL) {
+#if defined(DWT)
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+		MS5611_Handler->TicksPerUs = SystemCoreClock / 1000000U;
+	} else if (MS5611_Handler->TicksPerUs == 0) {
+		return MS5611_STATE_FAILED;
+	}
+#if MS5611_CONFIG_STATS
+	MS5611_Timing_Reset(MS5611_Handler);
+#endif
+	return MS5611_STATE_READY;
+}
+
+/**
+ * @brief  Installs PROM calibration words read outside MS5611_Init
+ * @note   Prepares the compensation constants exactly as MS5611_Init does
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @param  prom Pointer to the promData structure read from the sensor
+ * @retval MS5611StateTypeDef READY, or FAILED for an empty or unreadable PROM
+ */
+MS5611StateTypeDef MS5611_Set_Prom(MS5611_HW_InitTypeDef *MS5611_Handler, const struct promData *prom){
+	promData = *prom;
+	MS5611_Calibration_Prepare(&promData, &calData);
+#if MS5611_CONFIG_MULTI_INSTANCE
+	MS5611_Handler->Prom = promData;
+	MS5611_Handler->Cal = calData;
+#else
+	(void) MS5611_Handler;
+#endif
 
 	if (promData.off == 0x00 || promData.tref == 0xff)
 		return MS5611_STATE_FAILED;
@@ -61,49 +164,43 @@ MS5611StateTypeDef MS5611_Init(MS5611_HW_InitTypeDef *MS5611_Handler) {
 
 /**
  * @brief  Reads calibration coefficients from PROM
+ * @note   Blocking: eight CS-framed 3-byte transfers from a constant command table, each
+ *         reply unpacked from big-endian straight into the native word. MS5611_Queue_PROM_Read
+ *         is the interrupt- or DMA-driven form
  * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
  * @param  prom Pointer to the promData structure to store calibration values
  * @retval MS5611StateTypeDef Current state of the sensor
  */
 MS5611StateTypeDef MS5611PromRead(MS5611_HW_InitTypeDef *MS5611_Handler, struct promData *prom){
-	uint8_t   address;
-	uint16_t  *structPointer;
-	uint8_t SPITransmitData;
-
-	structPointer = (uint16_t *) prom;
+	uint16_t *words = (uint16_t *) prom;
+	uint8_t reply[3];
+	uint8_t address;
 
 	for (address = 0; address < 8; address++) {
-		SPITransmitData = PROM_READ(address);
 		enableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 
-		if(HAL_SPI_Transmit(MS5611_Handler->SPIhandler, &SPITransmitData, 1, 10) != HAL_OK)
-		{
-			disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
-			return MS5611_HAL_ERROR;
-		}
-
-		if(HAL_SPI_Receive(MS5611_Handler->SPIhandler, structPointer, 2, 10) != HAL_OK)
+		if(HAL_SPI_TransmitReceive(MS5611_Handler->SPIhandler, MS5611PromCommands[address], reply, 3, 10) != HAL_OK)
 		{
 			disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 			return MS5611_HAL_ERROR;
 		}
 
 		disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
-		structPointer++;
-	}
-
-	structPointer = (uint16_t *) prom;
-	for (address = 0; address < 8; address++) {
-		uint8_t   *toSwap = (uint8_t *) structPointer;
-		uint8_t secondByte = toSwap[0];
-		toSwap[0] = toSwap[1];
-		toSwap[1] = secondByte;
-		structPointer++;
+		words[address] = (uint16_t) (((uint16_t) reply[1] << 8) | reply[2]);
 	}
 
 	return MS5611_STATE_READY;
 }
 
+/**
+ * @brief  Copies the PROM calibration words read by MS5611_Init
+ * @param  prom Pointer to the promData structure to fill
+ * @retval None
+ */
+void MS5611_Get_Prom(struct promData *prom){
+	*prom = promData;
+}
+
 /**
  * @brief  Initiates an uncompensated pressure (D1) conversion
  * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
@@ -121,6 +218,8 @@ MS5611StateTypeDef MS5611_Pressure_Conversion(MS5611_HW_InitTypeDef *MS5611_Hand
 		disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 		return MS5611_HAL_ERROR;
 	}
+	MS5611_Handler->Stamp.conversion_start = MS5611_Get_Timestamp(MS5611_Handler);
+	MS5611_Handler->ConversionCommand = SPITransmitData;
 	disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 
 	return MS5611_STATE_BUSY;
@@ -144,6 +243,8 @@ MS5611StateTypeDef MS5611_Temperature_Conversion(MS5611_HW_InitTypeDef *MS5611_H
 		return MS5611_HAL_ERROR;
 	}
 
+	MS5611_Handler->Stamp.conversion_start = MS5611_Get_Timestamp(MS5611_Handler);
+	MS5611_Handler->ConversionCommand = SPITransmitData;
   	disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 
   	return MS5611_STATE_BUSY;
@@ -174,13 +275,71 @@ MS5611StateTypeDef MS5611_ADC_Read(MS5611_HW_InitTypeDef *MS5611_Handler, uint32
 		return MS5611_HAL_ERROR;
 	}
 
+	MS5611_Handler->Stamp.adc_read = MS5611_Get_Timestamp(MS5611_Handler);
 	disableCS_MS5611(MS5611_Handler->CS_GPIOport, MS5611_Handler->CS_GPIOpin);
 
 	*raw_data = ((uint32_t) reply[0] << 16) | ((uint32_t) reply[1] << 8) | (uint32_t) reply[2];
 
+#if MS5611_CONFIG_STATS
+	if ((MS5611_Handler->ConversionCommand & 0xF0) == CONVERT_D1_COMMAND)
+		MS5611_Timing_Update(MS5611_Handler);
+#endif
+
 	return MS5611_STATE_READY;
 }
 
+/**
+ * @brief  Reads the ADC result together with its conversion timestamps
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @param  raw_data Pointer to store the 24-bit raw ADC value
+ * @param  stamp Pointer to store conversion start and read timestamps
+ * @retval MS5611StateTypeDef Current state of the sensor (READY or ERROR)
+ */
+MS5611StateTypeDef MS5611_ADC_Read_Stamped(MS5611_HW_InitTypeDef *MS5611_Handler, uint32_t *raw_data, MS5611_Timestamp_TypeDef *stamp){
+	MS5611StateTypeDef state = MS5611_ADC_Read(MS5611_Handler, raw_data);
+
+	if (state == MS5611_STATE_READY)
+		*stamp = MS5611_Handler->Stamp;
+
+	return state;
+}
+
+/**
+ * @brief  Returns the current timestamp of the handle's tick source
+ * @note   Uses GetTimestamp when set, otherwise the DWT cycle counter
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @retval uint32_t Current tick count
+ */
+uint32_t MS5611_Get_Timestamp(MS5611_HW_InitTypeDef *MS5611_Handler){
+	if (MS5611_Handler->GetTimestamp != NULL)
+		return MS5611_Handler->GetTimestamp();
+
+#if defined(DWT)
+	return DWT->CYCCNT;
+#else
+	return HAL_GetTick() * 1000U * MS5611_Handler->TicksPerUs;
+#endif
+}
+
+#if MS5611_CONFIG_STATS
+/**
+ * @brief  Clears the latency and jitter statistics
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @retval None
+ */
+void MS5611_Timing_Reset(MS5611_HW_InitTypeDef *MS5611_Handler){
+	MS5611_Timing_Stats_TypeDef *timing = &MS5611_Handler->Timing;
+
+	timing->samples = 0;
+	timing->latency_min = 0;
+	timing->latency_max = 0;
+	timing->latency_sum = 0;
+	timing->interval_min = 0;
+	timing->interval_max = 0;
+	timing->last_read = 0;
+}
+#endif
+
 
 /**
  * @brief  Converts raw ADC data to compensated pressure and temperature
@@ -189,39 +348,505 @@ MS5611StateTypeDef MS5611_ADC_Read(MS5611_HW_InitTypeDef *MS5611_Handler, uint32
  * @retval None
  */
 void MS5611_Data_Convert(MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value){
-	int32_t dT;
-	int32_t TEMP;
-	int64_t OFF;
-	int64_t SENS;
+	MS5611_COMPENSATE(&promData, &calData, sample, value);
+}
+
+/**
+ * @brief  Converts raw ADC data using the calibration stored in a sensor handle
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @param  sample Pointer to MS5611_Raw_Data_TypeDef structure
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Instance_Data_Convert(MS5611_HW_InitTypeDef *MS5611_Handler, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value){
+	MS5611_COMPENSATE(MS5611_HANDLE_PROM(MS5611_Handler), MS5611_HANDLE_CAL(MS5611_Handler), sample, value);
+}
 
-	dT = sample->temperature - ((int32_t) (promData.tref << 8));
+#if MS5611_CONFIG_FLOAT
+/**
+ * @brief  Converts raw ADC data to Pa and degC in floating point, using a handle's calibration
+ * @param  MS5611_Handler Pointer to the MS5611_HW_InitTypeDef structure
+ * @param  sample Pointer to MS5611_Raw_Data_TypeDef structure
+ * @param  value Pointer to MS5611_Float_Data_TypeDef structure to store results
+ * @retval None
+ */
+void MS5611_Instance_Data_Convert_Float(MS5611_HW_InitTypeDef *MS5611_Handler, const MS5611_Raw_Data_TypeDef *sample, MS5611_Float_Data_TypeDef *value){
+	MS5611_Compensate_Float(MS5611_HANDLE_PROM(MS5611_Handler), sample, value);
+}
+#endif
+
+/**
+ * @brief  Returns the maximum conversion time for an oversampling ratio
+ * @note   Datasheet maximum values, 0.60 ms (OSR 256) to 9.04 ms (OSR 4096)
+ * @param  osr MS5611_OSR_* value
+ * @retval uint32_t Conversion time in microseconds
+ */
+uint32_t MS5611_Conversion_Time_Us(uint8_t osr){
+	static const uint32_t conversionTime[5] = {600, 1170, 2280, 4540, 9040};
 
-	TEMP = 2000 + (((int64_t) dT * promData.tempsens) >> 23);
+	if (osr > MS5611_OSR_4096)
+		osr = MS5611_OSR_4096;
 
-	OFF = ((int64_t) promData.off << 16) + (((int64_t) promData.tco * dT) >> 7);
-	SENS = ((int64_t) promData.sens << 15) + (((int64_t) promData.tcs * dT) >> 8);
+	return conversionTime[osr >> 1];
+}
 
+#if MS5611_CONFIG_ASYNC
+/**
+ * @brief  Initializes an adaptive OSR controller
+ * @note   Starts at MS5611_OSR_4096 and uses MS5611_OSR_256 as the fast setting.
+ *         Both can be changed in the structure after this call.
+ * @param  ctrl Pointer to MS5611_Adaptive_OSR_TypeDef structure
+ * @param  enter_rate |dP/dt| in Pa/s above which the fast OSR is selected
+ * @param  exit_rate Mean |dP/dt| in Pa/s over hold_windows below which the precise OSR returns
+ * @param  hold_windows Calm windows required before returning to the precise OSR
+ * @retval None
+ */
+void MS5611_Adaptive_OSR_Init(MS5611_Adaptive_OSR_TypeDef *ctrl, uint32_t enter_rate, uint32_t exit_rate, uint16_t hold_windows){
+	ctrl->fast_osr = MS5611_OSR_256;
+	ctrl->precise_osr = MS5611_OSR_4096;
+	ctrl->osr = ctrl->precise_osr;
+	ctrl->hint = 0;
+	ctrl->enter_rate = enter_rate;
+	ctrl->exit_rate = exit_rate;
+	ctrl->hold_windows = hold_windows;
+	ctrl->calm_windows = 0;
+	ctrl->window_sum = 0;
+	ctrl->window_count = 0;
+	ctrl->window_mean = 0;
+	ctrl->calm_reference = 0;
+	ctrl->window_elapsed_us = 0;
+	ctrl->calm_elapsed_us = 0;
+	ctrl->rate = 0;
+	ctrl->primed = 0;
+}
 
-	if (TEMP < 2000) {
-		int32_t T2 = ((int64_t) dT * (int64_t) dT) >> 31;
-		int32_t TEMPM = TEMP - 2000;
-		int64_t OFF2 = (5 * (int64_t) TEMPM * (int64_t) TEMPM) >> 1;
-		int64_t SENS2 = (5 * (int64_t) TEMPM * (int64_t) TEMPM) >> 2;
-		if (TEMP < -1500) {
-			int32_t TEMPP = TEMP + 1500;
-			int32_t TEMPP2 = TEMPP * TEMPP;
-			OFF2 = OFF2 + (int64_t) 7 * TEMPP2;
-			SENS2 = SENS2 + (((int64_t) 11 * TEMPP2) >> 1);
+/**
+ * @brief  Sets the external dynamics hint
+ * @param  ctrl Pointer to MS5611_Adaptive_OSR_TypeDef structure
+ * @param  dynamic Non-zero forces the fast OSR until cleared
+ * @retval None
+ */
+void MS5611_Adaptive_OSR_Hint(MS5611_Adaptive_OSR_TypeDef *ctrl, uint8_t dynamic){
+	ctrl->hint = dynamic;
+	if (dynamic) {
+		ctrl->osr = ctrl->fast_osr;
+		ctrl->calm_windows = 0;
+	}
+}
+
+/**
+ * @brief  Feeds one compensated pressure sample into the controller
+ * @note   The derivative is the difference of consecutive window means, evaluated once
+ *         per MS5611_ADAPTIVE_WINDOW_US so the decision rate does not depend on OSR.
+ *         Hysteresis: enter above enter_rate at once; leave after hold_windows windows
+ *         without entry when the mean rate over all of them is below exit_rate. The long
+ *         baseline averages out the fast OSR's own noise, which alone exceeds exit_rate
+ *         over a single window.
+ * @param  ctrl Pointer to MS5611_Adaptive_OSR_TypeDef structure
+ * @param  pressure Compensated pressure in Pa
+ * @param  dt_us Time since the previous sample in microseconds
+ * @retval uint8_t OSR to use for the next conversion pair
+ */
+uint8_t MS5611_Adaptive_OSR_Update(MS5611_Adaptive_OSR_TypeDef *ctrl, int32_t pressure, uint32_t dt_us){
+	int32_t mean;
+	uint32_t delta;
+
+	if (!ctrl->primed) {
+		ctrl->window_mean = pressure * 16;
+		ctrl->calm_reference = ctrl->window_mean;
+		ctrl->window_sum = 0;
+		ctrl->window_count = 0;
+		ctrl->window_elapsed_us = 0;
+		ctrl->calm_elapsed_us = 0;
+		ctrl->primed = 1;
+		return ctrl->osr;
+	}
+
+	ctrl->window_sum += pressure;
+	ctrl->window_count++;
+	ctrl->window_elapsed_us += dt_us;
+
+	if (ctrl->window_elapsed_us >= MS5611_ADAPTIVE_WINDOW_US) {
+		mean = ctrl->window_sum * 16 / ctrl->window_count;
+		delta = (mean > ctrl->window_mean) ? (uint32_t) (mean - ctrl->window_mean) : (uint32_t) (ctrl->window_mean - mean);
+		ctrl->rate = (uint32_t) (((uint64_t) delta * 1000000U) / (16U * (uint64_t) ctrl->window_elapsed_us));
+		ctrl->window_mean = mean;
+		ctrl->calm_elapsed_us += ctrl->window_elapsed_us;
+		ctrl->window_sum = 0;
+		ctrl->window_count = 0;
+		ctrl->window_elapsed_us = 0;
+
+		if (ctrl->rate >= ctrl->enter_rate) {
+			ctrl->osr = ctrl->fast_osr;
+			ctrl->calm_windows = 0;
+			ctrl->calm_reference = mean;
+			ctrl->calm_elapsed_us = 0;
+		} else if (++ctrl->calm_windows >= ctrl->hold_windows) {
+			delta = (mean > ctrl->calm_reference) ? (uint32_t) (mean - ctrl->calm_reference) : (uint32_t) (ctrl->calm_reference - mean);
+			if ((uint64_t) delta * 1000000U <= (uint64_t) ctrl->exit_rate * 16U * ctrl->calm_elapsed_us)
+				ctrl->osr = ctrl->precise_osr;
+			ctrl->calm_windows = 0;
+			ctrl->calm_reference = mean;
+			ctrl->calm_elapsed_us = 0;
+		}
+	}
+
+	if (ctrl->hint) {
+		ctrl->osr = ctrl->fast_osr;
+		ctrl->calm_windows = 0;
+	}
+
+	return ctrl->osr;
+}
+
+/**
+ * @brief  Arms a recovery wait of the acquisition engine
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @param  state MS5611_ACQ_RECOVER_RESET or MS5611_ACQ_RECOVER_BACKOFF
+ * @param  wait_us Wait length in microseconds
+ * @retval None
+ */
+static void MS5611_Recovery_Wait(MS5611_Acquisition_TypeDef *acq, MS5611AcqStateTypeDef state, uint32_t wait_us){
+	acq->state = state;
+	acq->wait_start = MS5611_Get_Timestamp(acq->hw);
+	acq->wait_us = wait_us;
+}
+
+/**
+ * @brief  Schedules the next recovery attempt with exponential backoff
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @retval None
+ */
+static void MS5611_Recovery_Backoff(MS5611_Acquisition_TypeDef *acq){
+	uint32_t backoff = MS5611_RECOVERY_BACKOFF_US << acq->recovery_attempts;
+
+	if (backoff > MS5611_RECOVERY_BACKOFF_MAX_US)
+		backoff = MS5611_RECOVERY_BACKOFF_MAX_US;
+	else
+		acq->recovery_attempts++;
+
+	MS5611_Recovery_Wait(acq, MS5611_ACQ_RECOVER_BACKOFF, backoff);
+}
+
+/**
+ * @brief  Aborts and re-initializes the SPI peripheral, then resets the sensor
+ * @note   Does not wait for the reset; the engine polls MS5611_RESET_TIME_US
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @retval None
+ */
+static void MS5611_Recovery_Reset(MS5611_Acquisition_TypeDef *acq){
+	MS5611_HW_InitTypeDef *hw = acq->hw;
+	uint8_t SPITransmitData = RESET_COMMAND;
+	HAL_StatusTypeDef status;
+
+	disableCS_MS5611(hw->CS_GPIOport, hw->CS_GPIOpin);
+	HAL_SPI_Abort(hw->SPIhandler);
+	HAL_SPI_DeInit(hw->SPIhandler);
+
+	if (HAL_SPI_Init(hw->SPIhandler) != HAL_OK) {
+		MS5611_Recovery_Backoff(acq);
+		return;
+	}
+
+	enableCS_MS5611(hw->CS_GPIOport, hw->CS_GPIOpin);
+	status = HAL_SPI_Transmit(hw->SPIhandler, &SPITransmitData, 1, 10);
+	disableCS_MS5611(hw->CS_GPIOport, hw->CS_GPIOpin);
+
+	if (status != HAL_OK)
+		MS5611_Recovery_Backoff(acq);
+	else
+		MS5611_Recovery_Wait(acq, MS5611_ACQ_RECOVER_RESET, MS5611_RESET_TIME_US);
+}
+
+/**
+ * @brief  Re-reads the PROM after a recovery reset and checks it against the cache
+ * @note   Falls back to the PROM CRC when no calibration was cached
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @retval MS5611StateTypeDef READY when the sensor is back, FAILED otherwise
+ */
+static MS5611StateTypeDef MS5611_Recovery_Verify(MS5611_Acquisition_TypeDef *acq){
+	struct promData prom;
+	const uint16_t *fresh = (const uint16_t *) &prom;
+	const uint16_t *cached = (const uint16_t *) MS5611_HANDLE_PROM(acq->hw);
+	uint8_t i;
+
+	if (MS5611PromRead(acq->hw, &prom) != MS5611_STATE_READY)
+		return MS5611_STATE_FAILED;
+
+	if (MS5611_HANDLE_PROM(acq->hw)->off == 0x00)
+		return (MS5611_Prom_CRC4(&prom) == (prom.crc & 0x000F)) ? MS5611_STATE_READY : MS5611_STATE_FAILED;
+
+	for (i = 0; i < 8; i++)
+		if (fresh[i] != cached[i])
+			return MS5611_STATE_FAILED;
+
+	return MS5611_STATE_READY;
+}
+
+/**
+ * @brief  Accounts a bus error and starts recovery once the threshold is reached
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @retval MS5611StateTypeDef Always HAL_ERROR
+ */
+static MS5611StateTypeDef MS5611_Acquisition_Fault(MS5611_Acquisition_TypeDef *acq){
+	acq->state = MS5611_ACQ_IDLE;
+	acq->d1_remaining = 0;
+	acq->errors++;
+
+	/* The failed attempt consumes a sequence number, so consumers see the loss as a gap */
+	acq->sequence++;
+
+	if (acq->consecutive_errors < 0xFF)
+		acq->consecutive_errors++;
+
+	if (acq->self_healing && acq->consecutive_errors >= acq->error_threshold) {
+		acq->recovery_start = MS5611_Get_Timestamp(acq->hw);
+		acq->recovery_attempts = 0;
+		MS5611_Recovery_Reset(acq);
+	}
+
+	return MS5611_HAL_ERROR;
+}
+
+/**
+ * @brief  Starts the next conversion of the acquisition engine
+ * @note   A new OSR is only taken between pressure samples and always forces a
+ *         fresh temperature conversion, so D1 and D2 of a pair never straddle a switch
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @retval MS5611StateTypeDef BUSY on success, HAL_ERROR on bus error
+ */
+static MS5611StateTypeDef MS5611_Acquisition_Start(MS5611_Acquisition_TypeDef *acq){
+	MS5611StateTypeDef state;
+	uint8_t nextOSR = (acq->adaptive != NULL) ? acq->adaptive->osr : acq->osr;
+
+	if (nextOSR != acq->active_osr) {
+		acq->active_osr = nextOSR;
+		acq->d1_remaining = 0;
+	}
+
+	if (acq->d1_remaining == 0) {
+		state = MS5611_Temperature_Conversion(acq->hw, acq->active_osr);
+		acq->state = MS5611_ACQ_CONVERTING_D2;
+	} else {
+		state = MS5611_Pressure_Conversion(acq->hw, acq->active_osr);
+		acq->state = MS5611_ACQ_CONVERTING_D1;
+	}
+
+	if (state != MS5611_STATE_BUSY)
+		return MS5611_Acquisition_Fault(acq);
+
+	return MS5611_STATE_BUSY;
+}
+
+/**
+ * @brief  Initializes the non-blocking acquisition engine
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @param  MS5611_Handler Pointer to the initialized MS5611_HW_InitTypeDef structure
+ * @param  osr Fixed OSR, ignored when adaptive is not NULL
+ * @param  temperature_decimation Pressure samples per temperature conversion (1 = every sample)
+ * @param  adaptive Optional adaptive OSR controller, may be NULL
+ * @retval None
+ */
+void MS5611_Acquisition_Init(MS5611_Acquisition_TypeDef *acq, MS5611_HW_InitTypeDef *MS5611_Handler, uint8_t osr, uint8_t temperature_decimation, MS5611_Adaptive_OSR_TypeDef *adaptive){
+	acq->hw = MS5611_Handler;
+	acq->adaptive = adaptive;
+	acq->osr = osr;
+	acq->temperature_decimation = (temperature_decimation == 0) ? 1 : temperature_decimation;
+	acq->state = MS5611_ACQ_IDLE;
+	acq->active_osr = (adaptive != NULL) ? adaptive->osr : osr;
+	acq->d1_remaining = 0;
+	acq->last_pressure_read = 0;
+	acq->last_temperature_read = 0;
+	acq->sequence = 0;
+	acq->last_osr = acq->active_osr;
+	acq->pending_flags = 0;
+#if MS5611_CONFIG_FILTER
+	acq->glitch_d1 = NULL;
+	acq->glitch_d2 = NULL;
+#endif
+#if MS5611_CONFIG_THERMAL
+	acq->thermal = NULL;
+#endif
+#if MS5611_CONFIG_HUB
+	acq->hub = NULL;
+#endif
+	acq->raw.pressure = 0;
+	acq->raw.temperature = 0;
+	acq->self_healing = 0;
+	acq->error_threshold = MS5611_RECOVERY_THRESHOLD;
+	acq->consecutive_errors = 0;
+	acq->recovery_attempts = 0;
+	acq->wait_start = 0;
+	acq->wait_us = 0;
+	acq->recovery_start = 0;
+	acq->errors = 0;
+	acq->recoveries = 0;
+	acq->last_recovery_ticks = 0;
+}
+
+/**
+ * @brief  Flags a raw word that sits on an ADC rail
+ * @param  raw_data Raw ADC word
+ * @retval uint8_t Non-zero for 0 or full scale
+ */
+static uint8_t MS5611_Raw_On_Rail(uint32_t raw_data){
+	return raw_data == 0 || raw_data >= MS5611_ADC_MAX;
+}
+
+/**
+ * @brief  Advances the acquisition engine, never waits for a conversion
+ * @note   Call periodically (main loop or timer). Each call either starts a
+ *         conversion, finds the current one still running, or reads it.
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @param  value Pointer to MS5611_Converted_Data_TypeDef structure to store a new sample
+ * @retval MS5611StateTypeDef READY when value was written, BUSY otherwise, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_Acquisition_Process(MS5611_Acquisition_TypeDef *acq, MS5611_Converted_Data_TypeDef *value){
+	MS5611_Sample_TypeDef sample;
+	MS5611StateTypeDef state = MS5611_Acquisition_Process_Sample(acq, &sample);
+
+	if (state == MS5611_STATE_READY)
+		*value = sample.value;
+
+	return state;
+}
+
+/**
+ * @brief  Advances the acquisition engine and returns new samples as extended records
+ * @note   Same scheduling as MS5611_Acquisition_Process. Rail words and results outside
+ *         the sensor range are delivered with MS5611_SAMPLE_INVALID set, not suppressed.
+ *         Every returned sample is also published to acq->hub when it is set.
+ * @param  acq Pointer to MS5611_Acquisition_TypeDef structure
+ * @param  sample Pointer to MS5611_Sample_TypeDef structure to store a new sample
+ * @retval MS5611StateTypeDef READY when sample was written, BUSY otherwise, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_Acquisition_Process_Sample(MS5611_Acquisition_TypeDef *acq, MS5611_Sample_TypeDef *sample){
+	MS5611_HW_InitTypeDef *hw = acq->hw;
+	const MS5611_Raw_Data_TypeDef *raw = &acq->raw;
+	uint8_t flags;
+	uint32_t elapsed;
+	uint32_t dt;
+#if MS5611_CONFIG_THERMAL
+	MS5611_Raw_Data_TypeDef effective;
+#endif
+
+	if (acq->state == MS5611_ACQ_IDLE)
+		return MS5611_Acquisition_Start(acq);
+
+	if (acq->state == MS5611_ACQ_RECOVER_RESET || acq->state == MS5611_ACQ_RECOVER_BACKOFF) {
+		elapsed = MS5611_Get_Timestamp(hw) - acq->wait_start;
+		if (elapsed < acq->wait_us * hw->TicksPerUs)
+			return MS5611_STATE_BUSY;
+
+		if (acq->state == MS5611_ACQ_RECOVER_BACKOFF) {
+			MS5611_Recovery_Reset(acq);
+			return MS5611_STATE_BUSY;
+		}
+
+		if (MS5611_Recovery_Verify(acq) != MS5611_STATE_READY) {
+			MS5611_Recovery_Backoff(acq);
+			return MS5611_STATE_BUSY;
 		}
-		TEMP -= T2;
-		OFF -= OFF2;
-		SENS -= SENS2;
+
+		acq->pending_flags |= MS5611_SAMPLE_RECOVERED | MS5611_SAMPLE_RETRIED;
+		acq->consecutive_errors = 0;
+		acq->recoveries++;
+		acq->last_recovery_ticks = MS5611_Get_Timestamp(hw) - acq->recovery_start;
+		acq->state = MS5611_ACQ_IDLE;
+		return MS5611_Acquisition_Start(acq);
 	}
 
-	value->pressure = ((((int64_t) sample->pressure * SENS) >> 21) - OFF) >> 15;
-	value->temperature = TEMP;
+	elapsed = MS5611_Get_Timestamp(hw) - hw->Stamp.conversion_start;
+	if (elapsed < MS5611_Conversion_Time_Us(acq->active_osr) * hw->TicksPerUs)
+		return MS5611_STATE_BUSY;
+
+	if (acq->state == MS5611_ACQ_CONVERTING_D2) {
+		if (MS5611_ADC_Read(hw, &acq->raw.temperature) != MS5611_STATE_READY)
+			return MS5611_Acquisition_Fault(acq);
+		acq->last_temperature_read = hw->Stamp.adc_read;
+		acq->pending_flags &= (uint8_t) ~(MS5611_SAMPLE_D2_RAIL | MS5611_SAMPLE_GLITCH);
+		if (MS5611_Raw_On_Rail(acq->raw.temperature))
+			acq->pending_flags |= MS5611_SAMPLE_D2_RAIL;
+#if MS5611_CONFIG_FILTER
+		if (acq->glitch_d2 != NULL && (MS5611_Glitch_Filter_Apply(acq->glitch_d2, &acq->raw.temperature) &
+		                               (MS5611_QUALITY_OUTLIER | MS5611_QUALITY_REPLACED)))
+			acq->pending_flags |= MS5611_SAMPLE_GLITCH;
+#endif
+#if MS5611_CONFIG_THERMAL
+		if (acq->thermal != NULL && !(acq->pending_flags & MS5611_SAMPLE_D2_RAIL))
+			MS5611_Thermal_Update(acq->thermal, acq->raw.temperature, acq->last_temperature_read);
+#endif
+		acq->d1_remaining = acq->temperature_decimation;
+		if (MS5611_Pressure_Conversion(hw, acq->active_osr) != MS5611_STATE_BUSY)
+			return MS5611_Acquisition_Fault(acq);
+		acq->state = MS5611_ACQ_CONVERTING_D1;
+		return MS5611_STATE_BUSY;
+	}
 
+	if (MS5611_ADC_Read(hw, &acq->raw.pressure) != MS5611_STATE_READY)
+		return MS5611_Acquisition_Fault(acq);
+
+	/* D2 flags stay with the temperature word for every pressure sample it serves */
+	flags = acq->pending_flags;
+	if (acq->d1_remaining != acq->temperature_decimation)
+		flags |= MS5611_SAMPLE_D2_REUSED;
+	if (acq->consecutive_errors != 0)
+		flags |= MS5611_SAMPLE_RETRIED;
+	if (acq->active_osr != acq->last_osr)
+		flags |= MS5611_SAMPLE_OSR_CHANGED;
+	if (MS5611_Raw_On_Rail(acq->raw.pressure))
+		flags |= MS5611_SAMPLE_D1_RAIL;
+#if MS5611_CONFIG_FILTER
+	if (acq->glitch_d1 != NULL && (MS5611_Glitch_Filter_Apply(acq->glitch_d1, &acq->raw.pressure) &
+	                               (MS5611_QUALITY_OUTLIER | MS5611_QUALITY_REPLACED)))
+		flags |= MS5611_SAMPLE_GLITCH;
+#endif
+
+#if MS5611_CONFIG_THERMAL
+	/* Compensate with the predicted membrane temperature; the flags still judge the raw words */
+	if (acq->thermal != NULL && acq->thermal->primed) {
+		effective.pressure = acq->raw.pressure;
+		effective.temperature = MS5611_Thermal_Predict(acq->thermal, hw->Stamp.adc_read);
+		raw = &effective;
+	}
+#endif
+	MS5611_Instance_Data_Convert(hw, raw, &sample->value);
+
+	/* A rail word the glitch filter replaced no longer invalidates the sample */
+	if (MS5611_Raw_On_Rail(acq->raw.pressure) || MS5611_Raw_On_Rail(acq->raw.temperature) ||
+	    sample->value.pressure < MS5611_SAMPLE_PRESSURE_MIN || sample->value.pressure > MS5611_SAMPLE_PRESSURE_MAX ||
+	    sample->value.temperature < MS5611_SAMPLE_TEMPERATURE_MIN || sample->value.temperature > MS5611_SAMPLE_TEMPERATURE_MAX)
+		flags |= MS5611_SAMPLE_INVALID;
+
+	sample->stamp = hw->Stamp.adc_read;
+	sample->d2_age = hw->Stamp.adc_read - acq->last_temperature_read;
+	sample->sequence = acq->sequence++;
+	sample->osr = acq->active_osr;
+	sample->flags = flags;
+	sample->retries = acq->consecutive_errors;
+	sample->reserved = 0;
+#if MS5611_CONFIG_HUB
+	if (acq->hub != NULL)
+		MS5611_Hub_Publish(acq->hub, &acq->raw, sample);
+#endif
+
+	acq->consecutive_errors = 0;
+	acq->last_osr = acq->active_osr;
+	acq->pending_flags &= (uint8_t) (MS5611_SAMPLE_D2_RAIL | MS5611_SAMPLE_GLITCH);
+
+	dt = hw->Stamp.adc_read - acq->last_pressure_read;
+	acq->last_pressure_read = hw->Stamp.adc_read;
+	if (acq->adaptive != NULL && hw->TicksPerUs != 0 && !(flags & MS5611_SAMPLE_INVALID))
+		MS5611_Adaptive_OSR_Update(acq->adaptive, sample->value.pressure, dt / hw->TicksPerUs);
+
+	acq->d1_remaining--;
+
+	acq->state = MS5611_ACQ_IDLE;
+	MS5611_Acquisition_Start(acq);
+
+	return MS5611_STATE_READY;
 }
+#endif /* MS5611_CONFIG_ASYNC */
 
 /**
  * @brief  Enables the chip select pin for the MS5611 sensor
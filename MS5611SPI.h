@@ -32,6 +32,11 @@ extern "C" {
 #endif
 
 #include "stm32h5xx_hal.h"
+#include "MS5611Config.h"
+#include "MS5611Compensate.h"
+#include "MS5611Filter.h"
+#include "MS5611Thermal.h"
+#include "MS5611Hub.h"
 
 // --- MS5611 SPI Commands ---
 #define RESET_COMMAND                 0x1E
@@ -47,6 +52,15 @@ extern "C" {
 #define MS5611_OSR_2048		0x06
 #define MS5611_OSR_4096		0x08
 
+// --- Bus-Fault Recovery ---
+#define MS5611_RESET_TIME_US          3000U    /**< Reset reload time, datasheet 2.8 ms */
+#define MS5611_RECOVERY_BACKOFF_US    1000U    /**< First backoff after a failed recovery */
+#define MS5611_RECOVERY_BACKOFF_MAX_US 64000U  /**< Backoff ceiling */
+#define MS5611_RECOVERY_THRESHOLD     3        /**< Default consecutive errors before recovery */
+
+// --- Adaptive OSR Defaults ---
+#define MS5611_ADAPTIVE_WINDOW_US     50000U  /**< Pressure derivative evaluation window */
+
 // --- MS5611 System States ---
 typedef enum MS5611States{
   MS5611_STATE_FAILED,  /**< Sensor initialization or communication failed */
@@ -55,29 +69,25 @@ typedef enum MS5611States{
   MS5611_HAL_ERROR      /**< HAL communication error */
 }MS5611StateTypeDef;
 
-// --- PROM Data Structure ---
-struct promData{
-  uint16_t reserved;
-  uint16_t sens;
-  uint16_t off;
-  uint16_t tcs;
-  uint16_t tco;
-  uint16_t tref;
-  uint16_t tempsens;
-  uint16_t crc;
-};
-
-// --- Raw Sensor Values ---
-typedef struct MS5611UncompensatedValues{
-  uint32_t pressure;     /**< Uncompensated pressure */
-  uint32_t temperature;  /**< Uncompensated temperature */
-} MS5611_Raw_Data_TypeDef;
-
-// --- Compensated Sensor Values ---
-typedef struct MS5611Readings{
-  int32_t pressure;      /**< Compensated pressure */
-  int32_t temperature;   /**< Compensated temperature */
-} MS5611_Converted_Data_TypeDef;
+// --- Timestamp Source ---
+typedef uint32_t (*MS5611_TimestampFnTypeDef)(void);  /**< Free-running, wrapping tick counter */
+
+// --- Sample Timestamps ---
+typedef struct {
+  uint32_t conversion_start;  /**< Ticks when the conversion command completed */
+  uint32_t adc_read;          /**< Ticks when the ADC result was read */
+} MS5611_Timestamp_TypeDef;
+
+// --- Acquisition Timing Statistics (pressure samples) ---
+typedef struct {
+  uint32_t samples;           /**< Number of D1 reads accounted */
+  uint32_t latency_min;       /**< Minimum conversion start to read latency, ticks */
+  uint32_t latency_max;       /**< Maximum conversion start to read latency, ticks */
+  uint64_t latency_sum;       /**< Sum of latencies, ticks */
+  uint32_t interval_min;      /**< Minimum interval between D1 reads, ticks */
+  uint32_t interval_max;      /**< Maximum interval between D1 reads, ticks */
+  uint32_t last_read;         /**< Timestamp of the previous D1 read */
+} MS5611_Timing_Stats_TypeDef;
 
 // --- Hardware Initialization Structure ---
 typedef struct {
@@ -85,14 +95,97 @@ typedef struct {
 	GPIO_TypeDef *CS_GPIOport;      /**< GPIO port for chip select */
 	uint16_t CS_GPIOpin;            /**< GPIO pin number for chip select */
 	uint8_t SPI_Timeout;            /**< SPI timeout in milliseconds */
+	MS5611_TimestampFnTypeDef GetTimestamp;  /**< Optional tick source, NULL selects DWT->CYCCNT */
+	uint32_t TicksPerUs;            /**< Ticks per microsecond; required (non-zero) with GetTimestamp, set by MS5611_Init for DWT */
+
+	// Driver-managed state, do not set
+	uint8_t ConversionCommand;      /**< Last conversion command issued */
+	MS5611_Timestamp_TypeDef Stamp; /**< Timestamps of the last conversion */
+#if MS5611_CONFIG_STATS
+	MS5611_Timing_Stats_TypeDef Timing;  /**< Latency and jitter statistics */
+#endif
+#if MS5611_CONFIG_MULTI_INSTANCE
+	struct promData Prom;           /**< Calibration of this sensor, read by MS5611_Init */
+	MS5611_Calibration_TypeDef Cal; /**< Prom expanded for the per-sample kernel, set by MS5611_Init */
+#endif
 } MS5611_HW_InitTypeDef;
 
+#if MS5611_CONFIG_ASYNC
+// --- Adaptive OSR Controller ---
+typedef struct {
+  uint8_t osr;                /**< OSR selected for the next conversion pair */
+  uint8_t fast_osr;           /**< OSR used during fast altitude changes */
+  uint8_t precise_osr;        /**< OSR used when static */
+  uint8_t hint;               /**< External dynamics hint, non-zero forces fast_osr */
+  uint32_t enter_rate;        /**< |dP/dt| above which fast_osr is selected, Pa/s */
+  uint32_t exit_rate;         /**< Mean |dP/dt| over hold_windows below which precise_osr returns, Pa/s */
+  uint16_t hold_windows;      /**< Calm windows required to return to precise_osr */
+  uint16_t calm_windows;      /**< Calm windows counted so far */
+  int32_t window_sum;         /**< Sum of the pressure samples of the current window, Pa */
+  uint16_t window_count;      /**< Samples in the current window */
+  int32_t window_mean;        /**< Mean pressure of the previous window, Pa * 16 */
+  int32_t calm_reference;     /**< Mean pressure of the window before the calm streak, Pa * 16 */
+  uint32_t window_elapsed_us; /**< Time accumulated in the current window */
+  uint32_t calm_elapsed_us;   /**< Time accumulated in the calm streak */
+  uint32_t rate;              /**< Last evaluated |dP/dt|, Pa/s */
+  uint8_t primed;             /**< Non-zero once the first sample was seen */
+} MS5611_Adaptive_OSR_TypeDef;
+
+// --- Acquisition Engine States ---
+typedef enum MS5611AcqStates{
+  MS5611_ACQ_IDLE,            /**< No conversion in progress */
+  MS5611_ACQ_CONVERTING_D2,   /**< Temperature conversion in progress */
+  MS5611_ACQ_CONVERTING_D1,   /**< Pressure conversion in progress */
+  MS5611_ACQ_RECOVER_RESET,   /**< Recovery: waiting for the sensor reset to finish */
+  MS5611_ACQ_RECOVER_BACKOFF  /**< Recovery: waiting before the next recovery attempt */
+}MS5611AcqStateTypeDef;
+
+// --- Acquisition Engine ---
+typedef struct {
+  MS5611_HW_InitTypeDef *hw;               /**< Sensor handle */
+  MS5611_Adaptive_OSR_TypeDef *adaptive;   /**< Optional adaptive OSR controller, NULL for fixed OSR */
+  uint8_t osr;                             /**< Fixed OSR when adaptive is NULL */
+  uint8_t temperature_decimation;          /**< Pressure samples per temperature conversion */
+  uint8_t self_healing;                    /**< Non-zero enables automatic bus-fault recovery */
+  uint8_t error_threshold;                 /**< Consecutive bus errors that trigger recovery */
+#if MS5611_CONFIG_FILTER
+  MS5611_Glitch_Filter_TypeDef *glitch_d1; /**< Optional D1 glitch filter, NULL to disable */
+  MS5611_Glitch_Filter_TypeDef *glitch_d2; /**< Optional D2 glitch filter, NULL to disable */
+#endif
+#if MS5611_CONFIG_THERMAL
+  MS5611_Thermal_TypeDef *thermal;         /**< Optional thermal lag model, NULL to disable */
+#endif
+#if MS5611_CONFIG_HUB
+  MS5611_Hub_TypeDef *hub;                 /**< Optional hub every sample is published to, NULL to disable */
+#endif
+
+  // Driver-managed state, do not set
+  MS5611AcqStateTypeDef state;             /**< Current conversion */
+  uint8_t active_osr;                      /**< OSR of the conversion pair in progress */
+  uint8_t d1_remaining;                    /**< Pressure samples left before the next temperature */
+  uint32_t last_pressure_read;             /**< Timestamp of the previous pressure read */
+  uint32_t last_temperature_read;          /**< Timestamp of the D2 read in use */
+  uint32_t sequence;                       /**< Sequence number of the next sample, also advanced by failed attempts */
+  uint8_t last_osr;                        /**< OSR of the previous sample */
+  uint8_t pending_flags;                   /**< MS5611_SAMPLE_* flags for the next sample */
+  MS5611_Raw_Data_TypeDef raw;             /**< Last raw D1/D2 pair */
+  uint8_t consecutive_errors;              /**< Bus errors since the last good sample */
+  uint8_t recovery_attempts;               /**< Failed attempts of the running recovery */
+  uint32_t wait_start;                     /**< Recovery wait start, ticks */
+  uint32_t wait_us;                        /**< Recovery wait length */
+  uint32_t recovery_start;                 /**< Timestamp when the running recovery began */
+  uint32_t errors;                         /**< Total bus errors */
+  uint32_t recoveries;                     /**< Completed recoveries */
+  uint32_t last_recovery_ticks;            /**< Duration of the last completed recovery, ticks */
+} MS5611_Acquisition_TypeDef;
+#endif /* MS5611_CONFIG_ASYNC */
+
 // --- Function Prototypes ---
 
 /**
  * @brief  Initializes MS5611 Sensor
  * @param  MS5611_Handler Pointer to hardware initialization structure
- * @retval MS5611StateTypeDef Initialization status
+ * @retval MS5611StateTypeDef Initialization status, FAILED when GetTimestamp is set and TicksPerUs is 0
  */
 MS5611StateTypeDef MS5611_Init(MS5611_HW_InitTypeDef *);
 
@@ -105,6 +198,27 @@ MS5611StateTypeDef MS5611_Init(MS5611_HW_InitTypeDef *);
  */
 MS5611StateTypeDef MS5611PromRead(MS5611_HW_InitTypeDef *, struct promData *prom);
 
+/**
+ * @brief  Copies the PROM calibration words read by MS5611_Init
+ * @param  prom Pointer to PROM data structure
+ */
+void MS5611_Get_Prom(struct promData *prom);
+
+/**
+ * @brief  Enables the timestamp source and clears the statistics, as MS5611_Init does
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ * @retval MS5611StateTypeDef READY, FAILED when GetTimestamp is set and TicksPerUs is 0
+ */
+MS5611StateTypeDef MS5611_Timestamp_Init(MS5611_HW_InitTypeDef *);
+
+/**
+ * @brief  Installs PROM calibration words read outside MS5611_Init (e.g. MS5611RTOS)
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ * @param  prom Pointer to PROM data structure read from the sensor
+ * @retval MS5611StateTypeDef READY, or FAILED for an empty or unreadable PROM
+ */
+MS5611StateTypeDef MS5611_Set_Prom(MS5611_HW_InitTypeDef *, const struct promData *prom);
+
 /**
  * @brief  Initiates an uncompensated pressure (D1) conversion
  * @param  MS5611_Handler Pointer to hardware initialization structure
@@ -129,6 +243,37 @@ MS5611StateTypeDef MS5611_Temperature_Conversion(MS5611_HW_InitTypeDef *, uint8_
  */
 MS5611StateTypeDef MS5611_ADC_Read(MS5611_HW_InitTypeDef *, uint32_t *);
 
+/**
+ * @brief  Reads ADC result together with its conversion timestamps
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ * @param  raw_data Pointer to store 24-bit raw ADC result
+ * @param  stamp Pointer to store conversion start and read timestamps
+ * @retval MS5611StateTypeDef Status after read
+ */
+MS5611StateTypeDef MS5611_ADC_Read_Stamped(MS5611_HW_InitTypeDef *, uint32_t *, MS5611_Timestamp_TypeDef *);
+
+/**
+ * @brief  Returns the current timestamp of the handle's tick source
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ * @retval uint32_t Current tick count
+ */
+uint32_t MS5611_Get_Timestamp(MS5611_HW_InitTypeDef *);
+
+#if MS5611_CONFIG_STATS
+/**
+ * @brief  Clears the latency and jitter statistics
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ */
+void MS5611_Timing_Reset(MS5611_HW_InitTypeDef *);
+
+/**
+ * @brief  Records the last D1 read (Stamp) in the latency and jitter statistics
+ * @note   Internal, for adaptation layers that read the ADC without MS5611_ADC_Read()
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ */
+void MS5611_Timing_Update(MS5611_HW_InitTypeDef *);
+#endif
+
 /**
  * @brief  Converts raw sensor values to compensated values using PROM calibration
  * @param  sample Pointer to raw data structure
@@ -136,6 +281,87 @@ MS5611StateTypeDef MS5611_ADC_Read(MS5611_HW_InitTypeDef *, uint32_t *);
  */
 void MS5611_Data_Convert(MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value);
 
+/**
+ * @brief  Returns the maximum conversion time for an oversampling ratio
+ * @param  osr MS5611_OSR_* value
+ * @retval uint32_t Conversion time in microseconds
+ */
+uint32_t MS5611_Conversion_Time_Us(uint8_t osr);
+
+#if MS5611_CONFIG_ASYNC
+/**
+ * @brief  Initializes an adaptive OSR controller
+ * @param  ctrl Pointer to controller
+ * @param  enter_rate |dP/dt| in Pa/s above which the fast OSR is selected
+ * @param  exit_rate Mean |dP/dt| in Pa/s over hold_windows below which the precise OSR returns
+ * @param  hold_windows Calm windows of MS5611_ADAPTIVE_WINDOW_US required before returning
+ */
+void MS5611_Adaptive_OSR_Init(MS5611_Adaptive_OSR_TypeDef *ctrl, uint32_t enter_rate, uint32_t exit_rate, uint16_t hold_windows);
+
+/**
+ * @brief  Sets the external dynamics hint (e.g. from IMU vertical acceleration)
+ * @param  ctrl Pointer to controller
+ * @param  dynamic Non-zero forces the fast OSR until cleared
+ */
+void MS5611_Adaptive_OSR_Hint(MS5611_Adaptive_OSR_TypeDef *ctrl, uint8_t dynamic);
+
+/**
+ * @brief  Feeds one compensated pressure sample into the controller
+ * @param  ctrl Pointer to controller
+ * @param  pressure Compensated pressure in Pa
+ * @param  dt_us Time since the previous sample in microseconds
+ * @retval uint8_t OSR to use for the next conversion pair
+ */
+uint8_t MS5611_Adaptive_OSR_Update(MS5611_Adaptive_OSR_TypeDef *ctrl, int32_t pressure, uint32_t dt_us);
+
+/**
+ * @brief  Initializes the non-blocking acquisition engine
+ * @param  acq Pointer to engine
+ * @param  MS5611_Handler Pointer to initialized hardware structure
+ * @param  osr Fixed OSR, ignored when adaptive is not NULL
+ * @param  temperature_decimation Pressure samples per temperature conversion (1 = every sample)
+ * @param  adaptive Optional adaptive OSR controller, may be NULL
+ */
+void MS5611_Acquisition_Init(MS5611_Acquisition_TypeDef *acq, MS5611_HW_InitTypeDef *, uint8_t osr, uint8_t temperature_decimation, MS5611_Adaptive_OSR_TypeDef *adaptive);
+
+/**
+ * @brief  Advances the acquisition engine, never waits for a conversion
+ * @param  acq Pointer to engine
+ * @param  value Pointer to store a new compensated sample
+ * @retval MS5611StateTypeDef READY when value was written, BUSY otherwise, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_Acquisition_Process(MS5611_Acquisition_TypeDef *acq, MS5611_Converted_Data_TypeDef *value);
+
+/**
+ * @brief  Advances the acquisition engine and returns new samples as extended records
+ * @note   Every returned sample is also published to acq->hub when it is set
+ * @param  acq Pointer to engine
+ * @param  sample Pointer to store a new sample record
+ * @retval MS5611StateTypeDef READY when sample was written, BUSY otherwise, HAL_ERROR on bus error
+ */
+MS5611StateTypeDef MS5611_Acquisition_Process_Sample(MS5611_Acquisition_TypeDef *acq, MS5611_Sample_TypeDef *sample);
+#endif /* MS5611_CONFIG_ASYNC */
+
+/**
+ * @brief  Converts raw sensor values using the calibration of a specific sensor
+ * @note   Use with several sensors; MS5611_Data_Convert uses the last initialized one.
+ *         With MS5611_CONFIG_MULTI_INSTANCE 0 every handle shares that calibration.
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ * @param  sample Pointer to raw data structure
+ * @param  value Pointer to converted data structure
+ */
+void MS5611_Instance_Data_Convert(MS5611_HW_InitTypeDef *, const MS5611_Raw_Data_TypeDef *sample, MS5611_Converted_Data_TypeDef *value);
+
+#if MS5611_CONFIG_FLOAT
+/**
+ * @brief  Converts raw sensor values to Pa and degC in floating point
+ * @param  MS5611_Handler Pointer to hardware initialization structure
+ * @param  sample Pointer to raw data structure
+ * @param  value Pointer to floating-point data structure
+ */
+void MS5611_Instance_Data_Convert_Float(MS5611_HW_InitTypeDef *, const MS5611_Raw_Data_TypeDef *sample, MS5611_Float_Data_TypeDef *value);
+#endif
+
 /**
  * @brief  Enables the chip select pin for SPI communication
  * @param  CS_GPIOport GPIO port of the CS pin
@@ -0,0 +1,251 @@
+/* ============================================================================================
+ * MS5611Stats.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Incremental noise statistics, in integers only so a push costs no floating point (on a
+ * single-precision FPU, double arithmetic is a library call). Mean and variance come from
+ * exact sums of the samples taken relative to the first one and of their squares, kept in
+ * 128 bits; the queries convert to double once. The Allan variance
+ * is kept at octave-spaced tau = m = 2^k samples by a cascade of block sums: level k builds
+ * sums of m samples starting every m/2 samples (every sample for m <= 2) from consecutive
+ * sums of level k-1, and accumulates the squared difference of sums m samples apart. This
+ * is the overlapping estimator with a stride of m/2 instead of 1, which keeps memory at a
+ * few words per level while using twice as many differences as the non-overlapping one.
+ * Squared differences are summed exactly in 128 bits as well.
+ */
+
+#include <math.h>
+#include <MS5611Stats.h>
+
+#if MS5611_CONFIG_STATS
+
+/**
+ * @brief  Adds a 64-bit value to a 128-bit accumulator
+ * @param  acc Pointer to accumulator
+ * @param  value Value to add
+ * @retval None
+ */
+static void MS5611_Stats_Sum_Add(MS5611_Stats_Sum_TypeDef *acc, uint64_t value){
+	acc->lo += value;
+	if (acc->lo < value)
+		acc->hi++;
+}
+
+/**
+ * @brief  Adds the square of a difference to a 128-bit accumulator
+ * @note   One 32x32 multiply while |delta| < 2^32, which is every realistic sample
+ * @param  acc Pointer to accumulator
+ * @param  delta Difference to square, |delta| < 2^63
+ * @retval None
+ */
+static void MS5611_Stats_Sum_Square(MS5611_Stats_Sum_TypeDef *acc, int64_t delta){
+	uint64_t magnitude = (delta < 0) ? 0U - (uint64_t) delta : (uint64_t) delta;
+	uint64_t high = magnitude >> 32;
+	uint64_t low = magnitude & 0xFFFFFFFFU;
+
+	if (high == 0) {
+		MS5611_Stats_Sum_Add(acc, low * low);
+	} else {
+		/* (high * 2^32 + low)^2 = high^2 * 2^64 + high * low * 2^33 + low^2 */
+		uint64_t cross = high * low;
+
+		acc->hi += high * high + (cross >> 31);
+		MS5611_Stats_Sum_Add(acc, cross << 33);
+		MS5611_Stats_Sum_Add(acc, low * low);
+	}
+}
+
+/**
+ * @brief  Converts a 128-bit accumulator to double
+ * @param  acc Pointer to accumulator
+ * @retval double Value, rounded
+ */
+static double MS5611_Stats_Sum_Value(const MS5611_Stats_Sum_TypeDef *acc){
+	return (double) acc->hi * 18446744073709551616.0 + (double) acc->lo;
+}
+
+/**
+ * @brief  Resets running statistics
+ * @param  stats Pointer to MS5611_Stats_TypeDef structure
+ * @retval None
+ */
+void MS5611_Stats_Reset(MS5611_Stats_TypeDef *stats){
+	uint8_t k;
+
+	stats->count = 0;
+	stats->origin = 0;
+	stats->sum = 0;
+	stats->sum_sq.lo = 0;
+	stats->sum_sq.hi = 0;
+	stats->min = INT32_MAX;
+	stats->max = INT32_MIN;
+
+	for (k = 0; k < MS5611_STATS_LEVELS; k++) {
+		stats->level[k].pending = 0;
+		stats->level[k].history[0] = 0;
+		stats->level[k].history[1] = 0;
+		stats->level[k].sum_sq.lo = 0;
+		stats->level[k].sum_sq.hi = 0;
+		stats->level[k].terms = 0;
+		stats->level[k].inputs = 0;
+		stats->level[k].outputs = 0;
+		stats->level[k].phase = 0;
+	}
+}
+
+/**
+ * @brief  Adds one sample
+ * @param  stats Pointer to MS5611_Stats_TypeDef structure
+ * @param  sample New sample
+ * @retval None
+ */
+void MS5611_Stats_Push(MS5611_Stats_TypeDef *stats, int32_t sample){
+	MS5611_Allan_Level_TypeDef *lv = &stats->level[0];
+	int64_t offset;
+	int64_t value = sample;
+	uint8_t k;
+
+	if (stats->count == 0)
+		stats->origin = sample;
+
+	stats->count++;
+	offset = (int64_t) sample - stats->origin;
+	stats->sum += offset;
+	MS5611_Stats_Sum_Square(&stats->sum_sq, offset);
+	if (sample < stats->min)
+		stats->min = sample;
+	if (sample > stats->max)
+		stats->max = sample;
+
+	/* tau = 1: consecutive samples */
+	if (lv->outputs != 0) {
+		MS5611_Stats_Sum_Square(&lv->sum_sq, value - lv->history[1]);
+		lv->terms++;
+	}
+	lv->history[1] = value;
+	lv->outputs = 1;
+
+	for (k = 1; k < MS5611_STATS_LEVELS; k++) {
+		int64_t sum;
+
+		lv = &stats->level[k];
+
+		/* Level 1 takes every sample, higher levels only the sums starting at multiples of m/2 */
+		if (k >= 2) {
+			lv->phase ^= 1;
+			if (lv->phase == 0)
+				return;
+		}
+
+		if (lv->inputs == 0) {
+			lv->pending = value;
+			lv->inputs = 1;
+			return;
+		}
+
+		sum = lv->pending + value;
+		lv->pending = value;
+
+		/* Block sums are produced every m/2 samples, so the sum m samples back is two outputs back */
+		if (lv->outputs == 2) {
+			MS5611_Stats_Sum_Square(&lv->sum_sq, sum - lv->history[0]);
+			lv->terms++;
+		} else {
+			lv->outputs++;
+		}
+		lv->history[0] = lv->history[1];
+		lv->history[1] = sum;
+
+		value = sum;
+	}
+}
+
+/**
+ * @brief  Returns the running mean
+ * @param  stats Pointer to MS5611_Stats_TypeDef structure
+ * @retval double Mean, 0 before the first sample
+ */
+double MS5611_Stats_Mean(const MS5611_Stats_TypeDef *stats){
+	if (stats->count == 0)
+		return 0.0;
+
+	return (double) stats->origin + (double) stats->sum / (double) stats->count;
+}
+
+/**
+ * @brief  Returns the unbiased sample variance
+ * @param  stats Pointer to MS5611_Stats_TypeDef structure
+ * @retval double Variance, 0 before the second sample
+ */
+double MS5611_Stats_Variance(const MS5611_Stats_TypeDef *stats){
+	double sum;
+	double m2;
+
+	if (stats->count < 2)
+		return 0.0;
+
+	sum = (double) stats->sum;
+	m2 = MS5611_Stats_Sum_Value(&stats->sum_sq) - sum * sum / (double) stats->count;
+
+	return (m2 > 0.0) ? m2 / (double) (stats->count - 1) : 0.0;
+}
+
+/**
+ * @brief  Returns the Allan deviation at tau = 2^level samples
+ * @note   AVAR(m) = sum((S[t+m] - S[t])^2) / (2 m^2 terms), S = block sum of m samples
+ * @param  stats Pointer to MS5611_Stats_TypeDef structure
+ * @param  level Octave, 0..MS5611_STATS_LEVELS-1
+ * @retval double Allan deviation in sample units, 0 while no difference is available
+ */
+double MS5611_Stats_Allan_Deviation(const MS5611_Stats_TypeDef *stats, uint8_t level){
+	const MS5611_Allan_Level_TypeDef *lv;
+	double m;
+
+	if (level >= MS5611_STATS_LEVELS)
+		return 0.0;
+
+	lv = &stats->level[level];
+	if (lv->terms == 0)
+		return 0.0;
+
+	m = (double) (1UL << level);
+	return sqrt(MS5611_Stats_Sum_Value(&lv->sum_sq) / (2.0 * m * m * (double) lv->terms));
+}
+
+/**
+ * @brief  Resets both statistics of a sensor
+ * @param  noise Pointer to MS5611_Noise_Stats_TypeDef structure
+ * @retval None
+ */
+void MS5611_Noise_Stats_Reset(MS5611_Noise_Stats_TypeDef *noise){
+	MS5611_Stats_Reset(&noise->d1);
+	MS5611_Stats_Reset(&noise->pressure);
+}
+
+/**
+ * @brief  Adds one sensor sample to the raw D1 and pressure statistics
+ * @param  noise Pointer to MS5611_Noise_Stats_TypeDef structure
+ * @param  raw Raw ADC pair of the sample
+ * @param  value Compensated sample
+ * @retval None
+ */
+void MS5611_Noise_Stats_Update(MS5611_Noise_Stats_TypeDef *noise, const MS5611_Raw_Data_TypeDef *raw, const MS5611_Converted_Data_TypeDef *value){
+	MS5611_Stats_Push(&noise->d1, (int32_t) raw->pressure);
+	MS5611_Stats_Push(&noise->pressure, value->pressure);
+}
+
+#endif /* MS5611_CONFIG_STATS */
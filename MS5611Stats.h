@@ -0,0 +1,128 @@
+/* ============================================================================================
+ * MS5611Stats.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611STATS_H_
+#define _MS5611STATS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "MS5611Compensate.h"
+
+// --- Statistics Configuration ---
+#ifndef MS5611_STATS_LEVELS
+#define MS5611_STATS_LEVELS           16    /**< Allan levels, tau = 2^0 .. 2^(LEVELS-1) samples */
+#endif
+
+// --- Unsigned 128-bit Accumulator ---
+typedef struct {
+  uint64_t lo;              /**< Low 64 bits */
+  uint64_t hi;              /**< High 64 bits */
+} MS5611_Stats_Sum_TypeDef;
+
+// --- Allan Variance Level (tau = 2^k samples) ---
+typedef struct {
+  int64_t pending;          /**< Previous input block sum, waiting for its neighbour */
+  int64_t history[2];       /**< Last two block sums of this level, [1] newest */
+  MS5611_Stats_Sum_TypeDef sum_sq;  /**< Sum of squared block-sum differences, exact */
+  uint32_t terms;           /**< Differences accumulated in sum_sq */
+  uint8_t inputs;           /**< Inputs seen, saturates at 2 */
+  uint8_t outputs;          /**< Block sums produced, saturates at 2 */
+  uint8_t phase;            /**< Input decimation phase */
+} MS5611_Allan_Level_TypeDef;
+
+// --- Running Statistics of One Signal ---
+typedef struct {
+  uint32_t count;                                        /**< Samples pushed */
+  int32_t origin;                                        /**< First sample, sums run relative to it */
+  int64_t sum;                                           /**< Sum of samples minus origin */
+  MS5611_Stats_Sum_TypeDef sum_sq;                       /**< Sum of squared samples minus origin, exact */
+  int32_t min;                                           /**< Smallest sample */
+  int32_t max;                                           /**< Largest sample */
+  MS5611_Allan_Level_TypeDef level[MS5611_STATS_LEVELS]; /**< Octave-spaced Allan accumulators */
+} MS5611_Stats_TypeDef;
+
+// --- Per-Sensor Noise Statistics ---
+typedef struct {
+  MS5611_Stats_TypeDef d1;        /**< Raw D1 words, ADC counts */
+  MS5611_Stats_TypeDef pressure;  /**< Compensated pressure, Pa */
+} MS5611_Noise_Stats_TypeDef;
+
+// --- Function Prototypes ---
+#if MS5611_CONFIG_STATS
+
+/**
+ * @brief  Resets running statistics
+ * @param  stats Pointer to statistics state
+ */
+void MS5611_Stats_Reset(MS5611_Stats_TypeDef *stats);
+
+/**
+ * @brief  Adds one sample
+ * @note   Amortized O(1): level k is updated once every 2^(k-1) samples. Integer only,
+ *         no floating point until a result is queried
+ * @param  stats Pointer to statistics state
+ * @param  sample New sample
+ */
+void MS5611_Stats_Push(MS5611_Stats_TypeDef *stats, int32_t sample);
+
+/**
+ * @brief  Returns the running mean
+ * @param  stats Pointer to statistics state
+ * @retval double Mean, 0 before the first sample
+ */
+double MS5611_Stats_Mean(const MS5611_Stats_TypeDef *stats);
+
+/**
+ * @brief  Returns the unbiased sample variance
+ * @param  stats Pointer to statistics state
+ * @retval double Variance, 0 before the second sample
+ */
+double MS5611_Stats_Variance(const MS5611_Stats_TypeDef *stats);
+
+/**
+ * @brief  Returns the Allan deviation at tau = 2^level samples
+ * @param  stats Pointer to statistics state
+ * @param  level Octave, 0..MS5611_STATS_LEVELS-1
+ * @retval double Allan deviation in sample units, 0 while no difference is available
+ */
+double MS5611_Stats_Allan_Deviation(const MS5611_Stats_TypeDef *stats, uint8_t level);
+
+/**
+ * @brief  Resets both statistics of a sensor
+ * @param  noise Pointer to noise statistics
+ */
+void MS5611_Noise_Stats_Reset(MS5611_Noise_Stats_TypeDef *noise);
+
+/**
+ * @brief  Adds one sensor sample to the raw D1 and pressure statistics
+ * @param  noise Pointer to noise statistics
+ * @param  raw Raw ADC pair of the sample
+ * @param  value Compensated sample
+ */
+void MS5611_Noise_Stats_Update(MS5611_Noise_Stats_TypeDef *noise, const MS5611_Raw_Data_TypeDef *raw, const MS5611_Converted_Data_TypeDef *value);
+#endif /* MS5611_CONFIG_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611STATS_H_ */
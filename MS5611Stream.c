@@ -0,0 +1,184 @@
+/* ============================================================================================
+ * MS5611Stream.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * End-to-end loss accounting for a sample stream. The acquisition engine numbers every
+ * attempted sample, failed ones included, so anything missing between producer and
+ * consumer (bus faults, recovery, hub overwrites) shows up as a sequence gap here. A
+ * window of recently seen sequences separates duplicates from late, reordered arrivals,
+ * and the timestamps are checked against the configured period to catch deadline misses.
+ * The delivered rate divides by a 64-bit sum of intervals, as a 32-bit timestamp span
+ * wraps after 17 s at 250 MHz.
+ */
+
+#include <MS5611Stream.h>
+
+/**
+ * @brief  Resets a stream monitor
+ * @param  stream Pointer to MS5611_Stream_TypeDef structure
+ * @param  period Nominal ticks between samples, 0 disables the deadline check
+ * @param  tolerance Ticks tolerated beyond the period
+ * @retval None
+ */
+void MS5611_Stream_Init(MS5611_Stream_TypeDef *stream, uint32_t period, uint32_t tolerance){
+	stream->period = period;
+	stream->tolerance = tolerance;
+	stream->primed = 0;
+	stream->next = 0;
+	stream->history = 0;
+	stream->first_sequence = 0;
+	stream->expected = 0;
+	stream->last_stamp = 0;
+	stream->elapsed = 0;
+	stream->received = 0;
+	stream->lost = 0;
+	stream->gaps = 0;
+	stream->max_gap = 0;
+	stream->duplicates = 0;
+	stream->reordered = 0;
+	stream->stale = 0;
+	stream->late = 0;
+	stream->resyncs = 0;
+	stream->max_interval = 0;
+}
+
+/**
+ * @brief  Checks one received sample against the expected sequence and deadline
+ * @param  stream Pointer to MS5611_Stream_TypeDef structure
+ * @param  sample Received sample record
+ * @retval uint8_t MS5611_STREAM_* event flags, MS5611_STREAM_IN_ORDER when none
+ */
+uint8_t MS5611_Stream_Check(MS5611_Stream_TypeDef *stream, const MS5611_Sample_TypeDef *sample){
+	int32_t ahead;
+	uint32_t missing;
+	uint32_t interval;
+	uint8_t events = MS5611_STREAM_IN_ORDER;
+
+	if (!stream->primed) {
+		stream->primed = 1;
+		stream->next = sample->sequence + 1;
+		stream->history = 1;
+		stream->first_sequence = sample->sequence;
+		stream->last_stamp = sample->stamp;
+		stream->received = 1;
+		return MS5611_STREAM_IN_ORDER;
+	}
+
+	ahead = (int32_t) (sample->sequence - stream->next);
+
+	/* Sequence went back but time moved on: the producer restarted its numbering after a
+	 * fault or re-init. Late or repeated samples carry a stamp no newer than the last one. */
+	if (ahead < 0 && (int32_t) (sample->stamp - stream->last_stamp) > 0) {
+		stream->expected += stream->next - stream->first_sequence;
+		stream->first_sequence = sample->sequence;
+		stream->next = sample->sequence + 1;
+		stream->history = 1;
+		stream->last_stamp = sample->stamp;
+		stream->received++;
+		stream->resyncs++;
+		return MS5611_STREAM_RESYNC;
+	}
+
+	/* Older than expected: duplicate, recovered out of order, or beyond the window */
+	if (ahead < 0) {
+		uint32_t age = (uint32_t) (-(ahead + 1));
+
+		if (age >= MS5611_STREAM_WINDOW) {
+			stream->stale++;
+			return MS5611_STREAM_STALE;
+		}
+		if (stream->history & (1UL << age)) {
+			stream->duplicates++;
+			return MS5611_STREAM_DUPLICATE;
+		}
+
+		stream->history |= 1UL << age;
+		stream->received++;
+		stream->reordered++;
+		stream->lost--;
+		return MS5611_STREAM_REORDERED;
+	}
+
+	missing = (uint32_t) ahead;
+	if (missing != 0) {
+		stream->gaps++;
+		stream->lost += missing;
+		if (missing > stream->max_gap)
+			stream->max_gap = missing;
+		events |= MS5611_STREAM_GAP;
+	}
+
+	stream->history = (missing + 1 >= MS5611_STREAM_WINDOW) ? 1 : ((stream->history << (missing + 1)) | 1);
+	stream->next = sample->sequence + 1;
+	stream->received++;
+
+	/* Deadline scales with the missing samples, so a gap alone does not count as late */
+	interval = sample->stamp - stream->last_stamp;
+	stream->last_stamp = sample->stamp;
+	stream->elapsed += interval;
+	if (interval > stream->max_interval)
+		stream->max_interval = interval;
+	if (stream->period != 0 &&
+	    (uint64_t) interval > (uint64_t) stream->period * (missing + 1) + stream->tolerance) {
+		stream->late++;
+		events |= MS5611_STREAM_LATE;
+	}
+
+	return events;
+}
+
+/**
+ * @brief  Delivered rate over the monitored span
+ * @param  stream Pointer to MS5611_Stream_TypeDef structure
+ * @param  ticks_per_second Frequency of the timestamp clock
+ * @retval uint32_t Rate in mHz, 0 before two samples were received
+ */
+uint32_t MS5611_Stream_Rate_mHz(const MS5611_Stream_TypeDef *stream, uint32_t ticks_per_second){
+	/* Each resync starts a new span, so its first sample adds no interval */
+	uint64_t intervals = (uint64_t) stream->received - 1U - stream->resyncs;
+	uint64_t elapsed = stream->elapsed;
+	uint64_t scale = (uint64_t) ticks_per_second * 1000U;
+	uint64_t rate;
+
+	if (stream->received < 2)
+		return 0;
+
+	/* Halve both until the product fits, past 2^64 / (1000 * ticks_per_second) intervals */
+	while (scale != 0 && intervals > UINT64_MAX / scale) {
+		intervals >>= 1;
+		elapsed >>= 1;
+	}
+	if (elapsed == 0)
+		return 0;
+
+	rate = intervals * scale / elapsed;
+	return (rate > UINT32_MAX) ? UINT32_MAX : (uint32_t) rate;
+}
+
+/**
+ * @brief  Fraction of the expected samples that were lost
+ * @param  stream Pointer to MS5611_Stream_TypeDef structure
+ * @retval uint32_t Loss in parts per million
+ */
+uint32_t MS5611_Stream_Loss_Ppm(const MS5611_Stream_TypeDef *stream){
+	uint64_t expected = (uint64_t) stream->expected + (stream->next - stream->first_sequence);
+
+	if (expected == 0)
+		return 0;
+
+	return (uint32_t) ((uint64_t) stream->lost * 1000000U / expected);
+}
@@ -0,0 +1,106 @@
+/* ============================================================================================
+ * MS5611Stream.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611STREAM_H_
+#define _MS5611STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "MS5611Compensate.h"
+
+// --- Stream Monitor Configuration ---
+#define MS5611_STREAM_WINDOW          32    /**< Sequences remembered for duplicate/reorder checks */
+
+// --- Per-Sample Events, returned by MS5611_Stream_Check ---
+#define MS5611_STREAM_IN_ORDER        0x00  /**< Next expected sequence, on time */
+#define MS5611_STREAM_GAP             0x01  /**< Sequences skipped before this one */
+#define MS5611_STREAM_DUPLICATE       0x02  /**< Sequence already received */
+#define MS5611_STREAM_REORDERED       0x04  /**< Older sequence that was counted lost, now recovered */
+#define MS5611_STREAM_STALE           0x08  /**< Older than the window, cannot be classified */
+#define MS5611_STREAM_LATE            0x10  /**< Interval to the previous sample exceeds the deadline */
+#define MS5611_STREAM_RESYNC          0x20  /**< Sequence went back with time moving on (re-init), restarted */
+
+// --- Stream Monitor, owned by one consumer ---
+typedef struct {
+  uint32_t period;          /**< Nominal ticks between samples, 0 disables the deadline check */
+  uint32_t tolerance;       /**< Ticks tolerated beyond the period before a sample is late */
+  uint8_t primed;           /**< Non-zero once the first sample was seen */
+  uint32_t next;            /**< Next expected sequence */
+  uint32_t history;         /**< Bit k set when sequence next-1-k was received */
+  uint32_t first_sequence;  /**< Sequence of the first sample since the last resync */
+  uint32_t expected;        /**< Sequences expected before the last resync */
+  uint32_t last_stamp;      /**< Timestamp of the newest in-order sample */
+  uint64_t elapsed;         /**< Sum of the intervals between in-order samples, ticks */
+  uint32_t received;        /**< Distinct samples received */
+  uint32_t lost;            /**< Samples missing, net of those recovered out of order */
+  uint32_t gaps;            /**< Gap events */
+  uint32_t max_gap;         /**< Largest number of samples missing in one gap */
+  uint32_t duplicates;      /**< Samples received more than once */
+  uint32_t reordered;       /**< Samples received after a newer one */
+  uint32_t stale;           /**< Samples too old to classify */
+  uint32_t late;            /**< Deadline misses */
+  uint32_t resyncs;         /**< Sequence restarts */
+  uint32_t max_interval;    /**< Longest interval between in-order samples, ticks */
+} MS5611_Stream_TypeDef;
+
+// --- Function Prototypes ---
+
+/**
+ * @brief  Resets a stream monitor
+ * @param  stream Pointer to stream monitor
+ * @param  period Nominal ticks between samples, 0 disables the deadline check
+ * @param  tolerance Ticks tolerated beyond the period
+ */
+void MS5611_Stream_Init(MS5611_Stream_TypeDef *stream, uint32_t period, uint32_t tolerance);
+
+/**
+ * @brief  Checks one received sample against the expected sequence and deadline
+ * @note   The sequence and stamp fields of the record are used; sequences wrap modulo 2^32.
+ *         A sequence older than expected with a stamp newer than the last sample restarts
+ *         the monitor (producer re-initialized); stamps must be less than 2^31 ticks apart
+ * @param  stream Pointer to stream monitor
+ * @param  sample Received sample record
+ * @retval uint8_t MS5611_STREAM_* event flags, MS5611_STREAM_IN_ORDER when none
+ */
+uint8_t MS5611_Stream_Check(MS5611_Stream_TypeDef *stream, const MS5611_Sample_TypeDef *sample);
+
+/**
+ * @brief  Delivered rate over the monitored span
+ * @note   The span is a 64-bit sum of intervals, so it does not wrap with the timestamps
+ * @param  stream Pointer to stream monitor
+ * @param  ticks_per_second Frequency of the timestamp clock
+ * @retval uint32_t Rate in mHz, 0 before two samples were received
+ */
+uint32_t MS5611_Stream_Rate_mHz(const MS5611_Stream_TypeDef *stream, uint32_t ticks_per_second);
+
+/**
+ * @brief  Fraction of the expected samples that were lost
+ * @param  stream Pointer to stream monitor
+ * @retval uint32_t Loss in parts per million
+ */
+uint32_t MS5611_Stream_Loss_Ppm(const MS5611_Stream_TypeDef *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611STREAM_H_ */
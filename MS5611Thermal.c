@@ -0,0 +1,145 @@
+/* ============================================================================================
+ * MS5611Thermal.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Thermal lag compensation. When the board heats up, D2 follows the die, which trails the
+ * membrane by a first-order lag: dTdie/dt = (Tmem - Tdie) / tau. Inverting it gives
+ * Tmem = Tdie + tau * dTdie/dt, so the model keeps a smoothed D2 slope and shifts D2 along
+ * it by the lead time plus the age of the word. dT, and with it TEMP, OFF and SENS, is
+ * linear in D2, so the shifted word goes through the unchanged compensation kernels.
+ * The slope costs one division per fresh D2 word; the per-sample prediction is two
+ * multiplies. tools/ms5611_thermal_fit.c identifies lead and smoothing from warm-up logs.
+ */
+
+#include <MS5611Thermal.h>
+
+#if MS5611_CONFIG_THERMAL
+
+#define MS5611_THERMAL_DELTA_MAX      (1L << 22)  /**< D2 step clamp, keeps the Q32 slope in range */
+#define MS5611_THERMAL_D2_MAX         0xFFFFFEUL  /**< Largest predicted word, below the ADC rail */
+
+/**
+ * @brief  Initializes a thermal lag model
+ * @param  model Pointer to MS5611_Thermal_TypeDef structure
+ * @param  lead_us Thermal lead of the membrane over the die, microseconds
+ * @param  shift Slope smoothing shift, 0..MS5611_THERMAL_SHIFT_MAX
+ * @param  ticks_per_us Ticks per microsecond of the timestamps passed in
+ * @retval None
+ */
+void MS5611_Thermal_Init(MS5611_Thermal_TypeDef *model, int32_t lead_us, uint8_t shift, uint32_t ticks_per_us){
+	if (shift > MS5611_THERMAL_SHIFT_MAX)
+		shift = MS5611_THERMAL_SHIFT_MAX;
+	if (ticks_per_us == 0)
+		ticks_per_us = 1;
+
+	model->lead_us = lead_us;
+	model->shift = shift;
+	model->us_per_tick = (1UL << 24) / ticks_per_us;
+	MS5611_Thermal_Reset(model);
+}
+
+/**
+ * @brief  Forgets the D2 history, keeping the coefficients
+ * @param  model Pointer to MS5611_Thermal_TypeDef structure
+ * @retval None
+ */
+void MS5611_Thermal_Reset(MS5611_Thermal_TypeDef *model){
+	model->primed = 0;
+	model->d2 = 0;
+	model->stamp = 0;
+	model->slope = 0;
+	model->updates = 0;
+}
+
+/**
+ * @brief  Adds one fresh D2 word and updates the smoothed slope
+ * @param  model Pointer to MS5611_Thermal_TypeDef structure
+ * @param  d2 Raw temperature word
+ * @param  stamp D2 read timestamp, ticks
+ * @retval None
+ */
+void MS5611_Thermal_Update(MS5611_Thermal_TypeDef *model, uint32_t d2, uint32_t stamp){
+	int64_t elapsed_us;
+	int64_t delta;
+	int64_t slope;
+
+	model->updates++;
+
+	if (!model->primed) {
+		model->d2 = d2;
+		model->stamp = stamp;
+		model->primed = 1;
+		return;
+	}
+
+	elapsed_us = (int64_t) (((uint64_t) (stamp - model->stamp) * model->us_per_tick) >> 24);
+	if (elapsed_us == 0)
+		return;
+
+	delta = (int64_t) d2 - (int64_t) model->d2;
+	if (delta > MS5611_THERMAL_DELTA_MAX)
+		delta = MS5611_THERMAL_DELTA_MAX;
+	else if (delta < -MS5611_THERMAL_DELTA_MAX)
+		delta = -MS5611_THERMAL_DELTA_MAX;
+
+	slope = (delta * (1LL << 32)) / elapsed_us;
+	if (slope > MS5611_THERMAL_SLOPE_MAX)
+		slope = MS5611_THERMAL_SLOPE_MAX;
+	else if (slope < -MS5611_THERMAL_SLOPE_MAX)
+		slope = -MS5611_THERMAL_SLOPE_MAX;
+
+	model->slope += (slope - model->slope) >> model->shift;
+	model->d2 = d2;
+	model->stamp = stamp;
+}
+
+/**
+ * @brief  Predicts the D2 word of the membrane temperature at a given time
+ * @note   Extrapolates over the age of the word plus the lead time, so a decimated D2 is
+ *         also carried forward to the pressure sample
+ * @param  model Pointer to MS5611_Thermal_TypeDef structure, updated at least once
+ * @param  stamp Time of the pressure sample, ticks
+ * @retval uint32_t Effective D2 word for compensation
+ */
+uint32_t MS5611_Thermal_Predict(const MS5611_Thermal_TypeDef *model, uint32_t stamp){
+	int64_t horizon = (int64_t) (((uint64_t) (stamp - model->stamp) * model->us_per_tick) >> 24) + model->lead_us;
+	int64_t d2;
+
+	if (horizon > MS5611_THERMAL_HORIZON_MAX)
+		horizon = MS5611_THERMAL_HORIZON_MAX;
+	else if (horizon < -MS5611_THERMAL_HORIZON_MAX)
+		horizon = -MS5611_THERMAL_HORIZON_MAX;
+
+	d2 = (int64_t) model->d2 + ((model->slope * horizon) >> 32);
+
+	if (d2 < 1)
+		return 1;
+	if (d2 > (int64_t) MS5611_THERMAL_D2_MAX)
+		return MS5611_THERMAL_D2_MAX;
+	return (uint32_t) d2;
+}
+
+/**
+ * @brief  Returns the smoothed D2 slope
+ * @param  model Pointer to MS5611_Thermal_TypeDef structure
+ * @retval int32_t D2 counts per second
+ */
+int32_t MS5611_Thermal_Slope(const MS5611_Thermal_TypeDef *model){
+	return (int32_t) ((model->slope * 1000000LL) >> 32);
+}
+
+#endif /* MS5611_CONFIG_THERMAL */
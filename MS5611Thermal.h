@@ -0,0 +1,96 @@
+/* ============================================================================================
+ * MS5611Thermal.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ */
+
+#ifndef _MS5611THERMAL_H_
+#define _MS5611THERMAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "MS5611Config.h"
+
+// --- Thermal Model Limits ---
+#define MS5611_THERMAL_SHIFT_MAX      12          /**< Largest slope smoothing shift */
+#define MS5611_THERMAL_SLOPE_MAX      (1LL << 35) /**< Slope clamp, 8 D2 counts/us in Q32 */
+#define MS5611_THERMAL_HORIZON_MAX    (1LL << 27) /**< Prediction horizon clamp, us (134 s) */
+
+// --- First-Order Thermal Lag Model, one per sensor ---
+typedef struct {
+  int32_t lead_us;          /**< Membrane lead over the D2 (die) temperature, us */
+  uint8_t shift;            /**< Slope smoothing, EWMA weight 2^-shift per D2 word */
+  uint8_t primed;           /**< Non-zero once the first D2 word was seen */
+  uint32_t us_per_tick;     /**< Microseconds per tick, Q24 */
+  uint32_t d2;              /**< Newest D2 word */
+  uint32_t stamp;           /**< Timestamp of the newest D2 word, ticks */
+  int64_t slope;            /**< Smoothed D2 slope, counts/us in Q32 */
+  uint32_t updates;         /**< D2 words seen */
+} MS5611_Thermal_TypeDef;
+
+// --- Function Prototypes ---
+#if MS5611_CONFIG_THERMAL
+
+/**
+ * @brief  Initializes a thermal lag model
+ * @param  model Pointer to model state
+ * @param  lead_us Thermal lead of the membrane over the die, us; tools/ms5611_thermal_fit.c
+ * @param  shift Slope smoothing shift, 0..MS5611_THERMAL_SHIFT_MAX
+ * @param  ticks_per_us Ticks per microsecond of the timestamps passed in
+ */
+void MS5611_Thermal_Init(MS5611_Thermal_TypeDef *model, int32_t lead_us, uint8_t shift, uint32_t ticks_per_us);
+
+/**
+ * @brief  Forgets the D2 history, keeping the coefficients
+ * @param  model Pointer to model state
+ */
+void MS5611_Thermal_Reset(MS5611_Thermal_TypeDef *model);
+
+/**
+ * @brief  Adds one fresh D2 word
+ * @note   One 64-bit division; call only for new conversions, not for reused words
+ * @param  model Pointer to model state
+ * @param  d2 Raw temperature word
+ * @param  stamp D2 read timestamp, ticks
+ */
+void MS5611_Thermal_Update(MS5611_Thermal_TypeDef *model, uint32_t d2, uint32_t stamp);
+
+/**
+ * @brief  Predicts the D2 word of the membrane temperature at a given time
+ * @note   Division-free, two multiplies; extrapolates a decimated D2 to the D1 read as well
+ * @param  model Pointer to model state, updated at least once
+ * @param  stamp Time of the pressure sample, ticks
+ * @retval uint32_t Effective D2 word for compensation
+ */
+uint32_t MS5611_Thermal_Predict(const MS5611_Thermal_TypeDef *model, uint32_t stamp);
+
+/**
+ * @brief  Returns the smoothed D2 slope
+ * @param  model Pointer to model state
+ * @retval int32_t D2 counts per second
+ */
+int32_t MS5611_Thermal_Slope(const MS5611_Thermal_TypeDef *model);
+
+#endif /* MS5611_CONFIG_THERMAL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MS5611THERMAL_H_ */
@@ -0,0 +1,155 @@
+#!/bin/sh
+# ============================================================================================
+# footprint.sh
+#
+# Created on: Oct 16, 2026
+# Author: Nathan Netzel
+#
+# SPDX-License-Identifier: MIT
+#
+# Copyright (c) 2026 Nathan Netzel
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the conditions of the MIT License.
+# ============================================================================================
+#
+# Reports .text/.data/.bss of the core driver (MS5611SPI, MS5611Compensate, MS5611Filter,
+# MS5611Stats, MS5611Thermal, MS5611Hub) for every MS5611Config.h switch alone on top of the minimal build, plus the
+# minimal and full builds, then the optional modules at their default configuration.
+# Runs the host compiler and, when found, arm-none-eabi-gcc for a Cortex-M33.
+#
+#   tools/footprint.sh                    print the report
+#   tools/footprint.sh --check FILE       also fail if a minimal build grew against FILE, or if
+#                                         FILE has a target line whose compiler is missing
+#   tools/footprint.sh --update FILE      record the minimal builds in FILE
+#
+# Environment:
+#   HOST_CC      host compiler (default cc)
+#   ARM_PREFIX   cross prefix (default arm-none-eabi-), empty string skips the target
+#   HAL_INC      directory with stm32h5xx_hal.h (default tools/sim, the host stand-in)
+#   EXTRA_CFLAGS appended to every compile, e.g. device defines for a real HAL_INC
+#
+# Objects are measured unlinked, so every compiled function counts; the switches remove
+# code at compile time and the numbers show what a linker cannot drop on its own.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+HOST_CC=${HOST_CC:-cc}
+ARM_PREFIX=${ARM_PREFIX-arm-none-eabi-}
+HAL_INC=${HAL_INC:-$ROOT/tools/sim}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+CORE="MS5611SPI.c MS5611Compensate.c MS5611Filter.c MS5611Stats.c MS5611Thermal.c MS5611Hub.c"
+MODULES="MS5611Stream.c MS5611Queue.c MS5611Fusion.c MS5611Altitude.c MS5611Log.c MS5611LowPower.c"
+FEATURES="FLOAT STATS FILTER MULTI_INSTANCE ASYNC THERMAL HUB KERNEL_REFERENCE KERNEL_INT32 KERNEL_BATCH"
+
+MODE=report
+BASELINE=
+case "$1" in
+	--check)  MODE=check;  BASELINE=$2 ;;
+	--update) MODE=update; BASELINE=$2 ;;
+	"") ;;
+	*) echo "usage: $0 [--check FILE | --update FILE]" >&2; exit 2 ;;
+esac
+if [ "$MODE" != report ] && [ -z "$BASELINE" ]; then
+	echo "$0: $1 needs a baseline file" >&2
+	exit 2
+fi
+
+# size_of CC SIZE CFLAGS FILES... -> "text data bss" summed over the objects
+size_of() {
+	cc=$1; sz=$2; flags=$3
+	shift 3
+	objs=
+	for src in "$@"; do
+		obj="$WORK/$(basename "$src" .c).o"
+		# shellcheck disable=SC2086
+		$cc $flags -I"$HAL_INC" -I"$ROOT" $EXTRA_CFLAGS -c "$ROOT/$src" -o "$obj"
+		objs="$objs $obj"
+	done
+	# shellcheck disable=SC2086
+	$sz -B $objs | awk 'NR > 1 { t += $1; d += $2; b += $3 } END { print t, d, b }'
+}
+
+# row LABEL "text data bss"
+row() {
+	set -- "$1" $2
+	printf '  %-24s %8s %8s %8s %8s\n' "$1" "$2" "$3" "$4" $(($2 + $3 + $4))
+}
+
+# report NAME CC SIZE CFLAGS
+report() {
+	name=$1; cc=$2; sz=$3; flags=$4
+
+	echo "$name: $($cc --version | head -n 1)"
+	printf '  %-24s %8s %8s %8s %8s\n' config text data bss total
+
+	minimal=$(size_of "$cc" "$sz" "$flags -DMS5611_CONFIG_MINIMAL" $CORE)
+	row minimal "$minimal"
+	for feature in $FEATURES; do
+		row "+$feature" "$(size_of "$cc" "$sz" "$flags -DMS5611_CONFIG_MINIMAL -DMS5611_CONFIG_$feature=1" $CORE)"
+	done
+	row full "$(size_of "$cc" "$sz" "$flags" $CORE)"
+	for module in $MODULES; do
+		row "$(basename "$module" .c)" "$(size_of "$cc" "$sz" "$flags" "$module")"
+	done
+	echo
+
+	record "$name" "$cc" "$minimal"
+}
+
+# record NAME CC "text data bss" -> compares or stores the minimal build
+record() {
+	version=$($2 --version | head -n 1)
+
+	case "$MODE" in
+	update)
+		echo "$1 $3 $version" >> "$WORK/baseline"
+		;;
+	check)
+		line=$(grep "^$1 " "$BASELINE" || true)
+		if [ -z "$line" ]; then
+			echo "$1: no baseline, skipped"
+			return
+		fi
+		set -- "$1" $3
+		set -- "$@" $(echo "$line" | cut -d ' ' -f 2-4)
+		if [ "$(echo "$line" | cut -d ' ' -f 5-)" != "$version" ]; then
+			echo "$1: baseline from another compiler, skipped"
+		elif [ "$2" -gt "$5" ] || [ "$3" -gt "$6" ] || [ "$4" -gt "$7" ]; then
+			echo "$1: minimal build grew: $2/$3/$4 > $5/$6/$7 (text/data/bss)"
+			FAILED=1
+		else
+			echo "$1: minimal build within baseline ($2/$3/$4 <= $5/$6/$7)"
+		fi
+		;;
+	esac
+}
+
+FAILED=0
+report host "$HOST_CC" size "-Os -std=c11 -ffunction-sections -fdata-sections"
+
+if [ -n "$ARM_PREFIX" ] && command -v "${ARM_PREFIX}gcc" > /dev/null 2>&1; then
+	report arm "${ARM_PREFIX}gcc" "${ARM_PREFIX}size" \
+		"-Os -std=c11 -mcpu=cortex-m33 -mthumb -mfloat-abi=hard -mfpu=fpv5-sp-d16 -ffunction-sections -fdata-sections"
+elif [ "$MODE" = check ] && grep -q "^arm " "$BASELINE"; then
+	echo "arm: ${ARM_PREFIX}gcc not found, the arm baseline in $BASELINE was NOT checked" >&2
+	FAILED=1
+else
+	echo "arm: ${ARM_PREFIX}gcc not found, skipped (no Cortex-M33 figures in this report)" >&2
+	# Lines not starting with a target name are ignored by --check; this one says why there is no arm line
+	echo "# arm: not measured, ${ARM_PREFIX}gcc was not found when this baseline was recorded" >> "$WORK/baseline"
+fi
+
+if [ "$MODE" = update ]; then
+	cp "$WORK/baseline" "$BASELINE"
+	echo "baseline written to $BASELINE"
+fi
+
+exit $FAILED
@@ -0,0 +1,100 @@
+/* ============================================================================================
+ * ms5611_altitude_check.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Checks MS5611_Altitude_Cm against the formula 44330.77 m * (1 - (p / p0)^0.190263)
+ * evaluated in double. Every whole-pascal pressure with p / p0 in 1/128 .. 2 is converted,
+ * for references of 1 to 30 kPa in 1 kPa steps and 30 to 120 kPa in 500 Pa steps.
+ *
+ * Prints the worst absolute error with its inputs, the number of conversions off by more
+ * than 1 cm, and the conversion time against powf. Exits non-zero if any conversion is
+ * off by more than 1 cm.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_altitude_check.c MS5611Altitude.c -lm -o ms5611_altitude_check
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "MS5611Altitude.h"
+
+#define CHECK_BOUND_CM    1.0
+#define CHECK_TIME_LOOPS  20000000L
+
+static double Check_Seconds(void){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double) t.tv_sec + (double) t.tv_nsec * 1e-9;
+}
+
+int main(void){
+	volatile int32_t sink = 0;
+	volatile float sinkf = 0.0f;
+	double worst = 0.0;
+	int32_t worstReference = 0, worstPressure = 0;
+	long cases = 0, over = 0;
+	double t0, fixed, reference;
+	int32_t ref, p;
+	long i;
+
+	for (ref = 1000; ref <= 120000; ref += (ref < 30000) ? 1000 : 500) {
+		uint64_t inverse = MS5611_Altitude_Inverse(ref);
+
+		for (p = (ref + 127) / 128; p < 2 * ref; p++) {
+			double exact = 4433077.0 * (1.0 - pow((double) p / ref, 0.190263));
+			double error = fabs(MS5611_Altitude_Cm(p, inverse) - exact);
+
+			cases++;
+			if (error > CHECK_BOUND_CM)
+				over++;
+			if (error > worst) {
+				worst = error;
+				worstReference = ref;
+				worstPressure = p;
+			}
+		}
+	}
+
+	printf("# %ld conversions, p / p0 in 1/128 .. 2, references 1..120 kPa\n", cases);
+	printf("# worst %.4f cm at p %d Pa, p0 %d Pa; %ld above %.1f cm\n",
+	       worst, worstPressure, worstReference, over, CHECK_BOUND_CM);
+
+	{
+		uint64_t inverse = MS5611_Altitude_Inverse(101325);
+
+		t0 = Check_Seconds();
+		for (i = 0; i < CHECK_TIME_LOOPS; i++)
+			sink = MS5611_Altitude_Cm(90000 + (int32_t) (i & 0x3FFF), inverse);
+		fixed = Check_Seconds() - t0;
+
+		t0 = Check_Seconds();
+		for (i = 0; i < CHECK_TIME_LOOPS; i++)
+			sinkf = 4433077.0f * (1.0f - powf((float) (90000 + (i & 0x3FFF)) / 101325.0f, 0.190263f));
+		reference = Check_Seconds() - t0;
+	}
+	(void) sink;
+	(void) sinkf;
+
+	printf("# MS5611_Altitude_Cm %.1f ns, powf %.1f ns per conversion\n",
+	       1e9 * fixed / CHECK_TIME_LOOPS, 1e9 * reference / CHECK_TIME_LOOPS);
+	printf("# %s\n", over ? "FAIL" : "PASS");
+
+	return over ? 1 : 0;
+}
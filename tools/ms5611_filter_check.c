@@ -0,0 +1,412 @@
+/* ============================================================================================
+ * ms5611_filter_check.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Checks the MS5611Filter glitch filter against a D1 stream with known faults. By default
+ * the signal is a constant word with gaussian noise, single-sample spikes of random sign and
+ * size, rail words (0 and 0xFFFFFF) and genuine level steps, all at known positions and
+ * apart from each other by more than the window. With -l the clean signal is the D1 column
+ * of a decoded MS5611Log file instead; spikes, sized against the noise estimated from the
+ * log, and rail words are injected into it the same way, and no steps are added.
+ *
+ * Prints per minimum threshold: spikes rejected, by size band, rail words replaced, false
+ * positives (clean samples flagged outside a step), the step delay (samples flagged after a
+ * step before the output follows it) and the time per MS5611_Glitch_Filter_Apply call: mean,
+ * 99.9th percentile and worst. A last row times a strictly descending ramp, which takes the
+ * most compare/move steps in both insertion sorts on every sample; on a host with branch
+ * prediction it is not the slowest input, on an in-order core the step count dominates.
+ * Times are TSC ticks on x86 and nanoseconds elsewhere, with the cost of reading the timer
+ * subtracted; the worst column includes preemption by the host scheduler.
+ *
+ * Exits non-zero if a rail word passes, a spike above 50 sigma and the threshold passes, or
+ * a step takes more than (W+1)/2 samples.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_filter_check.c MS5611Filter.c MS5611Log.c -lm -o ms5611_filter_check
+ *
+ * Usage: ms5611_filter_check [-l log]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CHECK_HAS_TSC     1
+#else
+#define CHECK_HAS_TSC     0
+#endif
+
+#include "MS5611Filter.h"
+#include "MS5611Log.h"
+#include "ms5611_tool_util.h"
+
+#define CHECK_SAMPLES     2000000L
+#define CHECK_LEVEL       8400000.0
+#define CHECK_NOISE       6.0       /**< Noise RMS, counts (about OSR 4096) */
+#define CHECK_SPACING     (4 * MS5611_GLITCH_WINDOW)
+#define CHECK_BANDS       4
+#define CHECK_TIME_BINS   65536     /**< Per-call time histogram, ticks; the last bin is open */
+
+enum { CHECK_CLEAN, CHECK_SPIKE, CHECK_RAIL, CHECK_STEP };
+
+/* Spike size bands, in noise sigmas */
+static const double checkBand[CHECK_BANDS + 1] = {5.0, 20.0, 50.0, 500.0, 5000.0};
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+static uint32_t checkTimeBins[CHECK_TIME_BINS];
+static uint64_t checkTimerOverhead;
+
+static inline uint64_t Check_Ticks(void){
+#if CHECK_HAS_TSC
+	return __rdtsc();
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t) t.tv_sec * 1000000000U + (uint64_t) t.tv_nsec;
+#endif
+}
+
+/* Smallest back-to-back timer reading, subtracted from every per-call time */
+static void Check_Timer_Calibrate(void){
+	uint64_t best = UINT64_MAX;
+	int i;
+
+	for (i = 0; i < 100000; i++) {
+		uint64_t t0 = Check_Ticks();
+		uint64_t t1 = Check_Ticks();
+
+		if (t1 - t0 < best)
+			best = t1 - t0;
+	}
+	checkTimerOverhead = best;
+}
+
+/* One timed filter call, the time goes into checkTimeBins */
+static uint8_t Check_Timed_Apply(MS5611_Glitch_Filter_TypeDef *filter, uint32_t *sample){
+	uint64_t t0 = Check_Ticks();
+	uint8_t quality = MS5611_Glitch_Filter_Apply(filter, sample);
+	uint64_t ticks = Check_Ticks() - t0;
+
+	ticks = (ticks > checkTimerOverhead) ? ticks - checkTimerOverhead : 0;
+	checkTimeBins[(ticks < CHECK_TIME_BINS) ? ticks : CHECK_TIME_BINS - 1]++;
+
+	return quality;
+}
+
+/* Prints mean, 99.9th percentile and worst of checkTimeBins, then clears it */
+static void Check_Time_Report(void){
+	uint64_t calls = 0, sum = 0, seen = 0;
+	uint32_t p999 = 0, worst = 0, b;
+
+	for (b = 0; b < CHECK_TIME_BINS; b++) {
+		calls += checkTimeBins[b];
+		sum += (uint64_t) b * checkTimeBins[b];
+	}
+	for (b = 0; b < CHECK_TIME_BINS; b++) {
+		if (checkTimeBins[b] == 0)
+			continue;
+		seen += checkTimeBins[b];
+		if (p999 == 0 && seen * 1000 >= calls * 999)
+			p999 = b;
+		worst = b;
+	}
+
+	printf("  %7.1f  %6u  %5u%s\n", calls ? (double) sum / calls : 0.0, p999, worst,
+	       (worst == CHECK_TIME_BINS - 1) ? "+" : "");
+	memset(checkTimeBins, 0, sizeof(checkTimeBins));
+}
+
+static int Check_Compare(const void *a, const void *b){
+	double x = *(const double *) a, y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief  Reads the D1 column of an MS5611Log file, skipping blocks that do not decode
+ * @param  path Log file
+ * @param  samples Pointer to store the number of words
+ * @param  noise Pointer to store the noise RMS estimated from sample-to-sample differences
+ * @retval uint32_t* D1 words, caller frees; NULL on error
+ */
+static uint32_t *Check_Load_Log(const char *path, long *samples, double *noise){
+	MS5611_Log_Header_TypeDef header;
+	uint32_t *d1 = NULL, *d2 = NULL;
+	uint8_t *data = NULL;
+	double *diff;
+	size_t offset, capacity;
+	long size, count = 0, i;
+	FILE *f = fopen(path, "rb");
+
+	if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < MS5611_LOG_HEADER_SIZE) {
+		fprintf(stderr, "%s: cannot read log\n", path);
+		goto fail;
+	}
+	rewind(f);
+	data = malloc((size_t) size);
+	if (data == NULL || fread(data, 1, (size_t) size, f) != (size_t) size ||
+	    MS5611_Log_Decode_Header(data, &header) != MS5611_LOG_OK) {
+		fprintf(stderr, "%s: bad log\n", path);
+		goto fail;
+	}
+
+	/* Every block holds at most MS5611_LOG_BLOCK_CAPACITY samples */
+	capacity = MS5611_LOG_BLOCK_CAPACITY(header.block_size);
+	d1 = malloc(((size_t) (size / header.block_size) + 1) * capacity * sizeof(uint32_t));
+	d2 = malloc(capacity * sizeof(uint32_t));
+	if (d1 == NULL || d2 == NULL)
+		goto fail;
+	for (offset = MS5611_LOG_HEADER_SIZE; offset + header.block_size <= (size_t) size; offset += header.block_size) {
+		uint32_t sequence;
+		uint16_t decoded;
+
+		if (MS5611_Log_Decode_Block(data + offset, header.block_size, &sequence, d1 + count, d2,
+		                            (uint16_t) capacity, &decoded) == MS5611_LOG_OK)
+			count += decoded;
+	}
+	if (count < 2 * CHECK_SPACING) {
+		fprintf(stderr, "%s: too few samples\n", path);
+		goto fail;
+	}
+
+	/* sigma = median |d[i] - d[i-1]| / (0.6745 * sqrt(2)) */
+	diff = malloc((size_t) count * sizeof(double));
+	if (diff == NULL)
+		goto fail;
+	for (i = 1; i < count; i++)
+		diff[i - 1] = fabs((double) d1[i] - (double) d1[i - 1]);
+	qsort(diff, (size_t) count - 1, sizeof(double), Check_Compare);
+	*noise = diff[(count - 1) / 2] / (0.6745 * 1.4142135623730951);
+	if (*noise < 0.5)
+		*noise = 0.5;
+	free(diff);
+
+	fclose(f);
+	free(data);
+	free(d2);
+	*samples = count;
+	return d1;
+
+fail:
+	if (f != NULL)
+		fclose(f);
+	free(data);
+	free(d1);
+	free(d2);
+	return NULL;
+}
+
+/**
+ * @brief  Builds the test stream: kind[i] tells what sample i is, size[i] the spike size in sigmas
+ * @param  base Clean words to inject faults into, or NULL for the synthetic signal
+ */
+static void Check_Signal(uint32_t *word, uint8_t *kind, double *size, long samples, const uint32_t *base, double noise){
+	double level = CHECK_LEVEL;
+	long i = 0;
+
+	while (i < samples) {
+		long run = CHECK_SPACING + (long) (Tool_Random(&rngState) % CHECK_SPACING);
+		double pick = Tool_Uniform(&rngState);
+		long k;
+
+		for (k = 0; k < run && i < samples; k++, i++) {
+			word[i] = base ? base[i] : (uint32_t) lround(level + noise * Tool_Gauss(&rngState));
+			kind[i] = CHECK_CLEAN;
+			size[i] = 0.0;
+		}
+		if (i >= samples)
+			break;
+
+		if (base != NULL)
+			level = base[i];
+
+		if (pick < 0.6 || (base != NULL && pick >= 0.7)) {
+			/* Log-uniform spike size across the bands, random sign */
+			double sigmas = checkBand[0] * pow(checkBand[CHECK_BANDS] / checkBand[0], Tool_Uniform(&rngState));
+			double sign = (Tool_Random(&rngState) & 1) ? 1.0 : -1.0;
+			double value = level + sign * sigmas * noise + (base ? 0.0 : noise * Tool_Gauss(&rngState));
+
+			word[i] = (value < 1.0) ? 1U : (value > MS5611_ADC_MAX - 1.0) ? MS5611_ADC_MAX - 1U : (uint32_t) lround(value);
+			kind[i] = CHECK_SPIKE;
+			size[i] = sigmas;
+		} else if (pick < 0.7) {
+			word[i] = (Tool_Random(&rngState) & 1) ? 0U : MS5611_ADC_MAX;
+			kind[i] = CHECK_RAIL;
+			size[i] = 0.0;
+		} else {
+			/* Genuine step of 100 to 5000 counts, the new level holds from here on */
+			level += ((Tool_Random(&rngState) & 1) ? 1.0 : -1.0) * (100.0 + 4900.0 * Tool_Uniform(&rngState));
+			word[i] = (uint32_t) lround(level + noise * Tool_Gauss(&rngState));
+			kind[i] = CHECK_STEP;
+			size[i] = 0.0;
+		}
+		i++;
+	}
+}
+
+static int Check_Run(const uint32_t *word, const uint8_t *kind, const double *size, long samples,
+                     double noise, uint32_t min_threshold){
+	MS5611_Glitch_Filter_TypeDef filter;
+	uint32_t spikes[CHECK_BANDS] = {0};
+	uint32_t rejected[CHECK_BANDS] = {0};
+	uint32_t rails = 0, railsReplaced = 0;
+	uint32_t clean = 0, falsePositives = 0;
+	uint32_t steps = 0, stepDelaySum = 0, stepDelayMax = 0;
+	uint32_t missedLarge = 0;
+	long i;
+	uint8_t b;
+
+	MS5611_Glitch_Filter_Init(&filter, min_threshold, MS5611_GLITCH_MEDIAN);
+
+	for (i = 0; i < samples; i++) {
+		uint32_t sample = word[i];
+		uint8_t quality = Check_Timed_Apply(&filter, &sample);
+		uint8_t flagged = (quality & MS5611_QUALITY_OUTLIER) != 0;
+
+		if (quality & MS5611_QUALITY_WARMUP)
+			continue;
+
+		switch (kind[i]) {
+		case CHECK_SPIKE:
+			for (b = 0; b < CHECK_BANDS - 1 && size[i] >= checkBand[b + 1]; b++)
+				;
+			spikes[b]++;
+			rejected[b] += flagged;
+			if (!flagged && size[i] >= 50.0 && size[i] * noise > 2.0 * min_threshold)
+				missedLarge++;
+			break;
+
+		case CHECK_RAIL:
+			rails++;
+			railsReplaced += (quality & MS5611_QUALITY_REPLACED) ? 1U : 0U;
+			break;
+
+		case CHECK_STEP: {
+			/* Samples flagged from the step on, until the first one accepted */
+			uint32_t delay = 0;
+
+			while (flagged) {
+				delay++;
+				if (i + 1 >= samples || kind[i + 1] != CHECK_CLEAN)
+					break;
+				sample = word[++i];
+				flagged = (Check_Timed_Apply(&filter, &sample) & MS5611_QUALITY_OUTLIER) != 0;
+			}
+			steps++;
+			stepDelaySum += delay;
+			if (delay > stepDelayMax)
+				stepDelayMax = delay;
+			break;
+		}
+
+		default:
+			clean++;
+			falsePositives += flagged;
+			break;
+		}
+	}
+
+	printf("%13u", min_threshold);
+	for (b = 0; b < CHECK_BANDS; b++)
+		printf("  %6.2f%%", spikes[b] ? 100.0 * rejected[b] / spikes[b] : 0.0);
+	printf("  %4u/%-4u  %9u  %8.1f  %10.2f  %4u", railsReplaced, rails, falsePositives,
+	       clean ? 1e6 * falsePositives / clean : 0.0, steps ? (double) stepDelaySum / steps : 0.0, stepDelayMax);
+	Check_Time_Report();
+
+	return (railsReplaced != rails || missedLarge != 0 || stepDelayMax > (MS5611_GLITCH_WINDOW + 1) / 2) ? 1 : 0;
+}
+
+/* Strictly descending words: every window arrives reverse-sorted, the insertion sort worst case */
+static void Check_Worst_Case(long samples){
+	MS5611_Glitch_Filter_TypeDef filter;
+	long i;
+
+	MS5611_Glitch_Filter_Init(&filter, 0, MS5611_GLITCH_MEDIAN);
+	for (i = 0; i < samples; i++) {
+		uint32_t sample = (uint32_t) (MS5611_ADC_MAX - 1 - (i % (MS5611_ADC_MAX - 2)));
+
+		Check_Timed_Apply(&filter, &sample);
+	}
+
+	printf("%-13s  %-95s", "ramp", "(descending ramp, most sort steps on every sample)");
+	Check_Time_Report();
+}
+
+int main(int argc, char **argv){
+	static const uint32_t thresholds[] = {0, 10, 20, 40, 80};
+	const char *logPath = NULL;
+	uint32_t *base = NULL;
+	long samples = CHECK_SAMPLES;
+	double noise = CHECK_NOISE;
+	uint32_t *word;
+	uint8_t *kind;
+	double *size;
+	int failed = 0;
+	int opt;
+	size_t t;
+	uint8_t b;
+
+	while ((opt = getopt(argc, argv, "l:")) != -1) {
+		switch (opt) {
+		case 'l': logPath = optarg; break;
+		default:
+			fprintf(stderr, "usage: %s [-l log]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (logPath != NULL && (base = Check_Load_Log(logPath, &samples, &noise)) == NULL)
+		return 1;
+
+	word = malloc((size_t) samples * sizeof(uint32_t));
+	kind = malloc((size_t) samples);
+	size = malloc((size_t) samples * sizeof(double));
+	if (word == NULL || kind == NULL || size == NULL)
+		return 1;
+
+	Check_Signal(word, kind, size, samples, base, noise);
+	Check_Timer_Calibrate();
+
+	printf("# window %u, k*1.4826 %.4f, noise %.1f counts rms, %ld samples, median replacement\n",
+	       MS5611_GLITCH_WINDOW, MS5611_GLITCH_K_Q4 / 16.0, noise, samples);
+	printf("# signal: %s\n", logPath ? logPath : "synthetic (constant level, gaussian noise, steps)");
+	printf("# spike rejection by size band (sigmas):");
+	for (b = 0; b < CHECK_BANDS; b++)
+		printf(" [%g,%g)", checkBand[b], checkBand[b + 1]);
+	printf("\n# time per call in %s, timer overhead of %llu subtracted\n", CHECK_HAS_TSC ? "TSC ticks" : "ns",
+	       (unsigned long long) checkTimerOverhead);
+	printf("# min_threshold    band0    band1    band2    band3  rails      false_pos       ppm  step_delay   max"
+	       "     mean   p99.9  worst\n");
+
+	for (t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++)
+		failed |= Check_Run(word, kind, size, samples, noise, thresholds[t]);
+	Check_Worst_Case(samples);
+
+	printf("# %s\n", failed ? "FAIL" : "PASS");
+
+	free(word);
+	free(kind);
+	free(size);
+	free(base);
+	return failed;
+}
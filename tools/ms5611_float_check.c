@@ -0,0 +1,177 @@
+/* ============================================================================================
+ * ms5611_float_check.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Characterizes MS5611_Compensate_Float against the integer reference and an exact
+ * double-precision evaluation of the same formula without flooring, and times both
+ * representations: int64 reference, 32-bit path, each followed by the conversion to float,
+ * and the direct float path.
+ *
+ * Inputs are realistic: PROM words within +-30 % of the datasheet example, temperatures
+ * -40..85 degC, pressures 10..1200 mbar, D1/D2 obtained by inverting the formula.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_float_check.c MS5611Compensate.c -lm -o ms5611_float_check
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "MS5611Compensate.h"
+#include "ms5611_tool_util.h"
+
+#define CHECK_CASES     4000000L
+#define CHECK_SET       4096
+
+static uint64_t rngState = 0x2545F4914F6CDD1DULL;
+
+static double Check_Uniform(double lo, double hi){
+	return lo + (hi - lo) * Tool_Uniform(&rngState);
+}
+
+static void Check_Case(struct promData *prom, MS5611_Raw_Data_TypeDef *sample){
+	static const uint16_t typical[6] = {40127, 36924, 23317, 23282, 33464, 28312};
+	double temp = Check_Uniform(-4000.0, 8500.0);
+	double pressure = Check_Uniform(1000.0, 120000.0);
+	double dT, off, sens;
+
+	prom->reserved = 0;
+	prom->sens = (uint16_t) (typical[0] * Check_Uniform(0.7, 1.3));
+	prom->off = (uint16_t) (typical[1] * Check_Uniform(0.7, 1.3));
+	prom->tcs = (uint16_t) (typical[2] * Check_Uniform(0.7, 1.3));
+	prom->tco = (uint16_t) (typical[3] * Check_Uniform(0.7, 1.3));
+	prom->tref = (uint16_t) (typical[4] * Check_Uniform(0.7, 1.3));
+	prom->tempsens = (uint16_t) (typical[5] * Check_Uniform(0.7, 1.3));
+	prom->crc = 0;
+
+	/* First-order inversion is close enough to land in the wanted range */
+	dT = (temp - 2000.0) * 8388608.0 / prom->tempsens;
+	off = prom->off * 65536.0 + prom->tco * dT / 128.0;
+	sens = prom->sens * 32768.0 + prom->tcs * dT / 256.0;
+	sample->temperature = (uint32_t) (prom->tref * 256.0 + dT);
+	sample->pressure = (uint32_t) ((pressure * 32768.0 + off) * 2097152.0 / sens);
+}
+
+/* Same formula in double without flooring: the value the integer code approximates */
+static void Check_Exact(const struct promData *prom, const MS5611_Raw_Data_TypeDef *sample, double *p, double *t){
+	double dT = (double) (int32_t) (sample->temperature - ((int32_t) (prom->tref << 8)));
+	double TEMP = 2000.0 + dT * prom->tempsens / 8388608.0;
+	double OFF = prom->off * 65536.0 + prom->tco * dT / 128.0;
+	double SENS = prom->sens * 32768.0 + prom->tcs * dT / 256.0;
+
+	if (TEMP < 2000.0) {
+		double TEMPM2 = (TEMP - 2000.0) * (TEMP - 2000.0);
+		double OFF2 = 2.5 * TEMPM2;
+		double SENS2 = 1.25 * TEMPM2;
+		if (TEMP < -1500.0) {
+			OFF2 += 7.0 * (TEMP + 1500.0) * (TEMP + 1500.0);
+			SENS2 += 5.5 * (TEMP + 1500.0) * (TEMP + 1500.0);
+		}
+		TEMP -= dT * dT / 2147483648.0;
+		OFF -= OFF2;
+		SENS -= SENS2;
+	}
+
+	*p = (sample->pressure * SENS / 2097152.0 - OFF) / 32768.0;
+	*t = TEMP / 100.0;
+}
+
+static double Check_Seconds(void){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double) t.tv_sec + (double) t.tv_nsec * 1e-9;
+}
+
+int main(void){
+	static struct promData proms[CHECK_SET];
+	static MS5611_Raw_Data_TypeDef samples[CHECK_SET];
+	double maxRefP = 0, maxRefT = 0, maxExactP = 0, maxExactT = 0;
+	double sumRefP = 0, sumExactP = 0, sqExactP = 0;
+	volatile float sink = 0.0f;
+	long n;
+	int mode;
+
+	for (n = 0; n < CHECK_CASES; n++) {
+		struct promData prom;
+		MS5611_Raw_Data_TypeDef sample;
+		MS5611_Converted_Data_TypeDef ref;
+		MS5611_Float_Data_TypeDef f;
+		double p, t, e;
+
+		Check_Case(&prom, &sample);
+		MS5611_Compensate(&prom, &sample, &ref);
+		MS5611_Compensate_Float(&prom, &sample, &f);
+		Check_Exact(&prom, &sample, &p, &t);
+
+		e = f.pressure - ref.pressure;
+		sumRefP += e;
+		if (fabs(e) > maxRefP)
+			maxRefP = fabs(e);
+		e = f.temperature - ref.temperature / 100.0;
+		if (fabs(e) > maxRefT)
+			maxRefT = fabs(e);
+
+		e = f.pressure - p;
+		sumExactP += e;
+		sqExactP += e * e;
+		if (fabs(e) > maxExactP)
+			maxExactP = fabs(e);
+		e = f.temperature - t;
+		if (fabs(e) > maxExactT)
+			maxExactT = fabs(e);
+	}
+
+	printf("accuracy over %ld cases (-40..85 degC, 10..1200 mbar, PROM +-30 %%)\n", CHECK_CASES);
+	printf("float vs integer reference: pressure mean %+.3f Pa, max |err| %.3f Pa; temperature max |err| %.4f degC\n",
+	       sumRefP / CHECK_CASES, maxRefP, maxRefT);
+	printf("float vs exact (unfloored): pressure mean %+.4f Pa, rms %.4f Pa, max |err| %.4f Pa; temperature max |err| %.5f degC\n",
+	       sumExactP / CHECK_CASES, sqrt(sqExactP / CHECK_CASES), maxExactP, maxExactT);
+
+	for (n = 0; n < CHECK_SET; n++)
+		Check_Case(&proms[n], &samples[n]);
+
+	printf("\npath,ns_per_sample\n");
+	for (mode = 0; mode < 3; mode++) {
+		static const char *names[3] = {"int64+to_float", "int32+to_float", "float"};
+		double t0 = Check_Seconds();
+
+		for (n = 0; n < CHECK_CASES; n++) {
+			const struct promData *prom = &proms[n & (CHECK_SET - 1)];
+			const MS5611_Raw_Data_TypeDef *sample = &samples[n & (CHECK_SET - 1)];
+			MS5611_Converted_Data_TypeDef ref;
+			MS5611_Float_Data_TypeDef f;
+
+			if (mode == 0) {
+				MS5611_Compensate(prom, sample, &ref);
+				MS5611_Converted_To_Float(&ref, &f);
+			} else if (mode == 1) {
+				MS5611_Compensate_Int32(prom, sample, &ref);
+				MS5611_Converted_To_Float(&ref, &f);
+			} else {
+				MS5611_Compensate_Float(prom, sample, &f);
+			}
+			sink += f.pressure;
+		}
+
+		printf("%s,%.2f\n", names[mode], (Check_Seconds() - t0) * 1e9 / CHECK_CASES);
+	}
+
+	return 0;
+}
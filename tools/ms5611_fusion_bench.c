@@ -0,0 +1,78 @@
+/* ============================================================================================
+ * ms5611_fusion_bench.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Host benchmark of MS5611_Fusion_Update for N = 2..MS5611_FUSION_MAX_SENSORS sensors.
+ * Sensors sample round-robin with noise; sensor 1 fails (constant offset, high and then low
+ * in a second run) half-way through. Prints CSV: sensors, fault offset in Pa, ns per fusion
+ * step, mean |error| in Pa over the faulty half, exclusions of the failed and a good sensor.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_fusion_bench.c MS5611Fusion.c -o ms5611_fusion_bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "MS5611Fusion.h"
+#include "ms5611_tool_util.h"
+
+#define BENCH_STEPS       2000000L
+#define BENCH_PERIOD      1000U     /**< Ticks between samples of one sensor */
+#define BENCH_FAULT       800       /**< Offset of the failed sensor, Pa */
+
+int main(void){
+	MS5611_Fusion_TypeDef fusion;
+	struct timespec t0, t1;
+	uint8_t sensors;
+	int32_t fault;
+
+	printf("sensors,fault_pa,ns_per_step,mean_abs_error_pa,failed_sensor_exclusions,good_sensor_exclusions\n");
+
+	for (sensors = 2; sensors <= MS5611_FUSION_MAX_SENSORS; sensors++)
+	for (fault = BENCH_FAULT; fault >= -BENCH_FAULT; fault -= 2 * BENCH_FAULT) {
+		uint32_t rng = 12345;
+		double errorSum = 0.0;
+		int32_t fused = 0;
+		long step;
+
+		MS5611_Fusion_Init(&fusion, sensors, 4 * BENCH_PERIOD, 30);
+
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (step = 0; step < BENCH_STEPS; step++) {
+			uint8_t sensor = (uint8_t) (step % sensors);
+			uint32_t stamp = (uint32_t) (step * BENCH_PERIOD / sensors);
+			int32_t truth = 100000 - (int32_t) (step / 1000);
+			int32_t pressure = truth + (int32_t) (Tool_Random32(&rng) % 13) - 6;
+
+			if (sensor == 1 && step > BENCH_STEPS / 2)
+				pressure += fault;
+
+			MS5611_Fusion_Update(&fusion, sensor, pressure, stamp, &fused);
+			if (step > BENCH_STEPS / 2)
+				errorSum += labs((long) (fused - truth));
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		printf("%u,%+d,%.1f,%.2f,%u,%u\n", sensors, fault,
+		       ((double) (t1.tv_sec - t0.tv_sec) * 1e9 + (double) (t1.tv_nsec - t0.tv_nsec)) / BENCH_STEPS,
+		       errorSum / (BENCH_STEPS / 2), fusion.channel[1].exclusions, fusion.channel[0].exclusions);
+	}
+
+	return 0;
+}
@@ -0,0 +1,340 @@
+/* ============================================================================================
+ * ms5611_hub_check.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Checks MS5611Hub. Every published entry is derived from its sequence number, so any entry
+ * a consumer copies can be checked for tearing on its own.
+ *
+ *   policies   one thread, consumers drained between small bursts: the MS5611_HUB_ALL,
+ *              MS5611_HUB_DECIMATE and MS5611_HUB_AVERAGE outputs must match a reference
+ *              computed from the published sequence, invalid samples left out of averages
+ *   overflow   one thread: a consumer 3 rings behind must catch up with exactly one overflow
+ *              and lose exactly the entries it skipped; an entry overwritten between Peek and
+ *              Release must be reported by Release and counted in lost
+ *   threads    a producer thread publishes as fast as it can while a consumer thread, pausing
+ *              at random, runs a Peek/Release cursor and one Read cursor per policy. No entry
+ *              accepted as intact may be torn, outputs must follow the policy, and when the
+ *              consumer has drained, delivered, lost and pending must account for every
+ *              published sample on every cursor. Overwrites must actually have happened.
+ *
+ * Exits non-zero on any mismatch.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -pthread -I. tools/ms5611_hub_check.c MS5611Hub.c -o ms5611_hub_check
+ *
+ * Usage: ms5611_hub_check [samples]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "MS5611Hub.h"
+#include "ms5611_tool_util.h"
+
+#define CHECK_SAMPLES     2000000U
+#define CHECK_DECIMATE    4
+#define CHECK_AVERAGE     5
+#define CHECK_BURST       8         /**< Samples per burst in the policy check, below MS5611_HUB_DEPTH */
+#define CHECK_BURST_PERIOD 4096     /**< Samples between producer bursts in the thread check */
+
+enum { CHECK_PEEK, CHECK_ALL, CHECK_DECIMATED, CHECK_AVERAGED, CHECK_CURSORS };
+
+static const char *const checkCursorName[CHECK_CURSORS] = {"peek/release", "read all", "read decimate", "read average"};
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+/* Fills every field from the sequence; every 97th sample is invalid when invalid is set */
+static void Check_Entry(uint32_t sequence, uint8_t invalid, MS5611_Raw_Data_TypeDef *raw, MS5611_Sample_TypeDef *sample){
+	raw->pressure = sequence & 0xFFFFFFU;
+	raw->temperature = (sequence * 2654435761U) & 0xFFFFFFU;
+	sample->value.pressure = (int32_t) (sequence & 0x3FFFFFFFU);
+	sample->value.temperature = (int32_t) ((sequence * 3U) & 0x3FFFFFFFU);
+	sample->stamp = sequence * 7U;
+	sample->d2_age = ~sequence;
+	sample->sequence = sequence;
+	sample->osr = (uint8_t) sequence;
+	sample->flags = (invalid && sequence % 97 == 0) ? MS5611_SAMPLE_INVALID : (sequence % 5 == 0) ? MS5611_SAMPLE_GLITCH : 0;
+	sample->retries = (uint8_t) (sequence >> 8);
+	sample->reserved = 0;
+}
+
+/* An entry is consistent when every field matches its sequence; value is not checked for averages */
+static uint8_t Check_Consistent(const MS5611_Hub_Entry_TypeDef *entry, uint8_t invalid, uint8_t averaged){
+	MS5611_Raw_Data_TypeDef raw;
+	MS5611_Sample_TypeDef sample;
+
+	Check_Entry(entry->sample.sequence, invalid, &raw, &sample);
+
+	return raw.pressure == entry->raw.pressure && raw.temperature == entry->raw.temperature &&
+	       (averaged || memcmp(&sample.value, &entry->sample.value, sizeof(sample.value)) == 0) &&
+	       sample.stamp == entry->sample.stamp && sample.d2_age == entry->sample.d2_age &&
+	       sample.osr == entry->sample.osr && (averaged || sample.flags == entry->sample.flags) &&
+	       sample.retries == entry->sample.retries;
+}
+
+static void Check_Publish(MS5611_Hub_TypeDef *hub, uint32_t sequence, uint8_t invalid){
+	MS5611_Raw_Data_TypeDef raw;
+	MS5611_Sample_TypeDef sample;
+
+	Check_Entry(sequence, invalid, &raw, &sample);
+	MS5611_Hub_Publish(hub, &raw, &sample);
+}
+
+static int Check_Policies(void){
+	static MS5611_Hub_TypeDef hub;
+	MS5611_Hub_Subscriber_TypeDef all, decimated, averaged;
+	MS5611_Hub_Entry_TypeDef out;
+	uint32_t published = 0, nextAll = 0, nextDecimated = CHECK_DECIMATE - 1, lastAveraged = 0;
+	uint32_t outputs[3] = {0};
+	int64_t pressureSum = 0, temperatureSum = 0;
+	uint8_t flags = 0, pending = 0;
+	int errors = 0;
+	uint32_t burst, k;
+
+	MS5611_Hub_Init(&hub);
+	MS5611_Hub_Subscribe(&hub, &all, MS5611_HUB_ALL, 0);
+	MS5611_Hub_Subscribe(&hub, &decimated, MS5611_HUB_DECIMATE, CHECK_DECIMATE);
+	MS5611_Hub_Subscribe(&hub, &averaged, MS5611_HUB_AVERAGE, CHECK_AVERAGE);
+
+	for (burst = 0; burst < 10000; burst++) {
+		for (k = 0; k < CHECK_BURST; k++)
+			Check_Publish(&hub, published++, 1);
+
+		while (MS5611_Hub_Read(&hub, &all, &out)) {
+			errors += out.sample.sequence != nextAll++ || !Check_Consistent(&out, 1, 0);
+			outputs[0]++;
+		}
+		while (MS5611_Hub_Read(&hub, &decimated, &out)) {
+			errors += out.sample.sequence != nextDecimated || !Check_Consistent(&out, 1, 0);
+			nextDecimated += CHECK_DECIMATE;
+			outputs[1]++;
+		}
+
+		/* Reference average over the valid samples of this burst, in publication order */
+		for (k = published - CHECK_BURST; k < published; k++) {
+			MS5611_Raw_Data_TypeDef raw;
+			MS5611_Sample_TypeDef sample;
+
+			Check_Entry(k, 1, &raw, &sample);
+			if (sample.flags & MS5611_SAMPLE_INVALID)
+				continue;
+			pressureSum += sample.value.pressure;
+			temperatureSum += sample.value.temperature;
+			flags |= sample.flags;
+			if (++pending < CHECK_AVERAGE)
+				continue;
+
+			if (!MS5611_Hub_Read(&hub, &averaged, &out) || out.sample.sequence != k || !Check_Consistent(&out, 1, 1) ||
+			    out.sample.value.pressure != (int32_t) (pressureSum / CHECK_AVERAGE) ||
+			    out.sample.value.temperature != (int32_t) (temperatureSum / CHECK_AVERAGE) || out.sample.flags != flags)
+				errors++;
+			lastAveraged = k;
+			pressureSum = temperatureSum = 0;
+			flags = pending = 0;
+			outputs[2]++;
+		}
+		errors += MS5611_Hub_Read(&hub, &averaged, &out);
+	}
+
+	errors += all.lost + decimated.lost + averaged.lost + all.overflows + decimated.overflows + averaged.overflows;
+	printf("policies: %u published, %u all, %u decimate/%d, %u average/%d (last %u), %s\n", published, outputs[0],
+	       outputs[1], CHECK_DECIMATE, outputs[2], CHECK_AVERAGE, lastAveraged, errors ? "FAIL" : "ok");
+
+	return errors != 0;
+}
+
+static int Check_Overflow(void){
+	static MS5611_Hub_TypeDef hub;
+	MS5611_Hub_Subscriber_TypeDef sub;
+	const MS5611_Hub_Entry_TypeDef *entry;
+	uint32_t published = 3 * MS5611_HUB_DEPTH + 5, intact = 0, sequence, k;
+	int errors = 0;
+
+	MS5611_Hub_Init(&hub);
+	MS5611_Hub_Subscribe(&hub, &sub, MS5611_HUB_ALL, 0);
+	for (k = 0; k < published; k++)
+		Check_Publish(&hub, k, 0);
+
+	/* The catch-up lands on the oldest entry that cannot be mid-write */
+	sequence = published - (MS5611_HUB_DEPTH - 1);
+	while ((entry = MS5611_Hub_Peek(&hub, &sub)) != NULL) {
+		errors += entry->sample.sequence != sequence++ || !Check_Consistent(entry, 0, 0);
+		intact += MS5611_Hub_Release(&hub, &sub);
+	}
+	errors += sub.overflows != 1 || sub.lost != published - (MS5611_HUB_DEPTH - 1) ||
+	          intact != MS5611_HUB_DEPTH - 1 || sub.delivered != intact;
+
+	/* Overwritten between Peek and Release */
+	Check_Publish(&hub, published++, 0);
+	entry = MS5611_Hub_Peek(&hub, &sub);
+	for (k = 0; k < MS5611_HUB_DEPTH; k++)
+		Check_Publish(&hub, published++, 0);
+	errors += entry == NULL || MS5611_Hub_Release(&hub, &sub) != 0 || sub.lost != published - MS5611_HUB_DEPTH - intact;
+
+	printf("overflow: %u published, %u overflow, %u lost, %u delivered, %s\n", published, sub.overflows, sub.lost,
+	       sub.delivered, errors ? "FAIL" : "ok");
+
+	return errors != 0;
+}
+
+typedef struct {
+	MS5611_Hub_TypeDef hub;
+	uint32_t samples;
+	volatile uint32_t progress;   /**< Peek/Release cursor, paces the producer outside bursts */
+	volatile int done;
+} Check_Shared_TypeDef;
+
+static void *Check_Producer(void *arg){
+	Check_Shared_TypeDef *shared = arg;
+	uint32_t k;
+
+	/* Stays within half a ring of the consumer, except for a burst of 3 rings every
+	 * CHECK_BURST_PERIOD samples that forces overwrites even on a single core */
+	for (k = 0; k < shared->samples; k++) {
+		if (k % CHECK_BURST_PERIOD >= 3 * MS5611_HUB_DEPTH)
+			while (k - __atomic_load_n(&shared->progress, __ATOMIC_ACQUIRE) > MS5611_HUB_DEPTH / 2)
+				sched_yield();
+		Check_Publish(&shared->hub, k, 0);
+	}
+	__atomic_store_n(&shared->done, 1, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+
+/* Random pause inside a read, so bursts also land between Peek and Release */
+static void Check_Pause(void){
+	uint64_t r = Tool_Random(&rngState);
+
+	if ((r & 0xFF) == 0) {
+		struct timespec pause = {0, 20000 + (long) ((r >> 8) % 100000)};
+
+		nanosleep(&pause, NULL);
+	} else if ((r & 0xF) == 0) {
+		sched_yield();
+	}
+}
+
+static int Check_Threads(uint32_t samples){
+	static Check_Shared_TypeDef shared;
+	MS5611_Hub_Subscriber_TypeDef sub[CHECK_CURSORS];
+	uint32_t start[CHECK_CURSORS], previous[CHECK_CURSORS];
+	uint32_t torn = 0, overwritten = 0, rejected = 0, errors = 0;
+	pthread_t producer;
+	uint8_t first[CHECK_CURSORS];
+	int drained = 0, c;
+
+	MS5611_Hub_Init(&shared.hub);
+	shared.samples = samples;
+	shared.progress = 0;
+	shared.done = 0;
+	MS5611_Hub_Subscribe(&shared.hub, &sub[CHECK_PEEK], MS5611_HUB_ALL, 0);
+	MS5611_Hub_Subscribe(&shared.hub, &sub[CHECK_ALL], MS5611_HUB_ALL, 0);
+	MS5611_Hub_Subscribe(&shared.hub, &sub[CHECK_DECIMATED], MS5611_HUB_DECIMATE, CHECK_DECIMATE);
+	MS5611_Hub_Subscribe(&shared.hub, &sub[CHECK_AVERAGED], MS5611_HUB_AVERAGE, CHECK_AVERAGE);
+	for (c = 0; c < CHECK_CURSORS; c++) {
+		start[c] = sub[c].cursor;
+		previous[c] = 0;
+		first[c] = 1;
+	}
+
+	if (pthread_create(&producer, NULL, Check_Producer, &shared) != 0) {
+		fprintf(stderr, "pthread_create failed\n");
+		return 1;
+	}
+
+	/* One more pass after the producer is done drains every cursor */
+	while (!drained) {
+		const MS5611_Hub_Entry_TypeDef *entry;
+		MS5611_Hub_Entry_TypeDef out;
+
+		drained = __atomic_load_n(&shared.done, __ATOMIC_ACQUIRE);
+
+		while ((entry = MS5611_Hub_Peek(&shared.hub, &sub[CHECK_PEEK])) != NULL) {
+			uint32_t cursor = sub[CHECK_PEEK].cursor;
+			MS5611_Hub_Entry_TypeDef copy = *entry;
+
+			if (!drained)
+				Check_Pause();
+			if (MS5611_Hub_Release(&shared.hub, &sub[CHECK_PEEK])) {
+				torn += copy.sample.sequence != cursor || !Check_Consistent(&copy, 0, 0);
+			} else {
+				overwritten++;
+				rejected += !Check_Consistent(&copy, 0, 0);
+			}
+			__atomic_store_n(&shared.progress, sub[CHECK_PEEK].cursor, __ATOMIC_RELEASE);
+		}
+
+		for (c = CHECK_ALL; c < CHECK_CURSORS; c++) {
+			while (MS5611_Hub_Read(&shared.hub, &sub[c], &out)) {
+				uint32_t sequence = out.sample.sequence;
+
+				torn += !Check_Consistent(&out, 0, c == CHECK_AVERAGED);
+				if (!first[c] && sequence <= previous[c])
+					errors++;
+				/* An average only takes samples after the previous output, up to its last */
+				if (c == CHECK_AVERAGED && ((uint32_t) out.sample.value.pressure > sequence ||
+				                            (!first[c] && (uint32_t) out.sample.value.pressure <= previous[c])))
+					errors++;
+				previous[c] = sequence;
+				first[c] = 0;
+				if (!drained)
+					Check_Pause();
+			}
+		}
+		sched_yield();
+	}
+	pthread_join(producer, NULL);
+
+	printf("threads: %u published, depth %u\n", samples, MS5611_HUB_DEPTH);
+	for (c = 0; c < CHECK_CURSORS; c++) {
+		uint32_t factor = (c == CHECK_DECIMATED) ? CHECK_DECIMATE : (c == CHECK_AVERAGED) ? CHECK_AVERAGE : 1;
+		uint32_t accounted = sub[c].delivered * factor + sub[c].pending + sub[c].lost;
+
+		errors += sub[c].cursor != samples || accounted != samples - start[c];
+		printf("  %-14s %9u delivered %9u lost %7u overflows %2u pending, %s\n", checkCursorName[c], sub[c].delivered,
+		       sub[c].lost, sub[c].overflows, sub[c].pending, (accounted == samples - start[c]) ? "accounted" : "MISMATCH");
+	}
+	printf("  overwritten between Peek and Release %u (torn %u), torn entries accepted %u\n", overwritten, rejected, torn);
+
+	/* The run must have exercised both the seqlock check and the catch-up */
+	errors += torn;
+	errors += sub[CHECK_PEEK].overflows == 0 || sub[CHECK_PEEK].lost == 0;
+	printf("threads: %s\n", errors ? "FAIL" : "ok");
+
+	return errors != 0;
+}
+
+int main(int argc, char **argv){
+	uint32_t samples = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : CHECK_SAMPLES;
+	int failed = 0;
+
+	if (argc > 2 || samples == 0) {
+		fprintf(stderr, "usage: %s [samples]\n", argv[0]);
+		return 2;
+	}
+
+	failed |= Check_Policies();
+	failed |= Check_Overflow();
+	failed |= Check_Threads(samples);
+
+	printf("# %s\n", failed ? "FAIL" : "PASS");
+	return failed;
+}
@@ -0,0 +1,242 @@
+/* ============================================================================================
+ * ms5611_log_bench.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Encodes reference traces with MS5611Log and reports the compression ratio and the encode
+ * cost. Each trace is raw D1/D2 from the datasheet example calibration at the fastest rate
+ * of its OSR: 1000 hPa with a 30 m altitude swing every 10 minutes, 25 degC with a slow
+ * drift, and gaussian noise sized to the datasheet RMS resolution, quantized to whole
+ * counts. The "dec" rows repeat D2 for 7 of 8 samples, as temperature decimation does.
+ *
+ * Per trace it prints the log size against plain uint32_t pairs (8 bytes per sample) and
+ * packed 24-bit pairs (6 bytes), the encode time per sample including block CRCs and the
+ * write callback, and on x86 the TSC ticks per sample. Every log is decoded back and
+ * compared; any difference makes the exit status non-zero.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_log_bench.c MS5611Log.c MS5611Compensate.c -lm -o ms5611_log_bench
+ *
+ * Usage: ms5611_log_bench [-n samples] [-r seed]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC     1
+#else
+#define BENCH_HAS_TSC     0
+#endif
+
+#include "MS5611Compensate.h"
+#include "MS5611Log.h"
+#include "ms5611_tool_util.h"
+
+#define BENCH_OSR_COUNT      5
+#define BENCH_DECIMATION     8
+#define BENCH_ENCODE_RUNS    5     /**< Encode passes per trace, the fastest is reported */
+
+/* Mirrors MS5611_OSR_* and the datasheet RMS resolution, as in ms5611_osr_bench */
+static const struct {
+	const char *name;
+	uint8_t code;
+	uint32_t conversion_us;
+	double pressure_rms_pa;
+	double temperature_rms_c;
+} benchOsr[BENCH_OSR_COUNT] = {
+	{"256",  0x00,  600, 6.5, 0.012},
+	{"512",  0x02, 1170, 4.2, 0.008},
+	{"1024", 0x04, 2280, 2.7, 0.005},
+	{"2048", 0x06, 4540, 1.8, 0.003},
+	{"4096", 0x08, 9040, 1.2, 0.002},
+};
+
+static const struct promData benchProm = {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+
+static uint64_t rngState;
+
+/* Growing output buffer behind the encoder's write callback */
+typedef struct {
+	uint8_t *data;
+	size_t used;
+	size_t capacity;
+} Bench_Output_TypeDef;
+
+static int Bench_Write(void *context, const uint8_t *data, uint32_t length){
+	Bench_Output_TypeDef *out = (Bench_Output_TypeDef *) context;
+
+	if (out->used + length > out->capacity)
+		return -1;
+	memcpy(out->data + out->used, data, length);
+	out->used += length;
+
+	return 0;
+}
+
+static double Bench_Seconds(void){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double) t.tv_sec + (double) t.tv_nsec * 1e-9;
+}
+
+/* Raw words through the first-order inverse of the datasheet compensation (valid above 20 degC) */
+static void Bench_Trace(uint32_t *d1, uint32_t *d2, long samples, int osr, uint32_t decimation){
+	double rate = 1e6 / (2.0 * benchOsr[osr].conversion_us);
+	long i;
+
+	for (i = 0; i < samples; i++) {
+		double seconds = (double) i / rate;
+		double temperature = 2500.0 + 150.0 * sin(6.283185307179586 * seconds / 3600.0) +
+		                     100.0 * benchOsr[osr].temperature_rms_c * Tool_Gauss(&rngState);
+		double pressure = 100000.0 + 360.0 * sin(6.283185307179586 * seconds / 600.0) +
+		                  benchOsr[osr].pressure_rms_pa * Tool_Gauss(&rngState);
+		double dT = (temperature - 2000.0) * 8388608.0 / benchProm.tempsens;
+		double off = benchProm.off * 65536.0 + benchProm.tco * dT / 128.0;
+		double sens = benchProm.sens * 32768.0 + benchProm.tcs * dT / 256.0;
+
+		d1[i] = (uint32_t) llround((pressure * 32768.0 + off) * 2097152.0 / sens);
+		d2[i] = (i % decimation == 0) ? (uint32_t) llround(dT + benchProm.tref * 256.0) : d2[i - 1];
+	}
+}
+
+/* Decodes the whole log and compares it with the trace, returns the number of differences */
+static long Bench_Verify(const Bench_Output_TypeDef *out, const uint32_t *d1, const uint32_t *d2, long samples){
+	static uint32_t b1[MS5611_LOG_BLOCK_MAX_SAMPLES], b2[MS5611_LOG_BLOCK_MAX_SAMPLES];
+	MS5611_Log_Header_TypeDef header;
+	size_t offset = MS5611_LOG_HEADER_SIZE;
+	long next = 0;
+	long errors = 0;
+
+	if (MS5611_Log_Decode_Header(out->data, &header) != MS5611_LOG_OK)
+		return samples;
+
+	while (offset + header.block_size <= out->used) {
+		uint32_t sequence;
+		uint16_t count, k;
+
+		if (MS5611_Log_Decode_Block(out->data + offset, header.block_size, &sequence, b1, b2,
+		                            MS5611_LOG_BLOCK_MAX_SAMPLES, &count) != MS5611_LOG_OK)
+			return samples;
+		for (k = 0; k < count && next < samples; k++, next++)
+			errors += (b1[k] != d1[next] || b2[k] != d2[next]);
+		offset += header.block_size;
+	}
+
+	return errors + (samples - next);
+}
+
+int main(int argc, char **argv){
+	long samples = 1000000;
+	uint64_t seed = 1;
+	uint32_t *d1, *d2;
+	Bench_Output_TypeDef out;
+	int failed = 0;
+	int opt;
+	int osr;
+
+	while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+		switch (opt) {
+		case 'n': samples = atol(optarg); break;
+		case 'r': seed = strtoull(optarg, NULL, 0); break;
+		default:
+			fprintf(stderr, "usage: %s [-n samples] [-r seed]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (samples < 1) {
+		fprintf(stderr, "usage: %s [-n samples] [-r seed]\n", argv[0]);
+		return 2;
+	}
+
+	d1 = malloc((size_t) samples * sizeof(uint32_t));
+	d2 = malloc((size_t) samples * sizeof(uint32_t));
+	out.capacity = MS5611_LOG_HEADER_SIZE + ((size_t) samples + 1) * MS5611_LOG_BLOCK_SIZE;
+	out.data = malloc(out.capacity);
+	if (d1 == NULL || d2 == NULL || out.data == NULL)
+		return 1;
+
+	printf("# block %u bytes, %ld samples per trace, encode time best of %u\n",
+	       MS5611_LOG_BLOCK_SIZE, samples, BENCH_ENCODE_RUNS);
+	printf("%-5s %-4s %10s %9s %10s %10s %9s %9s %8s\n", "osr", "d2", "bytes", "B/sample",
+	       "vs_u32x2", "vs_u24x2", "ns/smp", "tsc/smp", "errors");
+
+	for (osr = 0; osr < BENCH_OSR_COUNT; osr++) {
+		uint32_t decimation;
+
+		for (decimation = 1; decimation <= BENCH_DECIMATION; decimation *= BENCH_DECIMATION) {
+			double bestSeconds = 1e30;
+			uint64_t bestTicks = UINT64_MAX;
+			long errors;
+			int run;
+
+			rngState = (seed + (uint64_t) osr) * 0x9E3779B97F4A7C15ULL;
+			Bench_Trace(d1, d2, samples, osr, decimation);
+
+			for (run = 0; run < BENCH_ENCODE_RUNS; run++) {
+				MS5611_Log_Encoder_TypeDef encoder;
+				double t0;
+				uint64_t ticks = 0;
+				long i;
+
+				out.used = 0;
+				t0 = Bench_Seconds();
+#if BENCH_HAS_TSC
+				ticks = __rdtsc();
+#endif
+				MS5611_Log_Encoder_Init(&encoder, Bench_Write, &out, (const uint16_t *) &benchProm,
+				                        benchOsr[osr].code, (uint32_t) (1e6 / (2.0 * benchOsr[osr].conversion_us)));
+				for (i = 0; i < samples; i++)
+					MS5611_Log_Append(&encoder, d1[i], d2[i]);
+				MS5611_Log_Flush(&encoder);
+#if BENCH_HAS_TSC
+				ticks = __rdtsc() - ticks;
+#endif
+				t0 = Bench_Seconds() - t0;
+				if (t0 < bestSeconds)
+					bestSeconds = t0;
+				if (ticks < bestTicks)
+					bestTicks = ticks;
+			}
+
+			errors = Bench_Verify(&out, d1, d2, samples);
+			if (errors != 0)
+				failed = 1;
+
+			printf("%-5s %-4s %10zu %9.3f %9.2fx %9.2fx %9.1f", benchOsr[osr].name, decimation > 1 ? "dec" : "all",
+			       out.used, (double) out.used / samples, 8.0 * samples / out.used, 6.0 * samples / out.used,
+			       1e9 * bestSeconds / samples);
+			if (BENCH_HAS_TSC)
+				printf(" %9.1f", (double) bestTicks / samples);
+			else
+				printf(" %9s", "-");
+			printf(" %8ld\n", errors);
+		}
+	}
+
+	printf("# %s\n", failed ? "FAIL" : "PASS");
+
+	free(d1);
+	free(d2);
+	free(out.data);
+	return failed;
+}
@@ -0,0 +1,195 @@
+/* ============================================================================================
+ * ms5611_osr_bench.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Compares the five MS5611_OSR_* settings on the host. The sensor is simulated from the
+ * datasheet example calibration: raw D1/D2 words get gaussian noise sized so the compensated
+ * output matches the datasheet RMS resolution per OSR, and are quantized to whole counts.
+ * Timing uses the datasheet maximum conversion times and the blocking driver's SPI traffic
+ * (1 command byte per conversion, 4 bytes per ADC read) at the given SPI clock.
+ *
+ * Per OSR it reports:
+ *   latency_us            D1 conversion start to compensated value available
+ *   rate_hz / rate_dec_hz Maximum sample rate, temperature every sample / every -d samples
+ *   cpu_us                CPU busy time per sample with blocking SPI, plus compensation
+ *   compute_ns            Measured host time of MS5611_Compensate
+ *   noise_pa / noise_dec_pa  Standard deviation of the output pressure without / with decimation
+ *   noise_c               Standard deviation of the output temperature, degC
+ *
+ * Output is CSV by default or JSON with -j; the seed is fixed so runs are reproducible.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_osr_bench.c MS5611Compensate.c MS5611Stats.c -lm -o ms5611_osr_bench
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "MS5611Compensate.h"
+#include "MS5611Stats.h"
+#include "ms5611_tool_util.h"
+
+#define BENCH_OSR_COUNT      5
+#define BENCH_COMPUTE_LOOPS  2000000L
+
+/* Mirrors MS5611_OSR_* and MS5611_Conversion_Time_Us(), which live in the HAL-bound header */
+static const struct {
+	const char *name;
+	uint8_t code;
+	uint32_t conversion_us;
+	double pressure_rms_pa;     /**< Datasheet resolution RMS, 0.065..0.012 mbar */
+	double temperature_rms_c;   /**< Datasheet resolution RMS, 0.012..0.002 degC */
+} benchOsr[BENCH_OSR_COUNT] = {
+	{"256",  0x00,  600, 6.5, 0.012},
+	{"512",  0x02, 1170, 4.2, 0.008},
+	{"1024", 0x04, 2280, 2.7, 0.005},
+	{"2048", 0x06, 4540, 1.8, 0.003},
+	{"4096", 0x08, 9040, 1.2, 0.002},
+};
+
+/* Datasheet example: 2007 (20.07 degC), 100009 Pa */
+static const struct promData benchProm = {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+static const MS5611_Raw_Data_TypeDef benchNominal = {9085466, 8569150};
+
+static uint64_t rngState;
+
+static void Bench_Usage(const char *argv0){
+	fprintf(stderr, "usage: %s [-j] [-n samples] [-d decimation] [-s spi_hz] [-r seed]\n", argv0);
+}
+
+int main(int argc, char **argv){
+	static MS5611_Stats_TypeDef pressureStats, pressureDecStats, temperatureStats;
+	long samples = 20000;
+	uint32_t decimation = 8;
+	double spiHz = 10e6;
+	uint64_t seed = 1;
+	int json = 0;
+	double countsPerPa, countsPerC;
+	double spiCmdUs, spiReadUs;
+	int opt;
+	int i;
+
+	while ((opt = getopt(argc, argv, "jn:d:s:r:")) != -1) {
+		switch (opt) {
+		case 'j': json = 1; break;
+		case 'n': samples = atol(optarg); break;
+		case 'd': decimation = (uint32_t) atol(optarg); break;
+		case 's': spiHz = atof(optarg); break;
+		case 'r': seed = strtoull(optarg, NULL, 0); break;
+		default: Bench_Usage(argv[0]); return 2;
+		}
+	}
+	if (samples < 2 || decimation == 0 || spiHz <= 0.0) {
+		Bench_Usage(argv[0]);
+		return 2;
+	}
+
+	/* Local sensitivities of the calibrated transfer function around the nominal point */
+	{
+		MS5611_Raw_Data_TypeDef probe = benchNominal;
+		MS5611_Converted_Data_TypeDef a, b;
+
+		MS5611_Compensate(&benchProm, &probe, &a);
+		probe.pressure += 10000;
+		MS5611_Compensate(&benchProm, &probe, &b);
+		countsPerPa = 10000.0 / (double) (b.pressure - a.pressure);
+
+		probe = benchNominal;
+		probe.temperature += 100000;
+		MS5611_Compensate(&benchProm, &probe, &b);
+		countsPerC = 100000.0 / ((double) (b.temperature - a.temperature) / 100.0);
+	}
+
+	spiCmdUs = 8.0 * 1e6 / spiHz;
+	spiReadUs = 4.0 * 8.0 * 1e6 / spiHz;
+
+	if (json)
+		printf("{\n  \"samples\": %ld, \"decimation\": %u, \"spi_hz\": %.0f, \"seed\": %llu,\n  \"results\": [\n",
+		       samples, decimation, spiHz, (unsigned long long) seed);
+	else
+		printf("osr,latency_us,rate_hz,rate_dec_hz,cpu_us,compute_ns,noise_pa,noise_dec_pa,noise_c\n");
+
+	for (i = 0; i < BENCH_OSR_COUNT; i++) {
+		double d1Sigma = benchOsr[i].pressure_rms_pa * countsPerPa;
+		double d2Sigma = benchOsr[i].temperature_rms_c * countsPerC;
+		double conversionUs = benchOsr[i].conversion_us;
+		double pairUs = spiCmdUs + conversionUs + spiReadUs;
+		MS5611_Raw_Data_TypeDef sample, held = benchNominal;
+		MS5611_Converted_Data_TypeDef value;
+		struct timespec t0, t1;
+		double computeNs, latencyUs, rateHz, rateDecHz, cpuUs;
+		volatile int32_t sink = 0;
+		long n;
+
+		rngState = seed * 0x9E3779B97F4A7C15ULL + (uint64_t) i + 1;
+		MS5611_Stats_Reset(&pressureStats);
+		MS5611_Stats_Reset(&pressureDecStats);
+		MS5611_Stats_Reset(&temperatureStats);
+
+		for (n = 0; n < samples; n++) {
+			sample.pressure = (uint32_t) lround(benchNominal.pressure + d1Sigma * Tool_Gauss(&rngState));
+			sample.temperature = (uint32_t) lround(benchNominal.temperature + d2Sigma * Tool_Gauss(&rngState));
+
+			MS5611_Compensate(&benchProm, &sample, &value);
+			MS5611_Stats_Push(&pressureStats, value.pressure);
+			MS5611_Stats_Push(&temperatureStats, value.temperature);
+
+			/* Decimated: the temperature word is refreshed every 'decimation' samples */
+			if ((n % decimation) == 0)
+				held.temperature = sample.temperature;
+			held.pressure = sample.pressure;
+			MS5611_Compensate(&benchProm, &held, &value);
+			MS5611_Stats_Push(&pressureDecStats, value.pressure);
+		}
+
+		sample = benchNominal;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (n = 0; n < BENCH_COMPUTE_LOOPS; n++) {
+			sample.pressure = benchNominal.pressure + (uint32_t) (n & 0xFFF);
+			MS5611_Compensate(&benchProm, &sample, &value);
+			sink += value.pressure;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		computeNs = ((double) (t1.tv_sec - t0.tv_sec) * 1e9 + (double) (t1.tv_nsec - t0.tv_nsec)) / BENCH_COMPUTE_LOOPS;
+
+		latencyUs = pairUs + computeNs / 1000.0;
+		rateHz = 1e6 / (2.0 * pairUs + computeNs / 1000.0);
+		rateDecHz = 1e6 / ((1.0 + 1.0 / decimation) * pairUs + computeNs / 1000.0);
+		cpuUs = (1.0 + 1.0 / decimation) * (spiCmdUs + spiReadUs) + computeNs / 1000.0;
+
+		if (json)
+			printf("    {\"osr\": %s, \"latency_us\": %.2f, \"rate_hz\": %.2f, \"rate_dec_hz\": %.2f, \"cpu_us\": %.3f, "
+			       "\"compute_ns\": %.1f, \"noise_pa\": %.3f, \"noise_dec_pa\": %.3f, \"noise_c\": %.4f}%s\n",
+			       benchOsr[i].name, latencyUs, rateHz, rateDecHz, cpuUs, computeNs,
+			       sqrt(MS5611_Stats_Variance(&pressureStats)), sqrt(MS5611_Stats_Variance(&pressureDecStats)),
+			       sqrt(MS5611_Stats_Variance(&temperatureStats)) / 100.0, (i + 1 < BENCH_OSR_COUNT) ? "," : "");
+		else
+			printf("%s,%.2f,%.2f,%.2f,%.3f,%.1f,%.3f,%.3f,%.4f\n",
+			       benchOsr[i].name, latencyUs, rateHz, rateDecHz, cpuUs, computeNs,
+			       sqrt(MS5611_Stats_Variance(&pressureStats)), sqrt(MS5611_Stats_Variance(&pressureDecStats)),
+			       sqrt(MS5611_Stats_Variance(&temperatureStats)) / 100.0);
+	}
+
+	if (json)
+		printf("  ]\n}\n");
+
+	return 0;
+}
@@ -0,0 +1,734 @@
+/* ============================================================================================
+ * ms5611_replay.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Linux host tool: reprocesses MS5611Log raw sample logs in parallel.
+ *
+ * The log is memory-mapped, split into its independent blocks and handed to a pool of
+ * worker threads that decode, optionally glitch-filter and compensate each block. Results
+ * are written as two columnar files of little-endian int32 values:
+ *   <prefix>.pressure.i32     compensated pressure (Pa)
+ *   <prefix>.temperature.i32  compensated temperature (0.01 degC)
+ * Block sample counts are taken only from blocks whose CRC and header check out; a block
+ * that fails contributes no samples, since its true count is unknown, and is reported as
+ * dropped. A block with an intact CRC whose payload does not decode keeps its count and its
+ * samples are written as INT32_MIN.
+ *
+ * With -f the glitch filters run on across the blocks a worker claims, and at the start of
+ * each claimed range they are seeded with the last samples of the preceding blocks. The
+ * output is that of one sequential filter pass over the log.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -pthread -I. tools/ms5611_replay.c MS5611Log.c MS5611Compensate.c MS5611Filter.c -o ms5611_replay
+ *
+ * Usage:
+ *   ms5611_replay [-j threads] [-f] [-o prefix] log...   reprocess logs
+ *   ms5611_replay -b [-j threads] [-f] log               throughput for 1..threads workers
+ *   ms5611_replay -t [-j threads]                        self-check on a synthetic log
+ *
+ * The self-check encodes a synthetic log to a temporary file and replays it intact, with the
+ * count field of one block corrupted, and with one payload byte corrupted. Each state is
+ * replayed without the filter, with -f, and with -f seeding the filters at every block. Each
+ * run must match a sequential decode, filter pass and compensation of the intact blocks
+ * sample for sample.
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "MS5611Compensate.h"
+#include "MS5611Filter.h"
+#include "MS5611Log.h"
+
+#define REPLAY_BLOCKS_PER_GRAB  64      /**< Blocks claimed per work-queue access */
+#define REPLAY_MAX_THREADS      256
+#define REPLAY_PRIME_SAMPLES    (8 * MS5611_GLITCH_WINDOW)  /**< Preceding samples that seed the filters */
+
+// --- Replay Job, shared by all workers ---
+typedef struct {
+  const uint8_t *blocks;        /**< First block in the mapped log */
+  uint32_t block_size;          /**< Bytes per block */
+  uint32_t block_count;         /**< Number of blocks */
+  uint16_t capacity;            /**< Maximum samples per block */
+  struct promData prom;         /**< Calibration from the log header */
+  uint64_t *offsets;            /**< First output sample of each block, block_count + 1 entries */
+  int32_t *pressure;            /**< Output column */
+  int32_t *temperature;         /**< Output column */
+  int filter;                   /**< Non-zero runs the glitch filter */
+  uint32_t grab;                /**< Blocks claimed per work-queue access */
+  atomic_uint next_block;       /**< Work queue head */
+  atomic_uint bad_blocks;       /**< Blocks with an intact CRC that did not decode */
+  atomic_uint dropped_blocks;   /**< Blocks failing their CRC or header check, no samples */
+} Replay_Job_TypeDef;
+
+// --- Mapped Log ---
+typedef struct {
+  int fd;
+  uint8_t *data;
+  size_t size;
+  MS5611_Log_Header_TypeDef header;
+  uint32_t block_count;
+} Replay_Log_TypeDef;
+
+static double Replay_Now(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief  Decodes block b if its count pass kept it
+ * @retval uint16_t Samples decoded, 0 for a dropped block or one that does not decode
+ */
+static uint16_t Replay_Decode(const Replay_Job_TypeDef *job, uint32_t b, uint32_t *d1, uint32_t *d2){
+	uint32_t expected = (uint32_t) (job->offsets[b + 1] - job->offsets[b]);
+	uint32_t sequence;
+	uint16_t count;
+
+	if (expected == 0 ||
+	    MS5611_Log_Decode_Block(job->blocks + (size_t) b * job->block_size, (uint16_t) job->block_size,
+	                            &sequence, d1, d2, job->capacity, &count) != MS5611_LOG_OK || count != expected)
+		return 0;
+
+	return count;
+}
+
+/**
+ * @brief  Resets the filters and runs them over the samples that precede block b in the log
+ * @note   Takes the last REPLAY_PRIME_SAMPLES samples of the decodable blocks before b. The
+ *         filter state depends only on the last MS5611_GLITCH_WINDOW non-rail words and the
+ *         last accepted word, so block b then sees the state of a sequential run unless the
+ *         tail has fewer than W non-rail words or no accepted word after its first W.
+ * @param  job Pointer to Replay_Job_TypeDef structure
+ * @param  b First block of the grab
+ * @param  d1 Scratch column, job->capacity words
+ * @param  d2 Scratch column, job->capacity words
+ * @param  d1Filter Pointer to the D1 filter
+ * @param  d2Filter Pointer to the D2 filter
+ * @retval None
+ */
+static void Replay_Prime(const Replay_Job_TypeDef *job, uint32_t b, uint32_t *d1, uint32_t *d2,
+                         MS5611_Glitch_Filter_TypeDef *d1Filter, MS5611_Glitch_Filter_TypeDef *d2Filter){
+	uint32_t tail1[REPLAY_PRIME_SAMPLES], tail2[REPLAY_PRIME_SAMPLES];
+	uint32_t fill = REPLAY_PRIME_SAMPLES, i;
+
+	MS5611_Glitch_Filter_Init(d1Filter, 200, MS5611_GLITCH_MEDIAN);
+	MS5611_Glitch_Filter_Init(d2Filter, 200, MS5611_GLITCH_HOLD);
+
+	/* Walk back, filling the tail from its end */
+	while (b-- > 0 && fill > 0) {
+		uint16_t count = Replay_Decode(job, b, d1, d2);
+		uint32_t n = (count < fill) ? count : fill;
+
+		memcpy(tail1 + fill - n, d1 + count - n, n * sizeof(uint32_t));
+		memcpy(tail2 + fill - n, d2 + count - n, n * sizeof(uint32_t));
+		fill -= n;
+	}
+
+	for (i = fill; i < REPLAY_PRIME_SAMPLES; i++) {
+		MS5611_Glitch_Filter_Apply(d1Filter, &tail1[i]);
+		MS5611_Glitch_Filter_Apply(d2Filter, &tail2[i]);
+	}
+}
+
+/**
+ * @brief  Worker thread, claims block ranges until the queue is empty
+ * @note   With the filter on, the filter state runs on across the blocks of a claimed range,
+ *         as in a sequential pass, and is seeded by Replay_Prime at the start of each range
+ * @param  arg Pointer to Replay_Job_TypeDef structure
+ * @retval void* Always NULL
+ */
+static void *Replay_Worker(void *arg){
+	Replay_Job_TypeDef *job = (Replay_Job_TypeDef *) arg;
+	MS5611_Glitch_Filter_TypeDef d1Filter, d2Filter;
+	uint32_t *d1 = malloc(job->capacity * sizeof(uint32_t));
+	uint32_t *d2 = malloc(job->capacity * sizeof(uint32_t));
+	uint32_t first, last, b, i;
+
+	if (d1 == NULL || d2 == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+
+	for (;;) {
+		first = atomic_fetch_add(&job->next_block, job->grab);
+		if (first >= job->block_count)
+			break;
+		last = first + job->grab;
+		if (last > job->block_count)
+			last = job->block_count;
+
+		if (job->filter)
+			Replay_Prime(job, first, d1, d2, &d1Filter, &d2Filter);
+
+		for (b = first; b < last; b++) {
+			uint64_t offset = job->offsets[b];
+			uint32_t expected = (uint32_t) (job->offsets[b + 1] - offset);
+			uint16_t count;
+
+			if (expected == 0)
+				continue;   /* dropped by the count pass */
+
+			count = Replay_Decode(job, b, d1, d2);
+			if (count == 0) {
+				for (i = 0; i < expected; i++) {
+					job->pressure[offset + i] = INT32_MIN;
+					job->temperature[offset + i] = INT32_MIN;
+				}
+				atomic_fetch_add(&job->bad_blocks, 1);
+				continue;
+			}
+
+			if (job->filter) {
+				for (i = 0; i < count; i++) {
+					MS5611_Glitch_Filter_Apply(&d1Filter, &d1[i]);
+					MS5611_Glitch_Filter_Apply(&d2Filter, &d2[i]);
+				}
+			}
+
+			MS5611_Compensate_Batch(&job->prom, d1, d2, job->pressure + offset, job->temperature + offset, count);
+		}
+	}
+
+	free(d1);
+	free(d2);
+	return NULL;
+}
+
+/**
+ * @brief  Maps a log file and parses its header
+ * @param  path File name
+ * @param  log Pointer to Replay_Log_TypeDef structure
+ * @retval int 0 on success
+ */
+static int Replay_Open(const char *path, Replay_Log_TypeDef *log){
+	struct stat st;
+
+	log->data = MAP_FAILED;
+	log->fd = open(path, O_RDONLY);
+	if (log->fd < 0 || fstat(log->fd, &st) != 0) {
+		perror(path);
+		goto fail;
+	}
+
+	log->size = (size_t) st.st_size;
+	if (log->size < MS5611_LOG_HEADER_SIZE) {
+		fprintf(stderr, "%s: too short\n", path);
+		goto fail;
+	}
+
+	log->data = mmap(NULL, log->size, PROT_READ, MAP_PRIVATE, log->fd, 0);
+	if (log->data == MAP_FAILED) {
+		perror(path);
+		goto fail;
+	}
+	madvise(log->data, log->size, MADV_SEQUENTIAL);
+
+	if (MS5611_Log_Decode_Header(log->data, &log->header) != MS5611_LOG_OK) {
+		fprintf(stderr, "%s: bad log header\n", path);
+		goto fail;
+	}
+
+	log->block_count = (uint32_t) ((log->size - MS5611_LOG_HEADER_SIZE) / log->header.block_size);
+	return 0;
+
+fail:
+	if (log->data != MAP_FAILED)
+		munmap(log->data, log->size);
+	if (log->fd >= 0)
+		close(log->fd);
+	log->fd = -1;
+	return -1;
+}
+
+static void Replay_Close(Replay_Log_TypeDef *log){
+	munmap(log->data, log->size);
+	close(log->fd);
+}
+
+/**
+ * @brief  Count worker, stores the checked sample count of each claimed block in offsets[b + 1]
+ * @note   The count field is trusted only when the block CRC matches and the count is in
+ *         1..capacity; otherwise the block contributes no samples
+ * @param  arg Pointer to Replay_Job_TypeDef structure
+ * @retval void* Always NULL
+ */
+static void *Replay_Count_Worker(void *arg){
+	Replay_Job_TypeDef *job = (Replay_Job_TypeDef *) arg;
+	uint32_t payload = job->block_size - MS5611_LOG_CRC_SIZE;
+	uint32_t first, last, b;
+
+	for (;;) {
+		first = atomic_fetch_add(&job->next_block, job->grab);
+		if (first >= job->block_count)
+			break;
+		last = first + job->grab;
+		if (last > job->block_count)
+			last = job->block_count;
+
+		for (b = first; b < last; b++) {
+			const uint8_t *block = job->blocks + (size_t) b * job->block_size;
+			const uint8_t *crc = block + payload;
+			uint16_t count = (uint16_t) (block[4] | (block[5] << 8));
+
+			if (((uint32_t) crc[0] | ((uint32_t) crc[1] << 8) | ((uint32_t) crc[2] << 16) | ((uint32_t) crc[3] << 24)) !=
+			    MS5611_Log_CRC32(block, payload) || count == 0 || count > job->capacity) {
+				count = 0;
+				atomic_fetch_add(&job->dropped_blocks, 1);
+			}
+			job->offsets[b + 1] = count;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief  Runs one pass over every block of a job on a given number of threads
+ * @note   If a thread cannot be created the calling thread works the queue itself, so the
+ *         pass always completes, only with fewer workers.
+ * @param  job Pointer to Replay_Job_TypeDef structure
+ * @param  threads Number of workers
+ * @param  worker Replay_Worker or Replay_Count_Worker
+ * @retval None
+ */
+static void Replay_Pool(Replay_Job_TypeDef *job, int threads, void *(*worker)(void *)){
+	pthread_t pool[REPLAY_MAX_THREADS];
+	int started, t;
+
+	atomic_store(&job->next_block, 0);
+	for (started = 0; started < threads; started++) {
+		int error = pthread_create(&pool[started], NULL, worker, job);
+
+		if (error != 0) {
+			fprintf(stderr, "pthread_create: %s, running on %d thread(s)\n", strerror(error), started + 1);
+			worker(job);
+			break;
+		}
+	}
+	for (t = 0; t < started; t++)
+		pthread_join(pool[t], NULL);
+}
+
+/**
+ * @brief  Sets up a job for a mapped log and builds the output offset of every block
+ * @param  log Pointer to Replay_Log_TypeDef structure
+ * @param  job Pointer to Replay_Job_TypeDef structure to fill; job->offsets is malloc'd
+ * @param  filter Non-zero runs the glitch filter
+ * @param  threads Number of workers for the count pass
+ * @retval int 0 on success
+ */
+static int Replay_Prepare(const Replay_Log_TypeDef *log, Replay_Job_TypeDef *job, int filter, int threads){
+	uint32_t b;
+
+	memset(job, 0, sizeof(*job));
+	job->blocks = log->data + MS5611_LOG_HEADER_SIZE;
+	job->block_size = log->header.block_size;
+	job->block_count = log->block_count;
+	job->capacity = (uint16_t) MS5611_LOG_BLOCK_CAPACITY(log->header.block_size);
+	memcpy(&job->prom, log->header.prom, sizeof(job->prom));
+	job->filter = filter;
+	job->grab = REPLAY_BLOCKS_PER_GRAB;
+
+	job->offsets = malloc(((size_t) log->block_count + 1) * sizeof(uint64_t));
+	if (job->offsets == NULL)
+		return -1;
+
+	Replay_Pool(job, threads, Replay_Count_Worker);
+	job->offsets[0] = 0;
+	for (b = 0; b < log->block_count; b++)
+		job->offsets[b + 1] += job->offsets[b];
+
+	return 0;
+}
+
+/**
+ * @brief  Decodes and compensates every block of a prepared job
+ * @param  job Pointer to Replay_Job_TypeDef structure
+ * @param  threads Number of workers
+ * @retval double Wall time in seconds
+ */
+static double Replay_Run(Replay_Job_TypeDef *job, int threads){
+	double start;
+
+	atomic_store(&job->bad_blocks, 0);
+
+	start = Replay_Now();
+	Replay_Pool(job, threads, Replay_Worker);
+
+	return Replay_Now() - start;
+}
+
+/**
+ * @brief  Creates and maps one output column file
+ * @param  prefix Output prefix
+ * @param  suffix Column suffix
+ * @param  count Number of int32 values
+ * @retval int32_t* Mapped column, NULL on error
+ */
+static int32_t *Replay_Column(const char *prefix, const char *suffix, uint64_t count){
+	char path[4096];
+	size_t size = (size_t) count * sizeof(int32_t);
+	int32_t *column;
+	int fd;
+
+	snprintf(path, sizeof(path), "%s.%s.i32", prefix, suffix);
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0 || ftruncate(fd, (off_t) size) != 0) {
+		perror(path);
+		if (fd >= 0)
+			close(fd);
+		return NULL;
+	}
+	if (size == 0) {
+		close(fd);
+		return (int32_t *) malloc(1);
+	}
+
+	column = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	return (column == MAP_FAILED) ? NULL : column;
+}
+
+static void Replay_Column_Free(int32_t *column, uint64_t count){
+	if (column == NULL)
+		return;
+	if (count > 0)
+		munmap(column, (size_t) count * sizeof(int32_t));
+	else
+		free(column);
+}
+
+static void Replay_Usage(void){
+	fprintf(stderr,
+	        "usage: ms5611_replay [-j threads] [-f] [-o prefix] log...\n"
+	        "       ms5611_replay -b [-j threads] [-f] log\n"
+	        "  -j  worker threads (default: online CPUs)\n"
+	        "  -f  run the glitch filter on raw words before compensation\n"
+	        "  -o  output prefix (single log only, default: log file name)\n"
+	        "  -b  benchmark 1..threads workers, no output files\n"
+	        "  -t  self-check on a synthetic log, exit status non-zero on failure\n");
+}
+
+// --- Self-Check ---
+#define REPLAY_CHECK_SAMPLES    60000
+#define REPLAY_CHECK_BLOCK      1       /**< Block whose count field is corrupted */
+#define REPLAY_CHECK_PAYLOAD    2       /**< Block with a corrupted payload byte */
+
+static const struct promData replayCheckProm = {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+
+static int Replay_Check_Write(void *context, const uint8_t *data, uint32_t length){
+	return (fwrite(data, 1, length, (FILE *) context) == length) ? 0 : -1;
+}
+
+/**
+ * @brief  Replays the file at path and compares it with the expected columns
+ * @param  path Log file
+ * @param  pressure Expected pressure column
+ * @param  temperature Expected temperature column
+ * @param  total Expected number of samples
+ * @param  threads Number of workers
+ * @param  filter Non-zero runs the glitch filter
+ * @param  grab Blocks per work-queue access; 1 seeds the filters at every block
+ * @param  name Case name for the report
+ * @retval int 0 when the output matches
+ */
+static int Replay_Check_Case(const char *path, const int32_t *pressure, const int32_t *temperature, uint64_t total,
+                             int threads, int filter, uint32_t grab, const char *name){
+	Replay_Job_TypeDef job;
+	Replay_Log_TypeDef log;
+	uint64_t got, i, mismatches = 0;
+
+	if (Replay_Open(path, &log) != 0)
+		return 1;
+	if (Replay_Prepare(&log, &job, filter, threads) != 0) {
+		Replay_Close(&log);
+		return 1;
+	}
+	job.grab = grab;
+
+	got = job.offsets[log.block_count];
+	job.pressure = malloc((size_t) got * sizeof(int32_t) + 1);
+	job.temperature = malloc((size_t) got * sizeof(int32_t) + 1);
+	if (job.pressure != NULL && job.temperature != NULL) {
+		Replay_Run(&job, threads);
+		for (i = 0; i < got && i < total; i++)
+			mismatches += (job.pressure[i] != pressure[i] || job.temperature[i] != temperature[i]);
+	}
+
+	printf("%-16s %-11s %8llu samples (expected %llu), %u dropped, %u bad, %llu mismatches: %s\n", name,
+	       filter ? (grab == 1 ? "-f, grab 1" : "-f") : "", (unsigned long long) got, (unsigned long long) total,
+	       atomic_load(&job.dropped_blocks), atomic_load(&job.bad_blocks), (unsigned long long) mismatches,
+	       (job.pressure != NULL && got == total && mismatches == 0) ? "ok" : "FAIL");
+
+	free(job.pressure);
+	free(job.temperature);
+	free(job.offsets);
+	Replay_Close(&log);
+	return (job.pressure != NULL && got == total && mismatches == 0) ? 0 : 1;
+}
+
+/**
+ * @brief  Builds the expected columns from the raw words of the intact blocks and checks a
+ *         replay without the filter and two with it, against one sequential filter pass
+ * @param  d1 Raw D1 words in log order
+ * @param  d2 Raw D2 words in log order
+ * @param  total Number of words
+ * @retval int 0 when every run matches
+ */
+static int Replay_Check_Runs(const char *path, const uint32_t *d1, const uint32_t *d2, uint64_t total,
+                             int threads, const char *name){
+	static uint32_t f1[REPLAY_CHECK_SAMPLES], f2[REPLAY_CHECK_SAMPLES];
+	static int32_t pressure[REPLAY_CHECK_SAMPLES], temperature[REPLAY_CHECK_SAMPLES];
+	MS5611_Glitch_Filter_TypeDef d1Filter, d2Filter;
+	uint64_t i;
+	int failed;
+
+	MS5611_Compensate_Batch(&replayCheckProm, d1, d2, pressure, temperature, (uint32_t) total);
+	failed = Replay_Check_Case(path, pressure, temperature, total, threads, 0, REPLAY_BLOCKS_PER_GRAB, name);
+
+	MS5611_Glitch_Filter_Init(&d1Filter, 200, MS5611_GLITCH_MEDIAN);
+	MS5611_Glitch_Filter_Init(&d2Filter, 200, MS5611_GLITCH_HOLD);
+	for (i = 0; i < total; i++) {
+		f1[i] = d1[i];
+		f2[i] = d2[i];
+		MS5611_Glitch_Filter_Apply(&d1Filter, &f1[i]);
+		MS5611_Glitch_Filter_Apply(&d2Filter, &f2[i]);
+	}
+	MS5611_Compensate_Batch(&replayCheckProm, f1, f2, pressure, temperature, (uint32_t) total);
+	failed |= Replay_Check_Case(path, pressure, temperature, total, threads, 1, REPLAY_BLOCKS_PER_GRAB, name);
+	failed |= Replay_Check_Case(path, pressure, temperature, total, threads, 1, 1, name);
+
+	return failed;
+}
+
+/**
+ * @brief  Encodes a synthetic log and checks the replay of it intact and corrupted
+ * @param  threads Number of workers
+ * @retval int 0 when every case passes
+ */
+static int Replay_Self_Check(int threads){
+	char path[] = "/tmp/ms5611_replay_check_XXXXXX";
+	MS5611_Log_Encoder_TypeDef encoder;
+	MS5611_Log_Header_TypeDef header;
+	static uint32_t d1[REPLAY_CHECK_SAMPLES], d2[REPLAY_CHECK_SAMPLES];
+	static uint8_t data[MS5611_LOG_HEADER_SIZE + (REPLAY_CHECK_SAMPLES + 1) * MS5611_LOG_BLOCK_SIZE];
+	uint16_t counts[REPLAY_CHECK_PAYLOAD + 1];
+	uint64_t start[REPLAY_CHECK_PAYLOAD + 1];
+	size_t size, offset;
+	uint32_t sequence;
+	uint64_t total = 0, kept;
+	FILE *file;
+	int failed = 0;
+	int fd;
+	uint32_t i;
+	uint16_t b;
+
+	/* Slow pressure ramp and temperature drift with a deterministic jitter of a few counts,
+	 * D1 spikes and D2 rail words for the filter, some of them at the start of a block */
+	for (i = 0; i < REPLAY_CHECK_SAMPLES; i++) {
+		d1[i] = 8500000U + (i / 8U) % 4000U + (i * 7919U) % 13U + ((i % 89U == 0) ? 30000U : 0U);
+		d2[i] = (i % 211U == 0) ? 0U : 8300000U + (i / 64U) % 900U + (i * 104729U) % 5U;
+	}
+
+	fd = mkstemp(path);
+	if (fd < 0 || (file = fdopen(fd, "w+b")) == NULL) {
+		perror(path);
+		return 1;
+	}
+	MS5611_Log_Encoder_Init(&encoder, Replay_Check_Write, file, (const uint16_t *) &replayCheckProm, 0x08, 50);
+	for (i = 0; i < REPLAY_CHECK_SAMPLES; i++)
+		MS5611_Log_Append(&encoder, d1[i], d2[i]);
+	MS5611_Log_Flush(&encoder);
+	fflush(file);
+
+	size = (size_t) ftell(file);
+	rewind(file);
+	if (size > sizeof(data) || fread(data, 1, size, file) != size ||
+	    MS5611_Log_Decode_Header(data, &header) != MS5611_LOG_OK) {
+		fprintf(stderr, "%s: cannot read back the synthetic log\n", path);
+		fclose(file);
+		unlink(path);
+		return 1;
+	}
+
+	/* Reference: sequential decode, remembering where the corrupted blocks start */
+	for (b = 0, offset = MS5611_LOG_HEADER_SIZE; offset + header.block_size <= size; b++, offset += header.block_size) {
+		uint16_t count;
+
+		if (MS5611_Log_Decode_Block(data + offset, header.block_size, &sequence, d1 + total, d2 + total,
+		                            (uint16_t) (REPLAY_CHECK_SAMPLES - total), &count) != MS5611_LOG_OK)
+			failed = 1;
+		if (b <= REPLAY_CHECK_PAYLOAD) {
+			start[b] = total;
+			counts[b] = count;
+		}
+		total += count;
+	}
+	if (failed || total != REPLAY_CHECK_SAMPLES || b <= REPLAY_CHECK_PAYLOAD) {
+		fprintf(stderr, "%s: synthetic log does not decode\n", path);
+		fclose(file);
+		unlink(path);
+		return 1;
+	}
+
+	printf("# %llu samples in %u blocks of %u bytes, %d threads\n", (unsigned long long) total, b,
+	       header.block_size, threads);
+	failed |= Replay_Check_Runs(path, d1, d2, total, threads, "intact");
+
+	/* Count field of one block raised to the capacity, CRC left as it was */
+	offset = MS5611_LOG_HEADER_SIZE + (size_t) REPLAY_CHECK_BLOCK * header.block_size;
+	data[offset + 4] = (uint8_t) MS5611_LOG_BLOCK_CAPACITY(header.block_size);
+	data[offset + 5] = (uint8_t) (MS5611_LOG_BLOCK_CAPACITY(header.block_size) >> 8);
+	rewind(file);
+	fwrite(data, 1, size, file);
+	fflush(file);
+	kept = total - counts[REPLAY_CHECK_BLOCK];
+	memmove(d1 + start[REPLAY_CHECK_BLOCK], d1 + start[REPLAY_CHECK_BLOCK] + counts[REPLAY_CHECK_BLOCK],
+	        (size_t) (kept - start[REPLAY_CHECK_BLOCK]) * sizeof(uint32_t));
+	memmove(d2 + start[REPLAY_CHECK_BLOCK], d2 + start[REPLAY_CHECK_BLOCK] + counts[REPLAY_CHECK_BLOCK],
+	        (size_t) (kept - start[REPLAY_CHECK_BLOCK]) * sizeof(uint32_t));
+	failed |= Replay_Check_Runs(path, d1, d2, kept, threads, "corrupt count");
+
+	/* Additionally one payload byte of a later block flipped */
+	offset = MS5611_LOG_HEADER_SIZE + (size_t) REPLAY_CHECK_PAYLOAD * header.block_size;
+	data[offset + MS5611_LOG_BLOCK_HEADER_SIZE + 3] ^= 0x5A;
+	rewind(file);
+	fwrite(data, 1, size, file);
+	fflush(file);
+	start[REPLAY_CHECK_PAYLOAD] -= counts[REPLAY_CHECK_BLOCK];
+	kept -= counts[REPLAY_CHECK_PAYLOAD];
+	memmove(d1 + start[REPLAY_CHECK_PAYLOAD], d1 + start[REPLAY_CHECK_PAYLOAD] + counts[REPLAY_CHECK_PAYLOAD],
+	        (size_t) (kept - start[REPLAY_CHECK_PAYLOAD]) * sizeof(uint32_t));
+	memmove(d2 + start[REPLAY_CHECK_PAYLOAD], d2 + start[REPLAY_CHECK_PAYLOAD] + counts[REPLAY_CHECK_PAYLOAD],
+	        (size_t) (kept - start[REPLAY_CHECK_PAYLOAD]) * sizeof(uint32_t));
+	failed |= Replay_Check_Runs(path, d1, d2, kept, threads, "corrupt payload");
+
+	fclose(file);
+	unlink(path);
+	printf("# %s\n", failed ? "FAIL" : "PASS");
+	return failed;
+}
+
+int main(int argc, char **argv){
+	Replay_Job_TypeDef job;
+	Replay_Log_TypeDef log;
+	const char *prefix = NULL;
+	int threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	int bench = 0;
+	int filter = 0;
+	int check = 0;
+	int status = 0;
+	int opt, arg;
+
+	while ((opt = getopt(argc, argv, "j:fo:bt")) != -1) {
+		switch (opt) {
+		case 'j': threads = atoi(optarg); break;
+		case 'f': filter = 1; break;
+		case 'o': prefix = optarg; break;
+		case 'b': bench = 1; break;
+		case 't': check = 1; break;
+		default: Replay_Usage(); return 2;
+		}
+	}
+
+	if (check && threads >= 1 && threads <= REPLAY_MAX_THREADS)
+		return Replay_Self_Check(threads);
+
+	if (optind >= argc || threads < 1 || threads > REPLAY_MAX_THREADS ||
+	    (prefix != NULL && argc - optind > 1)) {
+		Replay_Usage();
+		return 2;
+	}
+
+	for (arg = optind; arg < argc && status == 0; arg++) {
+		uint64_t total;
+		double seconds;
+
+		if (Replay_Open(argv[arg], &log) != 0)
+			return 1;
+
+		if (Replay_Prepare(&log, &job, filter, threads) != 0) {
+			status = 1;
+			goto next;
+		}
+		total = job.offsets[log.block_count];
+
+		if (bench) {
+			double single = 0.0;
+			int t;
+
+			job.pressure = malloc((size_t) total * sizeof(int32_t) + 1);
+			job.temperature = malloc((size_t) total * sizeof(int32_t) + 1);
+			if (job.pressure == NULL || job.temperature == NULL) {
+				free(job.pressure);
+				free(job.temperature);
+				status = 1;
+				goto next;
+			}
+
+			Replay_Run(&job, threads);   /* warm page cache and output pages */
+			printf("threads,seconds,msamples_per_s,speedup\n");
+			for (t = 1; t <= threads; t = (t < threads && t * 2 > threads) ? threads : t * 2) {
+				seconds = Replay_Run(&job, t);
+				if (t == 1)
+					single = seconds;
+				printf("%d,%.4f,%.2f,%.2f\n", t, seconds, (double) total / seconds * 1e-6, single / seconds);
+				if (t == threads)
+					break;
+			}
+			free(job.pressure);
+			free(job.temperature);
+		} else {
+			const char *out = (prefix != NULL) ? prefix : argv[arg];
+
+			job.pressure = Replay_Column(out, "pressure", total);
+			job.temperature = Replay_Column(out, "temperature", total);
+			if (job.pressure == NULL || job.temperature == NULL) {
+				Replay_Column_Free(job.pressure, total);
+				Replay_Column_Free(job.temperature, total);
+				status = 1;
+				goto next;
+			}
+
+			seconds = Replay_Run(&job, threads);
+			printf("%s: %u blocks, %llu samples, %u dropped blocks, %u bad blocks, %.3f s (%.2f Msamples/s)\n",
+			       argv[arg], log.block_count, (unsigned long long) total, atomic_load(&job.dropped_blocks),
+			       atomic_load(&job.bad_blocks), seconds, (double) total / seconds * 1e-6);
+
+			Replay_Column_Free(job.pressure, total);
+			Replay_Column_Free(job.temperature, total);
+		}
+
+next:
+		free(job.offsets);
+		Replay_Close(&log);
+	}
+
+	return status;
+}
@@ -0,0 +1,160 @@
+/* ============================================================================================
+ * ms5611_stats_check.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Validates MS5611Stats against a host reference and times it. The reference keeps the whole
+ * signal, computes mean and variance in two passes and the Allan variance from prefix sums,
+ * both with the stride used by the embedded engine (m/2) and fully overlapping (stride 1).
+ * Test signals are white noise, white noise plus random walk, a ramp with noise, and a
+ * full-range square wave that drives the 128-bit accumulators past 64 bits.
+ *
+ * Prints per level: tau, engine ADEV, reference ADEV, relative error, fully overlapping ADEV.
+ * Exits non-zero if any engine value differs from the reference by more than 1e-9 relative.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_stats_check.c MS5611Stats.c -lm -o ms5611_stats_check
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "MS5611Stats.h"
+#include "ms5611_tool_util.h"
+
+#define CHECK_SAMPLES     (1L << 20)
+#define CHECK_TOLERANCE   1e-9
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+static double Check_Relative(double a, double b){
+	double scale = fabs(b) > 1e-300 ? fabs(b) : 1.0;
+	return fabs(a - b) / scale;
+}
+
+/* Reference Allan deviation at block size m with the given stride between block starts */
+static double Check_Reference_Adev(const int64_t *prefix, long n, long m, long stride){
+	double sumSq = 0.0;
+	long terms = 0;
+	long t;
+
+	for (t = 0; t + 2 * m <= n; t += stride) {
+		int64_t a = prefix[t + m] - prefix[t];
+		int64_t b = prefix[t + 2 * m] - prefix[t + m];
+		double d = (double) (b - a);
+		sumSq += d * d;
+		terms++;
+	}
+
+	if (terms == 0)
+		return 0.0;
+
+	return sqrt(sumSq / (2.0 * (double) m * (double) m * (double) terms));
+}
+
+static int Check_Signal(const char *name, const int32_t *x, long n){
+	static MS5611_Stats_TypeDef stats;
+	int64_t *prefix = malloc((size_t) (n + 1) * sizeof(int64_t));
+	double mean = 0.0, var = 0.0, err;
+	int failed = 0;
+	long i;
+	uint8_t k;
+
+	MS5611_Stats_Reset(&stats);
+	for (i = 0; i < n; i++)
+		MS5611_Stats_Push(&stats, x[i]);
+
+	prefix[0] = 0;
+	for (i = 0; i < n; i++) {
+		prefix[i + 1] = prefix[i] + x[i];
+		mean += x[i];
+	}
+	mean /= (double) n;
+	for (i = 0; i < n; i++)
+		var += ((double) x[i] - mean) * ((double) x[i] - mean);
+	var /= (double) (n - 1);
+
+	printf("# %s: mean %.6f (ref %.6f), variance %.6f (ref %.6f)\n", name,
+	       MS5611_Stats_Mean(&stats), mean, MS5611_Stats_Variance(&stats), var);
+	if (Check_Relative(MS5611_Stats_Mean(&stats), mean) > CHECK_TOLERANCE ||
+	    Check_Relative(MS5611_Stats_Variance(&stats), var) > CHECK_TOLERANCE)
+		failed = 1;
+
+	printf("signal,tau_samples,adev,adev_ref,rel_error,adev_full_overlap\n");
+	for (k = 0; k < MS5611_STATS_LEVELS; k++) {
+		long m = 1L << k;
+		long stride = (m <= 2) ? 1 : m / 2;
+		double engine = MS5611_Stats_Allan_Deviation(&stats, k);
+		double reference = Check_Reference_Adev(prefix, n, m, stride);
+
+		err = Check_Relative(engine, reference);
+		if (err > CHECK_TOLERANCE)
+			failed = 1;
+
+		printf("%s,%ld,%.6f,%.6f,%.2e,%.6f\n", name, m, engine, reference, err,
+		       Check_Reference_Adev(prefix, n, m, 1));
+	}
+
+	free(prefix);
+	return failed;
+}
+
+int main(void){
+	int32_t *x = malloc(CHECK_SAMPLES * sizeof(int32_t));
+	static MS5611_Stats_TypeDef stats;
+	struct timespec t0, t1;
+	double walk = 0.0;
+	int failed = 0;
+	long i;
+
+	for (i = 0; i < CHECK_SAMPLES; i++)
+		x[i] = 8400000 + (int32_t) lround(6.0 * Tool_Gauss(&rngState));
+	failed |= Check_Signal("white", x, CHECK_SAMPLES);
+
+	for (i = 0; i < CHECK_SAMPLES; i++) {
+		walk += 0.05 * Tool_Gauss(&rngState);
+		x[i] = 8400000 + (int32_t) lround(6.0 * Tool_Gauss(&rngState) + walk);
+	}
+	failed |= Check_Signal("random_walk", x, CHECK_SAMPLES);
+
+	for (i = 0; i < CHECK_SAMPLES; i++)
+		x[i] = 100000 - (int32_t) (i / 64) + (int32_t) lround(3.0 * Tool_Gauss(&rngState));
+	failed |= Check_Signal("ramp", x, CHECK_SAMPLES);
+
+	/* Full-range square wave: squared sums overflow 64 bits and block differences exceed 2^32 */
+	for (i = 0; i < CHECK_SAMPLES; i++)
+		x[i] = (((i / 3000) & 1) ? 2000000000 : -2000000000) + (int32_t) lround(6.0 * Tool_Gauss(&rngState));
+	failed |= Check_Signal("full_range", x, CHECK_SAMPLES);
+
+	for (i = 0; i < CHECK_SAMPLES; i++)
+		x[i] = 100000 - (int32_t) (i / 64) + (int32_t) lround(3.0 * Tool_Gauss(&rngState));
+
+	MS5611_Stats_Reset(&stats);
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < CHECK_SAMPLES; i++)
+		MS5611_Stats_Push(&stats, x[i]);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	printf("# push: %.1f ns/sample, state %zu bytes\n",
+	       ((double) (t1.tv_sec - t0.tv_sec) * 1e9 + (double) (t1.tv_nsec - t0.tv_nsec)) / CHECK_SAMPLES,
+	       sizeof(MS5611_Stats_TypeDef));
+	printf("# %s\n", failed ? "FAIL" : "PASS");
+
+	free(x);
+	return failed;
+}
@@ -0,0 +1,454 @@
+/* ============================================================================================
+ * ms5611_thermal_fit.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Linux host tool: identifies the MS5611Thermal coefficients from warm-up logs.
+ *
+ * Record MS5611Log files at rest while the board warms up (power-on, heater, enclosure).
+ * The ambient pressure is then nearly constant, so whatever the compensated pressure does
+ * beyond a linear trend is noise plus the thermal-lag error. For every smoothing shift the
+ * tool replays the logs through the fixed-point model exactly as the target runs it, and
+ * searches the lead time that minimizes the detrended pressure variance of all logs:
+ * a coarse grid over the range, then a golden-section refinement around the best point.
+ * Timestamps come from the nominal rate in the log header, one D1/D2 pair per sample.
+ *
+ * -g writes a synthetic warm-up log with a known lag, to check the fit end to end.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -I. tools/ms5611_thermal_fit.c MS5611Thermal.c MS5611Log.c MS5611Compensate.c -lm -o ms5611_thermal_fit
+ *
+ * Usage:
+ *   ms5611_thermal_fit [-d decimation] [-s shift] [-t min_s:max_s] [-v] log...
+ *   ms5611_thermal_fit -g lag_s out.log
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "MS5611Compensate.h"
+#include "MS5611Log.h"
+#include "MS5611Thermal.h"
+#include "ms5611_tool_util.h"
+
+#define FIT_MAX_LOGS        64
+#define FIT_GRID_POINTS     64      /**< Coarse lead grid over the search range */
+#define FIT_GOLDEN_STEPS    24      /**< Refinement steps, interval shrinks by 0.618 each */
+
+// --- Decoded Warm-Up Log ---
+typedef struct {
+  const char *name;
+  struct promData prom;
+  MS5611_Calibration_TypeDef cal;
+  uint32_t rate_hz;
+  uint32_t count;             /**< Decoded samples */
+  uint32_t *d1;
+  uint32_t *d2;
+  uint32_t *index;            /**< Sample position in the recording, bad blocks leave holes */
+  uint32_t *d2_eff;           /**< Scratch: model output */
+  int32_t *pressure;          /**< Scratch: compensated pressure */
+  int32_t *temperature;       /**< Scratch: compensated temperature */
+} Fit_Log_TypeDef;
+
+static Fit_Log_TypeDef fitLogs[FIT_MAX_LOGS];
+static int fitLogCount;
+static uint32_t fitDecimation = 1;
+
+/**
+ * @brief  Reads and decodes one log, skipping blocks that fail their CRC
+ * @param  path File name
+ * @param  log Pointer to Fit_Log_TypeDef structure
+ * @retval int 0 on success
+ */
+static int Fit_Load(const char *path, Fit_Log_TypeDef *log){
+	MS5611_Log_Header_TypeDef header;
+	uint8_t *data;
+	uint16_t capacity;
+	uint32_t blocks, b, position = 0, bad = 0;
+	size_t total = 0;
+	long size;
+	FILE *f = fopen(path, "rb");
+
+	if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < MS5611_LOG_HEADER_SIZE) {
+		fprintf(stderr, "%s: cannot read log\n", path);
+		return -1;
+	}
+	rewind(f);
+	data = malloc((size_t) size);
+	if (data == NULL || fread(data, 1, (size_t) size, f) != (size_t) size) {
+		fprintf(stderr, "%s: read error\n", path);
+		return -1;
+	}
+	fclose(f);
+
+	if (MS5611_Log_Decode_Header(data, &header) != MS5611_LOG_OK || header.rate_hz == 0) {
+		fprintf(stderr, "%s: bad log header\n", path);
+		return -1;
+	}
+
+	capacity = (uint16_t) MS5611_LOG_BLOCK_CAPACITY(header.block_size);
+	blocks = (uint32_t) ((size - MS5611_LOG_HEADER_SIZE) / header.block_size);
+	for (b = 0; b < blocks; b++) {
+		const uint8_t *block = data + MS5611_LOG_HEADER_SIZE + (size_t) b * header.block_size;
+		uint16_t stated = (uint16_t) (block[4] | (block[5] << 8));
+
+		total += (stated > capacity) ? capacity : stated;
+	}
+
+	memset(log, 0, sizeof(*log));
+	log->name = path;
+	log->rate_hz = header.rate_hz;
+	memcpy(&log->prom, header.prom, sizeof(log->prom));
+	MS5611_Calibration_Prepare(&log->prom, &log->cal);
+
+	log->d1 = malloc(total * sizeof(uint32_t) + 1);
+	log->d2 = malloc(total * sizeof(uint32_t) + 1);
+	log->index = malloc(total * sizeof(uint32_t) + 1);
+	log->d2_eff = malloc(total * sizeof(uint32_t) + 1);
+	log->pressure = malloc(total * sizeof(int32_t) + 1);
+	log->temperature = malloc(total * sizeof(int32_t) + 1);
+	if (log->d1 == NULL || log->d2 == NULL || log->index == NULL || log->d2_eff == NULL ||
+	    log->pressure == NULL || log->temperature == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return -1;
+	}
+
+	for (b = 0; b < blocks; b++) {
+		const uint8_t *block = data + MS5611_LOG_HEADER_SIZE + (size_t) b * header.block_size;
+		uint16_t stated = (uint16_t) (block[4] | (block[5] << 8));
+		uint32_t sequence;
+		uint16_t count, i;
+
+		if (MS5611_Log_Decode_Block(block, header.block_size, &sequence, log->d1 + log->count,
+		                            log->d2 + log->count, capacity, &count) != MS5611_LOG_OK) {
+			/* Keep the time base: the block's samples are missing, not absent */
+			position += (stated > capacity) ? capacity : stated;
+			bad++;
+			continue;
+		}
+
+		for (i = 0; i < count; i++)
+			log->index[log->count + i] = position + i;
+		log->count += count;
+		position += count;
+	}
+
+	free(data);
+	if (bad != 0)
+		fprintf(stderr, "%s: %u bad blocks skipped\n", path, bad);
+	if (log->count < 16) {
+		fprintf(stderr, "%s: too few samples\n", path);
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Timestamp of a sample in microseconds, from the nominal rate
+ * @param  log Pointer to Fit_Log_TypeDef structure
+ * @param  i Sample number
+ * @retval uint32_t Timestamp, wraps like a target tick counter
+ */
+static uint32_t Fit_Stamp(const Fit_Log_TypeDef *log, uint32_t i){
+	return (uint32_t) ((uint64_t) log->index[i] * 1000000U / log->rate_hz);
+}
+
+/**
+ * @brief  Variance of the pressure column around its least-squares line
+ * @param  log Pointer to Fit_Log_TypeDef structure, pressure filled
+ * @retval double Residual variance, Pa^2
+ */
+static double Fit_Detrended_Variance(const Fit_Log_TypeDef *log){
+	double n = (double) log->count;
+	double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, syy = 0.0;
+	double origin = (double) log->pressure[0];
+	double cxx, cxy, cyy;
+	uint32_t i;
+
+	for (i = 0; i < log->count; i++) {
+		double x = (double) log->index[i];
+		double y = (double) log->pressure[i] - origin;
+
+		sx += x;
+		sy += y;
+		sxx += x * x;
+		sxy += x * y;
+		syy += y * y;
+	}
+
+	cxx = sxx - sx * sx / n;
+	cxy = sxy - sx * sy / n;
+	cyy = syy - sy * sy / n;
+
+	return (cxx > 0.0 ? cyy - cxy * cxy / cxx : cyy) / n;
+}
+
+/**
+ * @brief  Replays one log through the model and compensation
+ * @param  log Pointer to Fit_Log_TypeDef structure
+ * @param  lead_us Model lead, microseconds
+ * @param  shift Model smoothing shift, negative compensates the raw D2
+ * @retval double Detrended pressure variance, Pa^2
+ */
+static double Fit_Replay(Fit_Log_TypeDef *log, int32_t lead_us, int shift){
+	MS5611_Thermal_TypeDef model;
+	uint32_t i;
+
+	if (shift < 0) {
+		MS5611_Compensate_Batch(&log->prom, log->d1, log->d2, log->pressure, log->temperature, log->count);
+		return Fit_Detrended_Variance(log);
+	}
+
+	MS5611_Thermal_Init(&model, lead_us, (uint8_t) shift, 1);
+	for (i = 0; i < log->count; i++) {
+		uint32_t stamp = Fit_Stamp(log, i);
+
+		if (log->index[i] % fitDecimation == 0)
+			MS5611_Thermal_Update(&model, log->d2[i], stamp);
+		log->d2_eff[i] = model.primed ? MS5611_Thermal_Predict(&model, stamp) : log->d2[i];
+	}
+
+	MS5611_Compensate_Batch(&log->prom, log->d1, log->d2_eff, log->pressure, log->temperature, log->count);
+	return Fit_Detrended_Variance(log);
+}
+
+/**
+ * @brief  Objective: detrended pressure variance summed over all logs
+ * @param  lead_us Model lead, microseconds
+ * @param  shift Model smoothing shift, negative for no model
+ * @retval double Summed variance, Pa^2
+ */
+static double Fit_Cost(double lead_us, int shift){
+	double cost = 0.0;
+	int l;
+
+	for (l = 0; l < fitLogCount; l++)
+		cost += Fit_Replay(&fitLogs[l], (int32_t) lround(lead_us), shift);
+
+	return cost;
+}
+
+/**
+ * @brief  Finds the best lead for one shift: coarse grid, then golden section
+ * @param  shift Model smoothing shift
+ * @param  min_us Search range start
+ * @param  max_us Search range end
+ * @param  lead_us Pointer to store the best lead
+ * @param  verbose Non-zero prints the grid
+ * @retval double Cost at the best lead
+ */
+static double Fit_Search(int shift, double min_us, double max_us, double *lead_us, int verbose){
+	const double ratio = 0.6180339887498949;
+	double step = (max_us - min_us) / (FIT_GRID_POINTS - 1);
+	double best = min_us, bestCost = INFINITY;
+	double a, b, c, d, fc, fd;
+	int i;
+
+	for (i = 0; i < FIT_GRID_POINTS; i++) {
+		double lead = min_us + step * i;
+		double cost = Fit_Cost(lead, shift);
+
+		if (verbose)
+			printf("  shift %2d  lead %9.3f s  rms %8.3f Pa\n", shift, lead * 1e-6, sqrt(cost / fitLogCount));
+		if (cost < bestCost) {
+			bestCost = cost;
+			best = lead;
+		}
+	}
+
+	a = (best - step > min_us) ? best - step : min_us;
+	b = (best + step < max_us) ? best + step : max_us;
+	c = b - ratio * (b - a);
+	d = a + ratio * (b - a);
+	fc = Fit_Cost(c, shift);
+	fd = Fit_Cost(d, shift);
+	for (i = 0; i < FIT_GOLDEN_STEPS; i++) {
+		if (fc < fd) {
+			b = d; d = c; fd = fc;
+			c = b - ratio * (b - a);
+			fc = Fit_Cost(c, shift);
+		} else {
+			a = c; c = d; fc = fd;
+			d = a + ratio * (b - a);
+			fd = Fit_Cost(d, shift);
+		}
+	}
+
+	if (fc < bestCost) {
+		bestCost = fc;
+		best = c;
+	}
+	if (fd < bestCost) {
+		bestCost = fd;
+		best = d;
+	}
+
+	*lead_us = best;
+	return bestCost;
+}
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+static int Fit_Write(void *context, const uint8_t *data, uint32_t length){
+	return fwrite(data, 1, length, (FILE *) context) == length ? 0 : -1;
+}
+
+/**
+ * @brief  Writes a synthetic 20-minute warm-up log at 50 Hz with a known die lag
+ * @note   The membrane warms from 22 to 34 degC with a 150 s time constant, the die
+ *         follows it with the given lag; constant 101325 Pa plus OSR 4096 class noise.
+ *         First-order inverse compensation, valid above 20 degC.
+ * @param  lag_s Die lag time constant, seconds
+ * @param  path Output file name
+ * @retval int 0 on success
+ */
+static int Fit_Generate(double lag_s, const char *path){
+	static const uint16_t prom[8] = {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+	const uint32_t rate = 50;
+	const uint32_t samples = 20 * 60 * rate;
+	const double dt = 1.0 / rate;
+	MS5611_Log_Encoder_TypeDef encoder;
+	struct promData p;
+	double die = 2200.0;
+	uint16_t words[8];
+	uint32_t i;
+	FILE *f = fopen(path, "wb");
+
+	if (f == NULL) {
+		perror(path);
+		return -1;
+	}
+
+	memcpy(words, prom, sizeof(words));
+	memcpy(&p, words, sizeof(p));
+	words[7] = MS5611_Prom_CRC4(&p);
+
+	if (MS5611_Log_Encoder_Init(&encoder, Fit_Write, f, words, 0x08, rate) != MS5611_LOG_OK)
+		return -1;
+
+	for (i = 0; i < samples; i++) {
+		double t = i * dt;
+		double membrane = 2200.0 + 1200.0 * (1.0 - exp(-t / 150.0));
+		double dT, off, sens, d1;
+		double pressure = 101325.0 + 1.2 * Tool_Gauss(&rngState);
+
+		die += (membrane - die) * dt / lag_s;
+
+		/* D1 follows the membrane; D2 reports the die */
+		dT = (membrane - 2000.0) * 8388608.0 / p.tempsens;
+		off = p.off * 65536.0 + p.tco * dT / 128.0;
+		sens = p.sens * 32768.0 + p.tcs * dT / 256.0;
+		d1 = (pressure * 32768.0 + off) * 2097152.0 / sens;
+		dT = (die - 2000.0) * 8388608.0 / p.tempsens;
+
+		if (MS5611_Log_Append(&encoder, (uint32_t) lround(d1),
+		                      (uint32_t) lround(p.tref * 256.0 + dT + 3.0 * Tool_Gauss(&rngState))) != MS5611_LOG_OK)
+			return -1;
+	}
+
+	if (MS5611_Log_Flush(&encoder) != MS5611_LOG_OK || fclose(f) != 0)
+		return -1;
+
+	printf("%s: %u samples at %u Hz, die lag %.2f s\n", path, samples, rate, lag_s);
+	return 0;
+}
+
+static void Fit_Usage(void){
+	fprintf(stderr,
+	        "usage: ms5611_thermal_fit [-d decimation] [-s shift] [-t min_s:max_s] [-v] log...\n"
+	        "       ms5611_thermal_fit -g lag_s out.log\n"
+	        "  -d  temperature decimation used when recording (default 1)\n"
+	        "  -s  fit only this smoothing shift (default: 0..8)\n"
+	        "  -t  lead search range in seconds (default 0:60)\n"
+	        "  -v  print the coarse grid\n"
+	        "  -g  write a synthetic warm-up log with the given die lag\n");
+}
+
+int main(int argc, char **argv){
+	double minLead = 0.0, maxLead = 60.0e6;
+	double baseline, bestCost = INFINITY, bestLead = 0.0;
+	double generate = 0.0;
+	int shiftFirst = 0, shiftLast = 8, bestShift = 0;
+	int verbose = 0;
+	int opt, shift, l;
+
+	while ((opt = getopt(argc, argv, "d:s:t:vg:")) != -1) {
+		switch (opt) {
+		case 'd': fitDecimation = (uint32_t) atoi(optarg); break;
+		case 's': shiftFirst = shiftLast = atoi(optarg); break;
+		case 't':
+			if (sscanf(optarg, "%lf:%lf", &minLead, &maxLead) != 2) {
+				Fit_Usage();
+				return 2;
+			}
+			minLead *= 1e6;
+			maxLead *= 1e6;
+			break;
+		case 'v': verbose = 1; break;
+		case 'g': generate = atof(optarg); break;
+		default: Fit_Usage(); return 2;
+		}
+	}
+
+	if (generate > 0.0) {
+		if (argc - optind != 1) {
+			Fit_Usage();
+			return 2;
+		}
+		return Fit_Generate(generate, argv[optind]) == 0 ? 0 : 1;
+	}
+
+	if (optind >= argc || argc - optind > FIT_MAX_LOGS || fitDecimation == 0 || maxLead <= minLead ||
+	    shiftFirst < 0 || shiftLast > MS5611_THERMAL_SHIFT_MAX || minLead < -2147483647.0 || maxLead > 2147483647.0) {
+		Fit_Usage();
+		return 2;
+	}
+
+	for (l = optind; l < argc; l++) {
+		Fit_Log_TypeDef *log = &fitLogs[fitLogCount];
+
+		if (Fit_Load(argv[l], log) != 0)
+			return 1;
+		Fit_Replay(log, 0, -1);
+		printf("%s: %u samples at %u Hz (%.1f min), %.2f -> %.2f degC\n", log->name, log->count, log->rate_hz,
+		       (double) log->index[log->count - 1] / log->rate_hz / 60.0,
+		       log->temperature[0] * 0.01, log->temperature[log->count - 1] * 0.01);
+		fitLogCount++;
+	}
+
+	baseline = Fit_Cost(0.0, -1);
+	printf("without model: detrended rms %.3f Pa\n", sqrt(baseline / fitLogCount));
+
+	for (shift = shiftFirst; shift <= shiftLast; shift++) {
+		double lead;
+		double cost = Fit_Search(shift, minLead, maxLead, &lead, verbose);
+
+		printf("shift %2d: lead %9.3f s, detrended rms %8.3f Pa\n", shift, lead * 1e-6, sqrt(cost / fitLogCount));
+		if (cost < bestCost) {
+			bestCost = cost;
+			bestLead = lead;
+			bestShift = shift;
+		}
+	}
+
+	printf("best: MS5611_Thermal_Init(&model, %ld, %d, ticks_per_us);  /* rms %.3f -> %.3f Pa */\n",
+	       lround(bestLead), bestShift, sqrt(baseline / fitLogCount), sqrt(bestCost / fitLogCount));
+	return 0;
+}
@@ -0,0 +1,73 @@
+/* ============================================================================================
+ * ms5611_tool_util.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Pseudo-random helpers shared by the host tools: xorshift64 (13, 7, 17), the 32-bit
+ * xorshift (13, 17, 5), a uniform double and a Box-Muller normal deviate. The generator
+ * state is passed in, so each tool keeps its own seed and threads keep their own stream.
+ * The sequences match the per-tool copies these replace, so recorded figures still hold.
+ * Header only; the tools that use Tool_Gauss link with -lm.
+ */
+
+#ifndef _MS5611_TOOL_UTIL_H_
+#define _MS5611_TOOL_UTIL_H_
+
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * @brief  Advances a 64-bit xorshift generator
+ * @param  state Generator state, must not be 0
+ * @retval uint64_t New state
+ */
+static inline uint64_t Tool_Random(uint64_t *state){
+	*state ^= *state << 13; *state ^= *state >> 7; *state ^= *state << 17;
+	return *state;
+}
+
+/**
+ * @brief  Advances a 32-bit xorshift generator
+ * @param  state Generator state, must not be 0
+ * @retval uint32_t New state
+ */
+static inline uint32_t Tool_Random32(uint32_t *state){
+	*state ^= *state << 13; *state ^= *state >> 17; *state ^= *state << 5;
+	return *state;
+}
+
+/**
+ * @brief  Draws a uniform double from the top 53 bits of the next value
+ * @param  state Generator state
+ * @retval double Value in [0, 1)
+ */
+static inline double Tool_Uniform(uint64_t *state){
+	return (Tool_Random(state) >> 11) / 9007199254740992.0;
+}
+
+/**
+ * @brief  Draws a standard normal deviate (Box-Muller, cosine branch, two values consumed)
+ * @param  state Generator state
+ * @retval double Normal deviate, mean 0 and sigma 1
+ */
+static inline double Tool_Gauss(uint64_t *state){
+	double u1 = ((Tool_Random(state) >> 11) + 1.0) / 9007199254740993.0;
+	double u2 = Tool_Uniform(state);
+
+	return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+#endif /* _MS5611_TOOL_UTIL_H_ */
@@ -0,0 +1,405 @@
+/* ============================================================================================
+ * ms5611_verify.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Differential verification and benchmark harness for the compensation variants. Every
+ * variant is run against MS5611_Compensate on blocks of samples that share one PROM, as the
+ * batch and cached variants need. PROM words and 24-bit D1/D2 are random over their full
+ * range, mixed with edge values (0, full scale, extreme PROM words) and with D2 values aimed
+ * at the TEMP < 2000 and TEMP < -1500 branches. Blocks are spread over a pool of threads;
+ * any mismatch is printed and makes the exit status non-zero. A throughput table follows,
+ * for one thread and for the whole pool, each the best of VERIFY_BENCH_REPEATS runs so a
+ * busy host skews it less.
+ *
+ * The reference squares TEMP + 1500 in int32, which overflows below -478 degC; build with
+ * -fwrapv so that case is defined and compared too.
+ *
+ * Adding a variant: wrap it as a Verify_FnTypeDef and append it to verifyVariants. The batch
+ * and int32 variants follow MS5611_CONFIG_KERNEL_BATCH and MS5611_CONFIG_KERNEL_INT32, so
+ * the harness checks exactly the kernels a given configuration builds; the reference kernel
+ * is required.
+ *
+ * There is no SIMD variant. Each sample is a chain of dependent 64-bit multiplies (dT, then
+ * OFF and SENS, then P) with a data-dependent second-order branch on TEMP. The Cortex-M33
+ * DSP extension only packs 8- and 16-bit lanes into 32-bit registers and has no vector
+ * 64-bit multiply, so the batch variant only amortizes the PROM setup.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -fwrapv -pthread -I. tools/ms5611_verify.c MS5611Compensate.c -o ms5611_verify
+ *
+ * Usage: ms5611_verify [-j threads] [-n cases] [-r seed] [-c]
+ *   -c  benchmark with cold input only (-47..20 degC, second-order branch on every sample)
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "MS5611Compensate.h"
+#include "ms5611_tool_util.h"
+
+#if !MS5611_CONFIG_KERNEL_REFERENCE
+#error "ms5611_verify compares against MS5611_Compensate, build with MS5611_CONFIG_KERNEL_REFERENCE=1"
+#endif
+
+#define VERIFY_BLOCK            256          /**< Samples per PROM */
+#define VERIFY_DEFAULT_CASES    (64UL << 20)
+#define VERIFY_BENCH_BLOCKS     4096         /**< 1M samples of realistic input per benchmark pass */
+#define VERIFY_BENCH_PASSES     32
+#define VERIFY_BENCH_REPEATS    5            /**< Throughput runs per variant, the best is reported */
+#define VERIFY_MAX_THREADS      64
+#define VERIFY_MAX_REPORTS      10
+
+typedef void (*Verify_FnTypeDef)(const struct promData *prom, const uint32_t *d1, const uint32_t *d2,
+                                 int32_t *pressure, int32_t *temperature, uint32_t count);
+
+static void Verify_Scalar(const struct promData *prom, const uint32_t *d1, const uint32_t *d2,
+                          int32_t *pressure, int32_t *temperature, uint32_t count){
+	MS5611_Raw_Data_TypeDef sample;
+	MS5611_Converted_Data_TypeDef value;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		sample.pressure = d1[i];
+		sample.temperature = d2[i];
+		MS5611_Compensate(prom, &sample, &value);
+		pressure[i] = value.pressure;
+		temperature[i] = value.temperature;
+	}
+}
+
+#if MS5611_CONFIG_KERNEL_INT32
+static void Verify_Int32(const struct promData *prom, const uint32_t *d1, const uint32_t *d2,
+                         int32_t *pressure, int32_t *temperature, uint32_t count){
+	MS5611_Raw_Data_TypeDef sample;
+	MS5611_Converted_Data_TypeDef value;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		sample.pressure = d1[i];
+		sample.temperature = d2[i];
+		MS5611_Compensate_Int32(prom, &sample, &value);
+		pressure[i] = value.pressure;
+		temperature[i] = value.temperature;
+	}
+}
+#endif
+
+/* Preparation runs per call, i.e. once per 256-sample block, as it would once per sensor */
+static void Verify_Cached(const struct promData *prom, const uint32_t *d1, const uint32_t *d2,
+                          int32_t *pressure, int32_t *temperature, uint32_t count){
+	MS5611_Calibration_TypeDef cal;
+	MS5611_Raw_Data_TypeDef sample;
+	MS5611_Converted_Data_TypeDef value;
+	uint32_t i;
+
+	MS5611_Calibration_Prepare(prom, &cal);
+	for (i = 0; i < count; i++) {
+		sample.pressure = d1[i];
+		sample.temperature = d2[i];
+		MS5611_Compensate_Cached(&cal, &sample, &value);
+		pressure[i] = value.pressure;
+		temperature[i] = value.temperature;
+	}
+}
+
+/* Entry 0 is the reference every other entry is compared against */
+static const struct {
+	const char *name;
+	Verify_FnTypeDef fn;
+} verifyVariants[] = {
+	{"scalar", Verify_Scalar},
+#if MS5611_CONFIG_KERNEL_BATCH
+	{"batch", MS5611_Compensate_Batch},
+#endif
+#if MS5611_CONFIG_KERNEL_INT32
+	{"int32", Verify_Int32},
+#endif
+	{"cached", Verify_Cached},
+};
+
+#define VERIFY_VARIANTS  (sizeof(verifyVariants) / sizeof(verifyVariants[0]))
+
+typedef struct {
+	struct promData prom;
+	uint32_t d1[VERIFY_BLOCK];
+	uint32_t d2[VERIFY_BLOCK];
+} Verify_Block_TypeDef;
+
+typedef struct {
+	pthread_t thread;
+	uint64_t rng;
+	unsigned long blocks;
+	unsigned long mismatches[VERIFY_VARIANTS];
+	unsigned long branch[3];
+} Verify_Worker_TypeDef;
+
+static pthread_mutex_t verifyPrintLock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long verifyReports;
+
+static uint32_t Verify_Random(uint64_t *state){
+	return (uint32_t) (Tool_Random(state) >> 32);
+}
+
+/* Edge value a quarter of the time, random otherwise */
+static uint32_t Verify_Pick(uint64_t *state, uint32_t full_scale){
+	static const uint32_t edges[] = {0, 1, 2, 0x7F, 0x80, 0xFF, 0x100, 0x7FFF, 0x8000};
+	uint32_t r = Verify_Random(state);
+
+	switch (r & 7) {
+	case 0: return full_scale;
+	case 1: return full_scale - (r >> 8) % 4;
+	case 2: return edges[(r >> 8) % (sizeof(edges) / sizeof(edges[0]))] & full_scale;
+	default: return Verify_Random(state) & full_scale;
+	}
+}
+
+static void Verify_Fill(uint64_t *state, Verify_Block_TypeDef *block){
+	uint32_t i;
+
+	block->prom.reserved = 0;
+	block->prom.sens = (uint16_t) Verify_Pick(state, 0xFFFF);
+	block->prom.off = (uint16_t) Verify_Pick(state, 0xFFFF);
+	block->prom.tcs = (uint16_t) Verify_Pick(state, 0xFFFF);
+	block->prom.tco = (uint16_t) Verify_Pick(state, 0xFFFF);
+	block->prom.tref = (uint16_t) Verify_Pick(state, 0xFFFF);
+	block->prom.tempsens = (uint16_t) Verify_Pick(state, 0xFFFF);
+	block->prom.crc = 0;
+
+	for (i = 0; i < VERIFY_BLOCK; i++) {
+		uint32_t r = Verify_Random(state);
+		uint32_t d2;
+
+		switch (i & 3) {
+		case 0:
+			/* Full D2 range */
+			d2 = Verify_Pick(state, 0xFFFFFF);
+			break;
+		case 1:
+			/* Just below the reference point: TEMP < 2000 */
+			d2 = ((uint32_t) block->prom.tref << 8) - (r % 0x40000);
+			break;
+		default:
+			/* Far below it: TEMP < -1500 unless TEMPSENS is tiny */
+			d2 = ((uint32_t) block->prom.tref << 8) - 0x80000 - (r % 0x780000);
+			break;
+		}
+
+		block->d1[i] = Verify_Pick(state, 0xFFFFFF);
+		block->d2[i] = d2 & 0xFFFFFF;
+	}
+}
+
+static void Verify_Report(const char *name, const Verify_Block_TypeDef *block, uint32_t i,
+                          int32_t p, int32_t t, int32_t p_ref, int32_t t_ref){
+	pthread_mutex_lock(&verifyPrintLock);
+	if (verifyReports++ < VERIFY_MAX_REPORTS)
+		printf("MISMATCH %s: C1..C6 %u %u %u %u %u %u D1 %u D2 %u: P %d (ref %d) T %d (ref %d)\n", name,
+		       block->prom.sens, block->prom.off, block->prom.tcs, block->prom.tco, block->prom.tref,
+		       block->prom.tempsens, block->d1[i], block->d2[i], p, p_ref, t, t_ref);
+	pthread_mutex_unlock(&verifyPrintLock);
+}
+
+static void *Verify_Worker(void *argument){
+	Verify_Worker_TypeDef *w = (Verify_Worker_TypeDef *) argument;
+	Verify_Block_TypeDef block;
+	int32_t pRef[VERIFY_BLOCK], tRef[VERIFY_BLOCK];
+	int32_t p[VERIFY_BLOCK], t[VERIFY_BLOCK];
+	unsigned long b;
+	uint32_t i;
+	size_t v;
+
+	for (b = 0; b < w->blocks; b++) {
+		Verify_Fill(&w->rng, &block);
+		verifyVariants[0].fn(&block.prom, block.d1, block.d2, pRef, tRef, VERIFY_BLOCK);
+
+		for (i = 0; i < VERIFY_BLOCK; i++) {
+			int32_t dT = block.d2[i] - ((int32_t) (block.prom.tref << 8));
+			int32_t TEMP = 2000 + (int32_t) (((int64_t) dT * block.prom.tempsens) >> 23);
+			w->branch[(TEMP >= 2000) ? 0 : (TEMP >= -1500) ? 1 : 2]++;
+		}
+
+		for (v = 1; v < VERIFY_VARIANTS; v++) {
+			verifyVariants[v].fn(&block.prom, block.d1, block.d2, p, t, VERIFY_BLOCK);
+			for (i = 0; i < VERIFY_BLOCK; i++) {
+				if (p[i] != pRef[i] || t[i] != tRef[i]) {
+					w->mismatches[v]++;
+					Verify_Report(verifyVariants[v].name, &block, i, p[i], t[i], pRef[i], tRef[i]);
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/* Benchmark input: datasheet calibration, D1 around 1000 hPa, D2 sweeping -20..+60 degC */
+static Verify_Block_TypeDef *verifyBench;
+
+typedef struct {
+	pthread_t thread;
+	Verify_FnTypeDef fn;
+	unsigned first;
+	unsigned count;
+	int64_t checksum;
+} Verify_Bench_TypeDef;
+
+static void *Verify_Bench_Worker(void *argument){
+	Verify_Bench_TypeDef *w = (Verify_Bench_TypeDef *) argument;
+	int32_t p[VERIFY_BLOCK], t[VERIFY_BLOCK];
+	unsigned pass, b;
+
+	for (pass = 0; pass < VERIFY_BENCH_PASSES; pass++) {
+		for (b = w->first; b < w->first + w->count; b++) {
+			const Verify_Block_TypeDef *block = &verifyBench[b];
+			w->fn(&block->prom, block->d1, block->d2, p, t, VERIFY_BLOCK);
+			w->checksum += p[VERIFY_BLOCK - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static double Verify_Seconds(void){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double) t.tv_sec + (double) t.tv_nsec * 1e-9;
+}
+
+static double Verify_Throughput(Verify_FnTypeDef fn, unsigned threads){
+	static Verify_Bench_TypeDef workers[VERIFY_MAX_THREADS];
+	unsigned per = VERIFY_BENCH_BLOCKS / threads;
+	double best = 0.0;
+	unsigned r, i;
+
+	for (r = 0; r < VERIFY_BENCH_REPEATS; r++) {
+		double t0 = Verify_Seconds();
+		double rate;
+
+		for (i = 0; i < threads; i++) {
+			workers[i].fn = fn;
+			workers[i].first = i * per;
+			workers[i].count = (i + 1 == threads) ? VERIFY_BENCH_BLOCKS - i * per : per;
+			workers[i].checksum = 0;
+			pthread_create(&workers[i].thread, NULL, Verify_Bench_Worker, &workers[i]);
+		}
+		for (i = 0; i < threads; i++)
+			pthread_join(workers[i].thread, NULL);
+
+		rate = (double) VERIFY_BENCH_BLOCKS * VERIFY_BLOCK * VERIFY_BENCH_PASSES / (Verify_Seconds() - t0) / 1e6;
+		if (rate > best)
+			best = rate;
+	}
+
+	return best;
+}
+
+int main(int argc, char **argv){
+	static Verify_Worker_TypeDef workers[VERIFY_MAX_THREADS];
+	unsigned long cases = VERIFY_DEFAULT_CASES;
+	unsigned long mismatches[VERIFY_VARIANTS] = {0};
+	unsigned long branch[3] = {0};
+	unsigned long blocks, per;
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	unsigned threads = (online > 0) ? (unsigned) online : 1;
+	uint64_t seed = 1;
+	uint64_t rng;
+	double t0, elapsed;
+	int failed = 0;
+	int cold = 0;
+	unsigned i;
+	size_t v;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "j:n:r:c")) != -1) {
+		switch (opt) {
+		case 'c': cold = 1; break;
+		case 'j': threads = (unsigned) atoi(optarg); break;
+		case 'n': cases = strtoul(optarg, NULL, 0); break;
+		case 'r': seed = strtoull(optarg, NULL, 0); break;
+		default:
+			fprintf(stderr, "usage: %s [-j threads] [-n cases] [-r seed] [-c]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (threads < 1)
+		threads = 1;
+	if (threads > VERIFY_MAX_THREADS)
+		threads = VERIFY_MAX_THREADS;
+
+	/* Verification sweep */
+	blocks = (cases + VERIFY_BLOCK - 1) / VERIFY_BLOCK;
+	per = blocks / threads;
+	t0 = Verify_Seconds();
+	for (i = 0; i < threads; i++) {
+		workers[i].rng = (seed + i + 1) * 0x9E3779B97F4A7C15ULL;
+		workers[i].blocks = (i + 1 == threads) ? blocks - i * per : per;
+		pthread_create(&workers[i].thread, NULL, Verify_Worker, &workers[i]);
+	}
+	for (i = 0; i < threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		for (v = 0; v < VERIFY_VARIANTS; v++)
+			mismatches[v] += workers[i].mismatches[v];
+		branch[0] += workers[i].branch[0];
+		branch[1] += workers[i].branch[1];
+		branch[2] += workers[i].branch[2];
+	}
+	elapsed = Verify_Seconds() - t0;
+
+	printf("cases %lu on %u threads in %.1f s\n", blocks * VERIFY_BLOCK, threads, elapsed);
+	printf("branches: TEMP >= 2000 %lu, -1500 <= TEMP < 2000 %lu, TEMP < -1500 %lu\n", branch[0], branch[1], branch[2]);
+
+	/* Throughput on realistic input, -7..47 degC or -47..20 degC with -c */
+	verifyBench = malloc(VERIFY_BENCH_BLOCKS * sizeof(Verify_Block_TypeDef));
+	rng = seed * 0x9E3779B97F4A7C15ULL;
+	for (i = 0; i < VERIFY_BENCH_BLOCKS; i++) {
+		uint32_t s;
+
+		verifyBench[i].prom = (struct promData) {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+		for (s = 0; s < VERIFY_BLOCK; s++) {
+			verifyBench[i].d1[s] = 9085466 + Verify_Random(&rng) % 200000 - 100000;
+			if (cold)
+				verifyBench[i].d2[s] = 8569150 - (uint32_t) (i * VERIFY_BLOCK + s) % 2000000;
+			else
+				verifyBench[i].d2[s] = 8569150 + (uint32_t) (i * VERIFY_BLOCK + s) % 1600000 - 800000;
+		}
+	}
+
+	printf("\n%-10s %12s %16s %16s %9s\n", "variant", "mismatches", "Msamples/s x1", "Msamples/s xN", "vs scalar");
+	{
+		double base = 0.0;
+
+		for (v = 0; v < VERIFY_VARIANTS; v++) {
+			double single = Verify_Throughput(verifyVariants[v].fn, 1);
+			double all = Verify_Throughput(verifyVariants[v].fn, threads);
+
+			if (v == 0)
+				base = single;
+			printf("%-10s %12lu %16.1f %16.1f %8.2fx\n", verifyVariants[v].name, mismatches[v], single, all, single / base);
+			if (mismatches[v] != 0)
+				failed = 1;
+		}
+	}
+
+	free(verifyBench);
+	printf("\n%s\n", failed ? "FAIL" : "PASS");
+	return failed;
+}
@@ -0,0 +1,127 @@
+/* ============================================================================================
+ * cmsis_os2.h
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Host stand-in for CMSIS-RTOS2, just the subset MS5611RTOS uses, implemented on POSIX
+ * threads by cmsis_os2_posix.c. Names and semantics follow the CMSIS-RTOS2 API; thread
+ * priorities are accepted and ignored. The port also counts thread flag wakeups and
+ * osDelay overshoot, read back with osHostStatsGet.
+ */
+
+#ifndef _HOST_CMSIS_OS2_H_
+#define _HOST_CMSIS_OS2_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define osWaitForever         0xFFFFFFFFU
+
+#define osFlagsWaitAny        0x00000000U
+#define osFlagsWaitAll        0x00000001U
+#define osFlagsNoClear        0x00000002U
+
+#define osFlagsError          0x80000000U
+#define osFlagsErrorTimeout   0xFFFFFFFEU
+#define osFlagsErrorResource  0xFFFFFFFDU
+#define osFlagsErrorParameter 0xFFFFFFFCU
+
+typedef enum {
+  osOK                  =  0,
+  osError               = -1,
+  osErrorTimeout        = -2,
+  osErrorResource       = -3,
+  osErrorParameter      = -4
+} osStatus_t;
+
+typedef enum {
+  osPriorityLow         =  8,
+  osPriorityNormal      = 24,
+  osPriorityAboveNormal = 32,
+  osPriorityHigh        = 40,
+  osPriorityRealtime    = 48
+} osPriority_t;
+
+typedef void *osThreadId_t;
+typedef void *osMutexId_t;
+typedef void (*osThreadFunc_t)(void *argument);
+
+typedef struct {
+  const char *name;
+  uint32_t attr_bits;
+  void *cb_mem;
+  uint32_t cb_size;
+  void *stack_mem;
+  uint32_t stack_size;
+  osPriority_t priority;
+  uint32_t tz_module;
+  uint32_t reserved;
+} osThreadAttr_t;
+
+typedef struct {
+  const char *name;
+  uint32_t attr_bits;
+  void *cb_mem;
+  uint32_t cb_size;
+} osMutexAttr_t;
+
+// --- Host Port Statistics ---
+#define OS_HOST_WAKEUP_BINS   10000U  /**< 1 us wakeup latency bins, last bin collects overflow */
+
+typedef struct {
+  uint64_t wakeups;                   /**< Thread flag waits ended by osThreadFlagsSet */
+  uint64_t wakeup_ns;                 /**< Sum of set-to-running latencies */
+  uint64_t wakeup_max_ns;
+  uint32_t wakeup_bins[OS_HOST_WAKEUP_BINS];
+  uint64_t delays;                    /**< osDelay calls */
+  uint64_t delay_over_ns;             /**< Sum of time slept beyond the requested ticks */
+  uint64_t delay_over_max_ns;
+} osHostStats_t;
+
+uint32_t osKernelGetTickFreq(void);
+uint32_t osKernelGetTickCount(void);
+osStatus_t osDelay(uint32_t ticks);
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr);
+osThreadId_t osThreadGetId(void);
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+uint32_t osThreadFlagsClear(uint32_t flags);
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr);
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+
+/**
+ * @brief  Copies the wakeup and delay statistics of the host port
+ * @param  stats Pointer to statistics to fill
+ */
+void osHostStatsGet(osHostStats_t *stats);
+
+/**
+ * @brief  Clears the wakeup and delay statistics of the host port
+ */
+void osHostStatsReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_CMSIS_OS2_H_ */
@@ -0,0 +1,272 @@
+/* ============================================================================================
+ * cmsis_os2_posix.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * CMSIS-RTOS2 subset on POSIX threads. Each thread carries its flags under a mutex and a
+ * CLOCK_MONOTONIC condition variable; osThreadFlagsSet stamps the time it satisfied a
+ * waiter, so the waiter can account the latency until it runs again. The kernel tick is
+ * 1 kHz and osDelay(n) sleeps n ms, accounting what the host scheduler adds on top.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cmsis_os2.h"
+
+#define OS_HOST_TICK_FREQ     1000U
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	uint32_t flags;
+	uint64_t set_ns;                  /**< When osThreadFlagsSet last satisfied a wait */
+	osThreadFunc_t func;
+	void *argument;
+} osHostThread_t;
+
+static __thread osHostThread_t *osHostCurrent;
+static pthread_mutex_t osHostStatsLock = PTHREAD_MUTEX_INITIALIZER;
+static osHostStats_t osHostStats;
+static uint64_t osHostStartNs;
+
+static uint64_t osHostNow(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec;
+}
+
+static void osHostDeadline(struct timespec *ts, uint32_t ticks){
+	uint64_t at = osHostNow() + (uint64_t) ticks * (1000000000U / OS_HOST_TICK_FREQ);
+
+	ts->tv_sec = (time_t) (at / 1000000000U);
+	ts->tv_nsec = (long) (at % 1000000000U);
+}
+
+static osHostThread_t *osHostThreadCreate(void){
+	osHostThread_t *thread = calloc(1, sizeof(*thread));
+	pthread_condattr_t attr;
+
+	if (thread == NULL)
+		return NULL;
+
+	pthread_mutex_init(&thread->lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&thread->wake, &attr);
+	pthread_condattr_destroy(&attr);
+
+	return thread;
+}
+
+static void *osHostTrampoline(void *argument){
+	osHostThread_t *thread = argument;
+
+	osHostCurrent = thread;
+	thread->func(thread->argument);
+
+	return NULL;
+}
+
+uint32_t osKernelGetTickFreq(void){
+	return OS_HOST_TICK_FREQ;
+}
+
+uint32_t osKernelGetTickCount(void){
+	if (osHostStartNs == 0)
+		osHostStartNs = osHostNow();
+
+	return (uint32_t) ((osHostNow() - osHostStartNs) / (1000000000U / OS_HOST_TICK_FREQ));
+}
+
+osStatus_t osDelay(uint32_t ticks){
+	uint64_t wanted = (uint64_t) ticks * (1000000000U / OS_HOST_TICK_FREQ);
+	uint64_t start = osHostNow();
+	uint64_t over;
+	struct timespec ts;
+
+	ts.tv_sec = (time_t) (wanted / 1000000000U);
+	ts.tv_nsec = (long) (wanted % 1000000000U);
+	while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) == EINTR)
+		;
+
+	over = osHostNow() - start - wanted;
+	pthread_mutex_lock(&osHostStatsLock);
+	osHostStats.delays++;
+	osHostStats.delay_over_ns += over;
+	if (over > osHostStats.delay_over_max_ns)
+		osHostStats.delay_over_max_ns = over;
+	pthread_mutex_unlock(&osHostStatsLock);
+
+	return osOK;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr){
+	osHostThread_t *thread = osHostThreadCreate();
+	pthread_t handle;
+
+	(void) attr;
+	if (thread == NULL)
+		return NULL;
+
+	thread->func = func;
+	thread->argument = argument;
+	if (pthread_create(&handle, NULL, osHostTrampoline, thread) != 0) {
+		free(thread);
+		return NULL;
+	}
+	pthread_detach(handle);
+
+	return thread;
+}
+
+osThreadId_t osThreadGetId(void){
+	if (osHostCurrent == NULL)
+		osHostCurrent = osHostThreadCreate();
+
+	return osHostCurrent;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags){
+	osHostThread_t *thread = thread_id;
+	uint32_t result;
+
+	if (thread == NULL || (flags & osFlagsError))
+		return osFlagsErrorParameter;
+
+	pthread_mutex_lock(&thread->lock);
+	thread->flags |= flags;
+	thread->set_ns = osHostNow();
+	result = thread->flags;
+	pthread_cond_signal(&thread->wake);
+	pthread_mutex_unlock(&thread->lock);
+
+	return result;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags){
+	osHostThread_t *thread = osThreadGetId();
+	uint32_t result;
+
+	pthread_mutex_lock(&thread->lock);
+	result = thread->flags;
+	thread->flags &= ~flags;
+	pthread_mutex_unlock(&thread->lock);
+
+	return result;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout){
+	osHostThread_t *thread = osThreadGetId();
+	struct timespec deadline;
+	uint32_t result;
+	uint64_t latency;
+	int waited = 0;
+
+	if (timeout != osWaitForever)
+		osHostDeadline(&deadline, timeout);
+
+	pthread_mutex_lock(&thread->lock);
+	for (;;) {
+		uint32_t match = thread->flags & flags;
+
+		if ((options & osFlagsWaitAll) ? (match == flags) : (match != 0))
+			break;
+		if (timeout == 0) {
+			pthread_mutex_unlock(&thread->lock);
+			return osFlagsErrorResource;
+		}
+		if (timeout == osWaitForever) {
+			pthread_cond_wait(&thread->wake, &thread->lock);
+		} else if (pthread_cond_timedwait(&thread->wake, &thread->lock, &deadline) == ETIMEDOUT) {
+			pthread_mutex_unlock(&thread->lock);
+			return osFlagsErrorTimeout;
+		}
+		waited = 1;
+	}
+
+	result = thread->flags;
+	if (!(options & osFlagsNoClear))
+		thread->flags &= ~flags;
+	latency = osHostNow() - thread->set_ns;
+	pthread_mutex_unlock(&thread->lock);
+
+	if (waited) {
+		pthread_mutex_lock(&osHostStatsLock);
+		osHostStats.wakeups++;
+		osHostStats.wakeup_ns += latency;
+		if (latency > osHostStats.wakeup_max_ns)
+			osHostStats.wakeup_max_ns = latency;
+		osHostStats.wakeup_bins[(latency / 1000U < OS_HOST_WAKEUP_BINS) ? latency / 1000U : OS_HOST_WAKEUP_BINS - 1]++;
+		pthread_mutex_unlock(&osHostStatsLock);
+	}
+
+	return result;
+}
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr){
+	pthread_mutex_t *mutex = malloc(sizeof(*mutex));
+
+	(void) attr;
+	if (mutex != NULL)
+		pthread_mutex_init(mutex, NULL);
+
+	return mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout){
+	struct timespec deadline;
+
+	if (mutex_id == NULL)
+		return osErrorParameter;
+	if (timeout == osWaitForever)
+		return (pthread_mutex_lock(mutex_id) == 0) ? osOK : osError;
+	if (timeout == 0)
+		return (pthread_mutex_trylock(mutex_id) == 0) ? osOK : osErrorResource;
+
+	/* pthread_mutex_timedlock takes CLOCK_REALTIME */
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_nsec += (long) (timeout % 1000U) * 1000000L;
+	deadline.tv_sec += (time_t) (timeout / 1000U + (uint32_t) (deadline.tv_nsec / 1000000000L));
+	deadline.tv_nsec %= 1000000000L;
+
+	return (pthread_mutex_timedlock(mutex_id, &deadline) == 0) ? osOK : osErrorTimeout;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id){
+	if (mutex_id == NULL)
+		return osErrorParameter;
+
+	return (pthread_mutex_unlock(mutex_id) == 0) ? osOK : osErrorResource;
+}
+
+void osHostStatsGet(osHostStats_t *stats){
+	pthread_mutex_lock(&osHostStatsLock);
+	*stats = osHostStats;
+	pthread_mutex_unlock(&osHostStatsLock);
+}
+
+void osHostStatsReset(void){
+	pthread_mutex_lock(&osHostStatsLock);
+	memset(&osHostStats, 0, sizeof(osHostStats));
+	pthread_mutex_unlock(&osHostStatsLock);
+}
@@ -0,0 +1,394 @@
+/* ============================================================================================
+ * ms5611_rtos_host.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Host run of the unmodified MS5611RTOS task on the POSIX CMSIS-RTOS2 port, in real time.
+ * An interrupt thread stands in for the SPI peripheral: HAL_SPI_TransmitReceive_IT hands
+ * it the transfer, it waits the bit time, clocks an MS5611 model (datasheet example PROM
+ * and words, 0 when read before the conversion ends) and calls HAL_SPI_TxRxCpltCallback.
+ *
+ * The task runs MS5611_RTOS_Sensor_Init and then samples for -T seconds. The report gives
+ * the thread flag wakeup latency (completion callback to task running) and the osDelay
+ * overshoot from the port, the CPU time of the task and interrupt threads against wall
+ * time, and the count of blocking HAL calls (HAL_Delay and polled SPI), which must be 0.
+ * With MS5611_CONFIG_STATS it also prints the handle's Timing statistics, which the task
+ * must update on every D1 read.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -pthread -Itools/rtos -Itools/sim -I. tools/rtos/ms5611_rtos_host.c \
+ *      tools/rtos/cmsis_os2_posix.c MS5611RTOS.c MS5611SPI.c MS5611Compensate.c \
+ *      MS5611Filter.c MS5611Thermal.c MS5611Hub.c -o ms5611_rtos_host
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stm32h5xx_hal.h"
+#include "MS5611RTOS.h"
+
+#define HOST_SPI_HZ          8000000U
+#define HOST_D1              9085466U  /**< Datasheet example words, 2007 (0.01 degC), 100009 Pa */
+#define HOST_D2              8569150U
+#define HOST_PRESSURE        100009
+#define HOST_TEMPERATURE     2007
+
+/* Datasheet typical conversion times; the driver waits for the maximum ones */
+static const uint32_t hostConversionNs[5] = {540000, 1060000, 2080000, 4130000, 8220000};
+
+/* Datasheet example calibration, CRC filled in at start */
+static struct promData hostProm = {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+
+// --- MS5611 Model and SPI Interrupt Thread ---
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	uint8_t pending;              /**< Transfer handed over, not yet completed */
+	SPI_HandleTypeDef *hspi;
+	const uint8_t *tx;
+	uint8_t *rx;
+	uint16_t size;
+	uint8_t selected;
+	uint8_t converting;           /**< 0, CONVERT_D1_COMMAND or CONVERT_D2_COMMAND */
+	uint8_t osr_index;
+	uint64_t conv_done;
+	uint64_t busy_until;
+	uint32_t early_reads;
+	uint32_t transfers;
+} hostDev = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, NULL, NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0};
+
+static volatile uint32_t hostBlockingCalls;
+static MS5611_RTOS_TypeDef hostBaro;
+static MS5611_HW_InitTypeDef hostHandle;
+static SPI_HandleTypeDef hostSpi;
+static GPIO_TypeDef hostGpio;
+static clockid_t hostIsrClock;
+static volatile uint8_t hostIsrReady;
+
+/* Sample accounting, written by the task */
+static volatile uint32_t hostSamples;
+static volatile uint32_t hostMismatches;
+static clockid_t hostTaskClock;
+static volatile uint8_t hostTaskReady;
+
+uint32_t SystemCoreClock = 250000000U;
+
+static uint64_t Host_Now(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec;
+}
+
+static uint64_t Host_Cpu(clockid_t clock){
+	struct timespec ts;
+
+	clock_gettime(clock, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec;
+}
+
+static uint32_t Host_Timestamp(void){
+	return (uint32_t) (Host_Now() / 1000U);
+}
+
+/* Decodes one CS-framed transfer: the first byte is the command, the rest clocks out the reply */
+static void Host_Device_Transfer(const uint8_t *tx, uint8_t *rx, uint16_t size){
+	uint64_t now = Host_Now();
+	uint8_t command = tx[0];
+	uint32_t word = 0;
+	uint16_t i;
+
+	memset(rx, 0xFF, size);
+	if (now < hostDev.busy_until)
+		return;
+
+	if (command == RESET_COMMAND) {
+		hostDev.converting = 0;
+		hostDev.busy_until = now + 2800000U;
+	} else if ((command & 0xE0) == 0x40) {
+		hostDev.converting = command & 0xF0;
+		hostDev.osr_index = (uint8_t) ((command & 0x0F) >> 1);
+		if (hostDev.osr_index > 4)
+			hostDev.osr_index = 4;
+		hostDev.conv_done = now + hostConversionNs[hostDev.osr_index];
+	} else if (command == READ_ADC_COMMAND) {
+		if (hostDev.converting && now >= hostDev.conv_done)
+			word = (hostDev.converting == CONVERT_D1_COMMAND) ? HOST_D1 : HOST_D2;
+		else
+			hostDev.early_reads++;
+		hostDev.converting = 0;
+		for (i = 1; i < size && i < 4; i++)
+			rx[i] = (uint8_t) (word >> (8 * (3 - i)));
+	} else if ((command & 0xF0) == 0xA0) {
+		word = ((const uint16_t *) &hostProm)[(command >> 1) & 0x07];
+		if (size > 1)
+			rx[1] = (uint8_t) (word >> 8);
+		if (size > 2)
+			rx[2] = (uint8_t) word;
+	}
+}
+
+/* Interrupt thread: bit time, device model, then the HAL completion callback */
+static void *Host_Isr(void *argument){
+	(void) argument;
+	pthread_getcpuclockid(pthread_self(), &hostIsrClock);
+	hostIsrReady = 1;
+
+	pthread_mutex_lock(&hostDev.lock);
+	for (;;) {
+		struct timespec bit;
+		SPI_HandleTypeDef *hspi;
+
+		while (!hostDev.pending)
+			pthread_cond_wait(&hostDev.start, &hostDev.lock);
+		pthread_mutex_unlock(&hostDev.lock);
+
+		bit.tv_sec = 0;
+		bit.tv_nsec = (long) ((uint64_t) hostDev.size * 8U * 1000000000U / HOST_SPI_HZ);
+		while (nanosleep(&bit, &bit) == EINTR)
+			;
+		if (hostDev.selected)
+			Host_Device_Transfer(hostDev.tx, hostDev.rx, hostDev.size);
+		hostDev.transfers++;
+
+		pthread_mutex_lock(&hostDev.lock);
+		hspi = hostDev.hspi;
+		hostDev.pending = 0;
+		pthread_mutex_unlock(&hostDev.lock);
+		HAL_SPI_TxRxCpltCallback(hspi);
+		pthread_mutex_lock(&hostDev.lock);
+	}
+
+	return NULL;
+}
+
+// --- HAL Stand-In; every blocking entry point is counted and fails ---
+uint32_t HAL_GetTick(void){
+	return (uint32_t) (Host_Now() / 1000000U);
+}
+
+void HAL_Delay(uint32_t Delay){
+	(void) Delay;
+	hostBlockingCalls++;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState){
+	(void) GPIOx;
+	(void) GPIO_Pin;
+	hostDev.selected = (PinState == GPIO_PIN_RESET);
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi){
+	(void) hspi;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_DeInit(SPI_HandleTypeDef *hspi){
+	(void) hspi;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi){
+	(void) hspi;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size, uint32_t Timeout){
+	(void) hspi; (void) pData; (void) Size; (void) Timeout;
+	hostBlockingCalls++;
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+	(void) hspi; (void) pData; (void) Size; (void) Timeout;
+	hostBlockingCalls++;
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout){
+	(void) hspi; (void) pTxData; (void) pRxData; (void) Size; (void) Timeout;
+	hostBlockingCalls++;
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size){
+	pthread_mutex_lock(&hostDev.lock);
+	if (hostDev.pending) {
+		pthread_mutex_unlock(&hostDev.lock);
+		return HAL_BUSY;
+	}
+	hostDev.hspi = hspi;
+	hostDev.tx = pTxData;
+	hostDev.rx = pRxData;
+	hostDev.size = Size;
+	hostDev.pending = 1;
+	pthread_cond_signal(&hostDev.start);
+	pthread_mutex_unlock(&hostDev.lock);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size){
+	return HAL_SPI_TransmitReceive_IT(hspi, pTxData, pRxData, Size);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){
+	MS5611_RTOS_SPI_Complete(&hostBaro, hspi);
+}
+
+static void Host_On_Sample(void *context, const MS5611_Raw_Data_TypeDef *raw, const MS5611_Converted_Data_TypeDef *value){
+	(void) context;
+	(void) raw;
+
+	if (!hostTaskReady) {
+		pthread_getcpuclockid(pthread_self(), &hostTaskClock);
+		hostTaskReady = 1;
+	}
+	if (value->pressure != HOST_PRESSURE || value->temperature != HOST_TEMPERATURE)
+		hostMismatches++;
+	hostSamples++;
+}
+
+static uint64_t Host_Wakeup_Percentile(const osHostStats_t *stats, double fraction){
+	uint64_t target = (uint64_t) (fraction * (double) stats->wakeups + 0.5);
+	uint64_t seen = 0;
+	uint32_t i;
+
+	if (target == 0)
+		target = 1;
+	for (i = 0; i < OS_HOST_WAKEUP_BINS; i++) {
+		seen += stats->wakeup_bins[i];
+		if (seen >= target)
+			return i;
+	}
+
+	return OS_HOST_WAKEUP_BINS - 1;
+}
+
+int main(int argc, char **argv){
+	osHostStats_t stats;
+	pthread_t isr;
+	uint32_t osrValue = 4096;
+	uint8_t osrIndex;
+	uint8_t decimation = 1;
+	double seconds = 5.0;
+	uint64_t wallStart, taskStart, isrStart, wall;
+	uint32_t samplesStart, samples;
+	double taskCpu, isrCpu;
+	struct timespec pause;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "o:d:T:")) != -1) {
+		switch (opt) {
+		case 'o': osrValue = (uint32_t) atol(optarg); break;
+		case 'd': decimation = (uint8_t) atoi(optarg); break;
+		case 'T': seconds = atof(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-o osr] [-d decimation] [-T seconds]\n", argv[0]);
+			return 2;
+		}
+	}
+	for (osrIndex = 0; osrIndex < 5 && (256U << osrIndex) != osrValue; osrIndex++)
+		;
+	if (osrIndex == 5 || decimation == 0 || seconds <= 0.0) {
+		fprintf(stderr, "usage: %s [-o osr] [-d decimation] [-T seconds]\n", argv[0]);
+		return 2;
+	}
+
+	hostProm.crc = MS5611_Prom_CRC4(&hostProm);
+	if (pthread_create(&isr, NULL, Host_Isr, NULL) != 0) {
+		fprintf(stderr, "cannot start the interrupt thread\n");
+		return 1;
+	}
+
+	hostHandle.SPIhandler = &hostSpi;
+	hostHandle.CS_GPIOport = &hostGpio;
+	hostHandle.CS_GPIOpin = 1;
+	hostHandle.SPI_Timeout = 10;
+	hostHandle.GetTimestamp = Host_Timestamp;
+	hostHandle.TicksPerUs = 1;
+
+	MS5611_RTOS_Init(&hostBaro, &hostHandle, NULL);
+	hostBaro.osr = (uint8_t) (osrIndex << 1);
+	hostBaro.temperature_decimation = decimation;
+	hostBaro.on_sample = Host_On_Sample;
+	if (osThreadNew(MS5611_RTOS_Task, &hostBaro, &(osThreadAttr_t){ .name = "baro", .priority = osPriorityAboveNormal }) == NULL) {
+		fprintf(stderr, "cannot start the sensor task\n");
+		return 1;
+	}
+
+	/* Measure from the first sample on, after the task-context initialization */
+	while (!hostTaskReady || !hostIsrReady) {
+		pause.tv_sec = 0;
+		pause.tv_nsec = 1000000L;
+		nanosleep(&pause, NULL);
+	}
+	osHostStatsReset();
+	samplesStart = hostSamples;
+	wallStart = Host_Now();
+	taskStart = Host_Cpu(hostTaskClock);
+	isrStart = Host_Cpu(hostIsrClock);
+
+	pause.tv_sec = (time_t) seconds;
+	pause.tv_nsec = (long) ((seconds - (double) pause.tv_sec) * 1e9);
+	while (nanosleep(&pause, &pause) == EINTR)
+		;
+
+	wall = Host_Now() - wallStart;
+	taskCpu = (double) (Host_Cpu(hostTaskClock) - taskStart);
+	isrCpu = (double) (Host_Cpu(hostIsrClock) - isrStart);
+	samples = hostSamples - samplesStart;
+	osHostStatsGet(&stats);
+
+	printf("config: osr %u, decimation %u, spi %u Hz, tick %u Hz, %.3f s\n", osrValue, decimation, HOST_SPI_HZ,
+	       osKernelGetTickFreq(), wall * 1e-9);
+	printf("init: MS5611_RTOS_Sensor_Init %s, blocking HAL calls (HAL_Delay, polled SPI) %u\n",
+	       hostSamples ? "ready" : "FAILED", hostBlockingCalls);
+	printf("samples: %u (%.2f Hz), %u not matching the datasheet example, %u early reads, %u transfers\n", samples,
+	       samples / (wall * 1e-9), hostMismatches, hostDev.early_reads, hostDev.transfers);
+	if (stats.wakeups != 0)
+		printf("wakeup latency, callback to task (us): mean %.1f  p50 %llu  p99 %llu  max %.1f  (%llu wakeups)\n",
+		       stats.wakeup_ns / 1e3 / (double) stats.wakeups, (unsigned long long) Host_Wakeup_Percentile(&stats, 0.5),
+		       (unsigned long long) Host_Wakeup_Percentile(&stats, 0.99), stats.wakeup_max_ns / 1e3,
+		       (unsigned long long) stats.wakeups);
+	if (stats.delays != 0)
+		printf("osDelay overshoot (us): mean %.1f  max %.1f  (%llu delays)\n", stats.delay_over_ns / 1e3 / (double) stats.delays,
+		       stats.delay_over_max_ns / 1e3, (unsigned long long) stats.delays);
+	printf("cpu: task %.3f %%, interrupt thread %.3f %%, idle %.3f %% of one core; task %.2f us per sample\n",
+	       100.0 * taskCpu / (double) wall, 100.0 * isrCpu / (double) wall, 100.0 * (1.0 - (taskCpu + isrCpu) / (double) wall),
+	       samples ? taskCpu / 1e3 / samples : 0.0);
+
+#if MS5611_CONFIG_STATS
+	if (hostHandle.Timing.samples != 0)
+		printf("timing (us): latency min %u  mean %.1f  max %u, interval min %u  max %u  (%u D1 reads)\n",
+		       hostHandle.Timing.latency_min, (double) hostHandle.Timing.latency_sum / hostHandle.Timing.samples,
+		       hostHandle.Timing.latency_max, hostHandle.Timing.interval_min, hostHandle.Timing.interval_max,
+		       hostHandle.Timing.samples);
+	else
+		printf("timing: no D1 read recorded in the handle statistics\n");
+	if (hostHandle.Timing.samples < hostSamples)
+		return 1;
+#endif
+
+	return (hostBlockingCalls != 0 || hostMismatches != 0 || samples == 0) ? 1 : 0;
+}
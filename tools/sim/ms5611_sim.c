@@ -0,0 +1,987 @@
+/* ============================================================================================
+ * ms5611_sim.c
+ *
+ * Created on: Oct 16, 2026
+ * Author: Nathan Netzel
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 Nathan Netzel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the conditions of the MIT License.
+ * ============================================================================================
+ *
+ * Deterministic discrete-event simulation of the acquisition engine. The unmodified driver
+ * (MS5611SPI.c) is linked against the HAL stand-in in this directory: SPI, GPIO, HAL_GetTick
+ * and HAL_Delay run on a virtual nanosecond clock, and every chip select addresses an
+ * MS5611 device model that decodes commands byte by byte, converts with the datasheet
+ * typical times and returns 0 when read before its conversion has finished.
+ *
+ * Time only advances through events: a blocking SPI call costs its bit time plus a fixed
+ * call overhead, each engine poll costs a fixed CPU time, and an optional interrupt load
+ * delays polls by a random amount. Between polls the clock jumps straight to the next
+ * wakeup, so hours of acquisition run in seconds and the same seed gives the same report.
+ *
+ * Two schedules are modelled:
+ *   poll   every sensor is polled on a fixed timer grid (-p)
+ *   timed  each sensor wakes exactly when its conversion or recovery wait is due
+ *
+ * The report gives, per sensor, the delivered rate against the nominal one, stream losses
+ * and deadline misses (MS5611Stream), bus errors and recoveries; per bus, the utilization;
+ * and the distribution of read latency past the earliest permitted read. The stream rate
+ * is also taken from MS5611_Stream_Rate_mHz; the 10 MHz timestamps wrap every 429 s, so
+ * the default hour checks it across eight wraps. -R re-initializes every acquisition
+ * engine at the given time, restarting the sequence numbers, to check the resync path.
+ * -F injects bus outages of the given length every -I seconds, during which every transfer
+ * fails; the report then gives the recovery durations (last_recovery_ticks of each
+ * completed recovery) next to the backoff schedule of the engine.
+ *
+ * With -Q it instead compares bus idle time of the blocking calls against MS5611Queue in
+ * interrupt mode, for a PROM burst and one ADC read per sensor on a shared bus.
+ *
+ * With -L it runs MS5611LowPower back to back at every OSR: the wakeup hook arms a virtual
+ * 32.768 kHz LPTIM, the sleep hook (WFI/STOP) jumps the clock to its compare match and
+ * charges the STOP exit and clock restore as run time. The report gives the awake
+ * fraction per OSR, from the virtual clock and from the driver's own energy report.
+ *
+ * With -P the pressure follows a flight profile (ground, climb at 8 m/s, hover) and every
+ * sensor runs the adaptive OSR controller. Per phase the report gives the OSR switches,
+ * the delay from the phase start to the first sample at the OSR the phase calls for, the
+ * sample rate, and the noise of sensor 0 against the true pressure of each D1 conversion.
+ *
+ * Build (from the repository root):
+ *   cc -O2 -Itools/sim -I. tools/sim/ms5611_sim.c MS5611SPI.c \
+ *      MS5611Compensate.c MS5611Filter.c MS5611Thermal.c MS5611Hub.c MS5611Stream.c MS5611Queue.c \
+ *      MS5611LowPower.c -lm -o ms5611_sim
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stm32h5xx_hal.h"
+#include "MS5611SPI.h"
+#include "MS5611Stream.h"
+#include "MS5611Queue.h"
+#include "MS5611LowPower.h"
+#include "../ms5611_tool_util.h"
+
+#define SIM_MAX_SENSORS      8
+#define SIM_MAX_BUSES        4
+#define SIM_TICKS_PER_US     10U       /**< Virtual timestamp clock, 10 MHz */
+#define SIM_HAL_CALL_NS      1500U     /**< Blocking HAL SPI call overhead */
+#define SIM_IT_SETUP_NS      800U      /**< HAL_SPI_TransmitReceive_IT/_DMA setup */
+#define SIM_ISR_NS           600U      /**< Interrupt entry and HAL handler up to the callback */
+#define SIM_RESET_NS         2800000U  /**< Sensor reset reload time, datasheet */
+#define SIM_RETRY_NS         100000U   /**< Timed schedule: retry after a failed start */
+#define SIM_LATENCY_BINS     65536U    /**< 1 us latency bins, last bin collects overflow */
+#define SIM_LPTIM_HZ         32768U    /**< Low-power wakeup timer clock (LSE) */
+#define SIM_STOP_EXIT_NS     20000U    /**< STOP exit plus clock restore in the sleep hook */
+#define SIM_PHASES           3
+#define SIM_PHASE_NS         20000000000ULL  /**< Length of each flight phase */
+#define SIM_CLIMB_MPS        8.0       /**< Climb rate, about 96 Pa/s */
+#define SIM_PA_PER_M         12.0      /**< Pressure lapse near sea level */
+
+/* Datasheet typical conversion times; the driver waits for the maximum ones */
+static const uint32_t simConversionNs[5] = {540000, 1060000, 2080000, 4130000, 8220000};
+static const double simPressureRms[5] = {6.5, 4.2, 2.7, 1.8, 1.2};
+static const double simTemperatureRms[5] = {0.012, 0.008, 0.005, 0.003, 0.002};
+
+/* Datasheet example calibration, CRC filled in at start */
+static struct promData simProm = {0, 40127, 36924, 23317, 23282, 33464, 28312, 0};
+
+// --- MS5611 Device Model ---
+typedef struct {
+	uint8_t bus;
+	uint8_t selected;
+	uint8_t frame_pos;            /**< Bytes clocked in the current CS frame */
+	uint8_t out[3];               /**< Reply of the current command */
+	uint8_t out_len;
+	uint8_t converting;           /**< 0, CONVERT_D1_COMMAND or CONVERT_D2_COMMAND */
+	uint8_t osr_index;
+	uint8_t result_valid;
+	uint32_t result;
+	uint64_t conv_start;
+	uint64_t conv_done;
+	uint64_t busy_until;          /**< End of a reset reload */
+	double phase;                 /**< Pressure profile phase, decorrelates sensors */
+	uint32_t early_reads;         /**< ADC reads before the conversion finished */
+	uint32_t collisions;          /**< Commands received while converting or resetting */
+	double truth;                 /**< Noise-free pressure of the last D1 conversion, Pa */
+} Sim_Device_TypeDef;
+
+// --- Driver Side of One Sensor ---
+typedef struct {
+	MS5611_HW_InitTypeDef hw;
+	MS5611_Acquisition_TypeDef acq;
+	MS5611_Stream_TypeDef stream;
+	uint64_t next_wake;
+	uint64_t first_ns;
+	uint64_t last_ns;
+	uint32_t samples;
+	uint32_t invalid;
+	uint32_t recoveries_seen;     /**< Recoveries already added to the duration statistics */
+	uint32_t recovery_min;        /**< Shortest recovery, ticks */
+	uint32_t recovery_max;        /**< Longest recovery, ticks */
+	uint64_t recovery_sum;        /**< Sum of recovery durations, ticks */
+	MS5611_Adaptive_OSR_TypeDef adaptive;
+} Sim_Sensor_TypeDef;
+
+// --- Flight Profile Statistics of Sensor 0, per phase ---
+typedef struct {
+	uint32_t samples;
+	uint32_t switches;            /**< OSR changes between consecutive samples */
+	uint32_t fast;                /**< Samples at the fast OSR */
+	uint64_t settle_ns;           /**< Phase start to the first sample at the wanted OSR */
+	uint8_t settled;
+	double residual_sum;          /**< Output minus true pressure, Pa */
+	double residual_sq;
+} Sim_Phase_TypeDef;
+
+static uint64_t simNs;
+static uint64_t rngState = 1;
+static double spiHz = 8e6;
+static uint32_t errorPpm;
+static uint64_t outageNs;             /**< Bus outage length, 0 disables outages */
+static uint64_t outagePeriodNs = 10000000000ULL;
+static uint64_t busBusyNs[SIM_MAX_BUSES];
+static uint64_t busTransfers[SIM_MAX_BUSES];
+static uint64_t cpuNs;
+static uint32_t busErrors;
+
+/* Measurement window of the bus idle comparison: first bit to last bit, and bits in between */
+static uint64_t windowFirstNs;
+static uint64_t windowLastNs;
+static uint64_t windowBusyNs;
+static uint32_t windowTransfers;
+
+/* Transfer in flight in interrupt mode */
+static struct {
+	uint8_t active;
+	uint64_t done_ns;
+	SPI_HandleTypeDef *hspi;
+} simIt;
+static MS5611_Queue_TypeDef simQueue;
+
+static SPI_HandleTypeDef simSpi[SIM_MAX_BUSES];
+static GPIO_TypeDef simGpio[SIM_MAX_BUSES];
+static Sim_Device_TypeDef simDevice[SIM_MAX_SENSORS];
+static Sim_Sensor_TypeDef simSensor[SIM_MAX_SENSORS];
+static uint8_t simSensors = 1;
+static uint32_t latencyBins[SIM_LATENCY_BINS];
+static uint64_t latencyCount;
+static uint64_t latencySumUs;
+static int simProfile;
+static Sim_Phase_TypeDef simPhase[SIM_PHASES];
+static const char *const simPhaseName[SIM_PHASES] = {"ground", "climb", "hover"};
+
+uint32_t SystemCoreClock = 250000000U;
+
+static uint32_t Sim_Timestamp(void){
+	return (uint32_t) (simNs * SIM_TICKS_PER_US / 1000U);
+}
+
+/* Converts a tick count the driver is waiting for into a virtual-clock wakeup */
+static uint64_t Sim_Wake_After_Ticks(int32_t ticks){
+	if (ticks < 0)
+		ticks = 0;
+	return simNs + ((uint64_t) ticks + 1U) * 1000U / SIM_TICKS_PER_US;
+}
+
+/* Flight profile: 20 s on the ground, 20 s climbing, then hovering with a slow 0.3 m sway */
+static double Sim_Profile_Pressure(double seconds){
+	double phase = seconds / (SIM_PHASE_NS * 1e-9);
+	double altitude;
+
+	if (phase < 1.0)
+		altitude = 0.0;
+	else if (phase < 2.0)
+		altitude = SIM_CLIMB_MPS * (seconds - SIM_PHASE_NS * 1e-9);
+	else
+		altitude = SIM_CLIMB_MPS * SIM_PHASE_NS * 1e-9 + 0.3 * sin(3.141592653589793 * seconds);
+
+	return 100000.0 - SIM_PA_PER_M * altitude;
+}
+
+/**
+ * Physical signal at time t: 25 degC with a slow drift, pressure around 1000 hPa with a
+ * 30 m altitude swing every 10 minutes, or the flight profile with -P. Returned as raw words through the first-order
+ * inverse of the datasheet compensation (valid above 20 degC), with per-OSR noise.
+ */
+static uint32_t Sim_Device_Sample(Sim_Device_TypeDef *dev, uint8_t channel, uint64_t t){
+	double seconds = (double) t * 1e-9;
+	double temperature = 2500.0 + 150.0 * sin(6.283185307179586 * seconds / 3600.0 + dev->phase) +
+	                     100.0 * simTemperatureRms[dev->osr_index] * Tool_Gauss(&rngState);
+	double pressure = simProfile ? Sim_Profile_Pressure(seconds) :
+	                  100000.0 + 360.0 * sin(6.283185307179586 * seconds / 600.0 + dev->phase);
+	double noise = simPressureRms[dev->osr_index] * Tool_Gauss(&rngState);
+	double dT = (temperature - 2000.0) * 8388608.0 / simProm.tempsens;
+	double off, sens;
+
+	if (channel == CONVERT_D2_COMMAND)
+		return (uint32_t) llround(dT + simProm.tref * 256.0);
+
+	dev->truth = pressure;
+	pressure += noise;
+
+	off = simProm.off * 65536.0 + simProm.tco * dT / 128.0;
+	sens = simProm.sens * 32768.0 + simProm.tcs * dT / 256.0;
+	return (uint32_t) llround((pressure * 32768.0 + off) * 2097152.0 / sens);
+}
+
+static Sim_Device_TypeDef *Sim_Device_Selected(uint8_t bus){
+	uint8_t i;
+
+	for (i = 0; i < simSensors; i++)
+		if (simDevice[i].bus == bus && simDevice[i].selected)
+			return &simDevice[i];
+
+	return NULL;
+}
+
+static void Sim_Device_Command(Sim_Device_TypeDef *dev, uint8_t command){
+	uint32_t word;
+
+	dev->out_len = 0;
+
+	if (simNs < dev->busy_until) {
+		dev->collisions++;
+		return;
+	}
+
+	if (dev->converting && simNs >= dev->conv_done) {
+		dev->result = Sim_Device_Sample(dev, dev->converting, (dev->conv_start + dev->conv_done) / 2);
+		dev->result_valid = 1;
+		dev->converting = 0;
+	}
+
+	if (command == RESET_COMMAND) {
+		dev->converting = 0;
+		dev->result_valid = 0;
+		dev->busy_until = simNs + SIM_RESET_NS;
+	} else if ((command & 0xE0) == 0x40) {
+		if (dev->converting) {
+			dev->collisions++;
+			return;
+		}
+		dev->converting = command & 0xF0;
+		dev->osr_index = (uint8_t) ((command & 0x0F) >> 1);
+		if (dev->osr_index > 4)
+			dev->osr_index = 4;
+		dev->result_valid = 0;
+		dev->conv_start = simNs;
+		dev->conv_done = simNs + simConversionNs[dev->osr_index];
+	} else if (command == READ_ADC_COMMAND) {
+		if (dev->result_valid) {
+			uint64_t earliest = dev->conv_start + (uint64_t) MS5611_Conversion_Time_Us((uint8_t) (dev->osr_index << 1)) * 1000U;
+			uint64_t lateUs = (simNs > earliest) ? (simNs - earliest) / 1000U : 0;
+
+			latencyBins[(lateUs < SIM_LATENCY_BINS) ? lateUs : SIM_LATENCY_BINS - 1]++;
+			latencyCount++;
+			latencySumUs += lateUs;
+			word = dev->result;
+			dev->result_valid = 0;
+		} else {
+			dev->early_reads++;
+			word = 0;
+		}
+		dev->out[0] = (uint8_t) (word >> 16);
+		dev->out[1] = (uint8_t) (word >> 8);
+		dev->out[2] = (uint8_t) word;
+		dev->out_len = 3;
+	} else if ((command & 0xF0) == 0xA0) {
+		word = ((const uint16_t *) &simProm)[(command >> 1) & 0x07];
+		dev->out[0] = (uint8_t) (word >> 8);
+		dev->out[1] = (uint8_t) word;
+		dev->out_len = 2;
+	}
+}
+
+static uint8_t Sim_Device_Clock(Sim_Device_TypeDef *dev, uint8_t tx){
+	uint8_t rx = 0;
+
+	if (dev->frame_pos == 0)
+		Sim_Device_Command(dev, tx);
+	else if ((uint8_t) (dev->frame_pos - 1) < dev->out_len)
+		rx = dev->out[dev->frame_pos - 1];
+
+	if (dev->frame_pos < 0xFF)
+		dev->frame_pos++;
+
+	return rx;
+}
+
+/* Clocks one transfer through the selected device starting now, returns its bit time */
+static uint64_t Sim_Bus_Shift(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size){
+	Sim_Device_TypeDef *dev = Sim_Device_Selected(hspi->bus);
+	uint64_t bitNs = (uint64_t) (size * 8.0 * 1e9 / spiHz);
+	uint16_t i;
+
+	for (i = 0; i < size; i++) {
+		uint8_t in = (dev != NULL) ? Sim_Device_Clock(dev, (tx != NULL) ? tx[i] : 0xFF) : 0xFF;
+		if (rx != NULL)
+			rx[i] = in;
+	}
+
+	busBusyNs[hspi->bus] += bitNs;
+	busTransfers[hspi->bus]++;
+	if (windowTransfers++ == 0)
+		windowFirstNs = simNs;
+	windowLastNs = simNs + bitNs;
+	windowBusyNs += bitNs;
+
+	return bitNs;
+}
+
+static uint8_t Sim_Bus_Error(void){
+	/* Outages close every period, so initialization at t = 0 is clean */
+	if (outageNs != 0 && simNs % outagePeriodNs >= outagePeriodNs - outageNs) {
+		busErrors++;
+		return 1;
+	}
+	if (errorPpm != 0 && (Tool_Random(&rngState) % 1000000U) < errorPpm) {
+		busErrors++;
+		return 1;
+	}
+	return 0;
+}
+
+/* One blocking transfer: bit time on the bus plus call overhead on the CPU */
+static HAL_StatusTypeDef Sim_Transfer(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size){
+	uint64_t bitNs;
+
+	simNs += SIM_HAL_CALL_NS;
+	cpuNs += SIM_HAL_CALL_NS;
+
+	if (Sim_Bus_Error()) {
+		bitNs = (uint64_t) (size * 8.0 * 1e9 / spiHz);
+		busBusyNs[hspi->bus] += bitNs;
+		busTransfers[hspi->bus]++;
+		simNs += bitNs;
+		cpuNs += bitNs;
+		return HAL_ERROR;
+	}
+
+	bitNs = Sim_Bus_Shift(hspi, tx, rx, size);
+	simNs += bitNs;
+	cpuNs += bitNs;
+
+	return HAL_OK;
+}
+
+/* Interrupt-mode transfer: the CPU only pays the setup, completion is dispatched later */
+static HAL_StatusTypeDef Sim_Transfer_IT(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size){
+	if (simIt.active)
+		return HAL_BUSY;
+
+	simNs += SIM_IT_SETUP_NS;
+	cpuNs += SIM_IT_SETUP_NS;
+	if (Sim_Bus_Error())
+		return HAL_ERROR;
+
+	simIt.done_ns = simNs + Sim_Bus_Shift(hspi, tx, rx, size);
+	simIt.hspi = hspi;
+	simIt.active = 1;
+
+	return HAL_OK;
+}
+
+/* Dispatches completion interrupts until no transfer is in flight */
+static void Sim_Run_Interrupts(void){
+	while (simIt.active) {
+		if (simIt.done_ns > simNs)
+			simNs = simIt.done_ns;
+		simNs += SIM_ISR_NS;
+		cpuNs += SIM_ISR_NS;
+		simIt.active = 0;
+		HAL_SPI_TxRxCpltCallback(simIt.hspi);
+	}
+}
+
+static void Sim_Window_Reset(void){
+	windowFirstNs = 0;
+	windowLastNs = 0;
+	windowBusyNs = 0;
+	windowTransfers = 0;
+}
+
+uint32_t HAL_GetTick(void){
+	return (uint32_t) (simNs / 1000000U);
+}
+
+void HAL_Delay(uint32_t Delay){
+	simNs += (uint64_t) (Delay + 1U) * 1000000U;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState){
+	uint8_t i;
+
+	for (i = 0; i < simSensors; i++) {
+		if (simDevice[i].bus == GPIOx->port && (GPIO_Pin & (1U << i))) {
+			simDevice[i].selected = (PinState == GPIO_PIN_RESET);
+			simDevice[i].frame_pos = 0;
+		}
+	}
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi){
+	(void) hspi;
+	simNs += 5000U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_DeInit(SPI_HandleTypeDef *hspi){
+	(void) hspi;
+	simNs += 2000U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi){
+	(void) hspi;
+	simNs += 1000U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size, uint32_t Timeout){
+	(void) Timeout;
+	return Sim_Transfer(hspi, pData, NULL, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+	(void) Timeout;
+	return Sim_Transfer(hspi, NULL, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout){
+	(void) Timeout;
+	return Sim_Transfer(hspi, pTxData, pRxData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size){
+	return Sim_Transfer_IT(hspi, pTxData, pRxData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size){
+	return Sim_Transfer_IT(hspi, pTxData, pRxData, Size);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){
+	MS5611_Queue_SPI_Complete(&simQueue, hspi);
+}
+
+/* Adds one sample of sensor 0 to the statistics of the flight phase it completed in */
+static void Sim_Profile_Account(const MS5611_Sample_TypeDef *sample, uint8_t prevOsr){
+	uint64_t index = simNs / SIM_PHASE_NS;
+	Sim_Phase_TypeDef *phase = &simPhase[(index < SIM_PHASES) ? index : SIM_PHASES - 1];
+	uint8_t wanted = (phase == &simPhase[1]) ? simSensor[0].adaptive.fast_osr : simSensor[0].adaptive.precise_osr;
+	double residual = (double) sample->value.pressure - simDevice[0].truth;
+
+	phase->samples++;
+	if (prevOsr != 0xFF && sample->osr != prevOsr)
+		phase->switches++;
+	if (sample->osr == simSensor[0].adaptive.fast_osr)
+		phase->fast++;
+	if (!phase->settled && sample->osr == wanted) {
+		phase->settle_ns = simNs - (uint64_t) (phase - simPhase) * SIM_PHASE_NS;
+		phase->settled = 1;
+	}
+	phase->residual_sum += residual;
+	phase->residual_sq += residual * residual;
+}
+
+static void Sim_Profile_Print(double seconds){
+	uint8_t i;
+
+	printf("\nflight profile, sensor 0: %.0f s per phase, hover to the end, climb %.1f m/s (%.0f Pa/s)\n", SIM_PHASE_NS * 1e-9, SIM_CLIMB_MPS,
+	       SIM_CLIMB_MPS * SIM_PA_PER_M);
+	printf("phase   samples  rate_hz  switches  fast_%%  settle_ms  bias_pa  noise_pa\n");
+	for (i = 0; i < SIM_PHASES; i++) {
+		const Sim_Phase_TypeDef *phase = &simPhase[i];
+		double mean = phase->samples ? phase->residual_sum / phase->samples : 0.0;
+		double length = (i < SIM_PHASES - 1) ? SIM_PHASE_NS * 1e-9 : seconds - i * SIM_PHASE_NS * 1e-9;
+
+		printf("%-6s  %7u  %7.2f  %8u  %6.1f  ", simPhaseName[i], phase->samples, (length > 0.0) ? phase->samples / length : 0.0,
+		       phase->switches, phase->samples ? 100.0 * phase->fast / phase->samples : 0.0);
+		if (phase->settled)
+			printf("%9.1f  ", phase->settle_ns / 1e6);
+		else
+			printf("%9s  ", "-");
+		printf("%7.2f  %8.2f\n", mean, phase->samples ? sqrt(phase->residual_sq / phase->samples - mean * mean) : 0.0);
+	}
+}
+
+static uint64_t Sim_Latency_Percentile(double fraction){
+	uint64_t target = (uint64_t) ceil(fraction * (double) latencyCount);
+	uint64_t seen = 0;
+	uint32_t i;
+
+	if (target == 0)
+		target = 1;
+	for (i = 0; i < SIM_LATENCY_BINS; i++) {
+		seen += latencyBins[i];
+		if (seen >= target)
+			return i;
+	}
+
+	return SIM_LATENCY_BINS - 1;
+}
+
+static void Sim_Window_Print(const char *operation, const char *path, uint64_t cpuStart){
+	uint64_t span = windowLastNs - windowFirstNs;
+
+	printf("%-10s  %-8s  %9u  %8.1f  %8.1f  %8.1f  %6.1f  %7.1f\n", operation, path, windowTransfers, span / 1e3,
+	       windowBusyNs / 1e3, (span - windowBusyNs) / 1e3, span ? 100.0 * (double) (span - windowBusyNs) / (double) span : 0.0,
+	       (cpuNs - cpuStart) / 1e3);
+}
+
+static void Sim_Queue_Wait_Space(uint32_t needed){
+	while (MS5611_QUEUE_DEPTH - (simQueue.head - simQueue.tail) < needed) {
+		/* Dispatch one completion; its callback starts the next transfer */
+		uint8_t pending = simIt.active;
+		if (!pending)
+			break;
+		if (simIt.done_ns > simNs)
+			simNs = simIt.done_ns;
+		simNs += SIM_ISR_NS;
+		cpuNs += SIM_ISR_NS;
+		simIt.active = 0;
+		HAL_SPI_TxRxCpltCallback(simIt.hspi);
+	}
+}
+
+/* Virtual LPTIM: one-pulse compare match, rounded up to whole LSE ticks */
+static struct {
+	uint64_t wake_ns;
+	uint64_t sleep_ns;
+	uint64_t sleeps;
+	uint64_t awake_us;
+	uint64_t sleep_us;
+	uint64_t energy_nj;
+	uint32_t reports;
+} simLp;
+
+static void Sim_LP_Arm(void *context, uint32_t us){
+	uint64_t ticks = ((uint64_t) us * SIM_LPTIM_HZ + 999999U) / 1000000U;
+
+	(void) context;
+	simNs += SIM_HAL_CALL_NS;
+	simLp.wake_ns = simNs + ticks * 1000000000U / SIM_LPTIM_HZ + 1U;
+}
+
+static void Sim_LP_Sleep(void *context){
+	MS5611_LowPower_TypeDef *lp = (MS5611_LowPower_TypeDef *) context;
+
+	if (simLp.wake_ns > simNs) {
+		simLp.sleep_ns += simLp.wake_ns - simNs;
+		simNs = simLp.wake_ns;
+	}
+	simLp.sleeps++;
+	simNs += SIM_STOP_EXIT_NS;
+	MS5611_LowPower_Wakeup(lp);
+}
+
+static void Sim_LP_Energy(void *context, const MS5611_LowPower_Report_TypeDef *report){
+	(void) context;
+	simLp.awake_us += report->awake_us;
+	simLp.sleep_us += report->sleep_us;
+	simLp.energy_nj += report->energy_nj;
+	simLp.reports++;
+}
+
+/**
+ * Low-power acquisition at every OSR on the first sensor: samples back to back for the
+ * simulated time, temperature every decimation pressure samples.
+ */
+static int Sim_LowPower(uint8_t decimation, double seconds){
+	static MS5611_LowPower_TypeDef lp;
+	MS5611_Converted_Data_TypeDef value;
+	uint8_t osr;
+
+	printf("low-power acquisition: LPTIM %u Hz, STOP exit + clock restore %u us, temperature every %u samples, %.0f s per OSR\n\n",
+	       SIM_LPTIM_HZ, SIM_STOP_EXIT_NS / 1000U, decimation, seconds);
+	printf("  osr  samples  rate_hz  awake_%%  driver_awake_%%  awake_us/sample  energy_nj/sample  mean_ua\n");
+
+	for (osr = MS5611_OSR_256; osr <= MS5611_OSR_4096; osr = (uint8_t) (osr + 2)) {
+		uint64_t startNs = simNs;
+		uint64_t endNs = simNs + (uint64_t) (seconds * 1e9);
+		uint64_t samples = 0;
+		double total;
+
+		memset(&simLp, 0, sizeof(simLp));
+		MS5611_LowPower_Init(&lp, &simSensor[0].hw, osr, Sim_LP_Arm, Sim_LP_Sleep, &lp);
+		lp.temperature_decimation = decimation;
+		lp.on_energy = Sim_LP_Energy;
+
+		while (simNs < endNs) {
+			if (MS5611_LowPower_Sample(&lp, &value) != MS5611_STATE_READY) {
+				fprintf(stderr, "osr %u: sample failed\n", 256U << (osr >> 1));
+				return 1;
+			}
+			samples++;
+		}
+
+		total = (double) (simNs - startNs);
+		printf("  %4u  %7llu  %7.1f  %7.3f  %14.3f  %15.1f  %16.1f  %7.1f\n", 256U << (osr >> 1), (unsigned long long) samples,
+		       samples / (total * 1e-9), 100.0 * (total - (double) simLp.sleep_ns) / total,
+		       100.0 * (double) simLp.awake_us / (double) (simLp.awake_us + simLp.sleep_us),
+		       (total - (double) simLp.sleep_ns) / 1e3 / (double) samples, (double) simLp.energy_nj / (double) simLp.reports,
+		       (double) simLp.energy_nj / 3.3 / (total * 1e-9) / 1e3);
+	}
+
+	return 0;
+}
+
+/**
+ * Bus idle comparison on one bus: the PROM of every sensor, then one ADC read per sensor,
+ * first through the blocking driver calls, then through MS5611Queue in interrupt mode.
+ */
+static int Sim_Compare(void){
+	struct promData blocking[SIM_MAX_SENSORS];
+	struct promData queued[SIM_MAX_SENSORS];
+	uint32_t raw[SIM_MAX_SENSORS];
+	uint64_t cpuStart;
+	uint8_t i;
+	int mismatch = 0;
+
+	printf("bus idle comparison: %u sensors on one bus, spi %.0f Hz, HAL call %u ns, IT setup %u ns, ISR %u ns\n\n",
+	       simSensors, spiHz, SIM_HAL_CALL_NS, SIM_IT_SETUP_NS, SIM_ISR_NS);
+	printf("operation   path      transfers   span_us   busy_us   idle_us  idle_%%   cpu_us\n");
+
+	Sim_Window_Reset();
+	cpuStart = cpuNs;
+	for (i = 0; i < simSensors; i++)
+		MS5611PromRead(&simSensor[i].hw, &blocking[i]);
+	Sim_Window_Print("prom", "blocking", cpuStart);
+
+	MS5611_Queue_Init(&simQueue, &simSpi[0]);
+	Sim_Window_Reset();
+	cpuStart = cpuNs;
+	for (i = 0; i < simSensors; i++) {
+		Sim_Queue_Wait_Space(8);
+		MS5611_Queue_PROM_Read(&simQueue, &simSensor[i].hw, &queued[i], NULL, NULL);
+	}
+	Sim_Run_Interrupts();
+	Sim_Window_Print("prom", "queue", cpuStart);
+
+	for (i = 0; i < simSensors; i++)
+		if (memcmp(&blocking[i], &queued[i], sizeof(struct promData)) != 0)
+			mismatch = 1;
+
+	for (i = 0; i < simSensors; i++)
+		MS5611_Pressure_Conversion(&simSensor[i].hw, MS5611_OSR_256);
+	HAL_Delay(1);
+	Sim_Window_Reset();
+	cpuStart = cpuNs;
+	for (i = 0; i < simSensors; i++)
+		MS5611_ADC_Read(&simSensor[i].hw, &raw[i]);
+	Sim_Window_Print("adc reads", "blocking", cpuStart);
+
+	for (i = 0; i < simSensors; i++)
+		MS5611_Pressure_Conversion(&simSensor[i].hw, MS5611_OSR_256);
+	HAL_Delay(1);
+	Sim_Window_Reset();
+	cpuStart = cpuNs;
+	for (i = 0; i < simSensors; i++) {
+		Sim_Queue_Wait_Space(1);
+		MS5611_Queue_Submit(&simQueue, &simSensor[i].hw, READ_ADC_COMMAND, 3, &raw[i], NULL, NULL);
+	}
+	Sim_Run_Interrupts();
+	Sim_Window_Print("adc reads", "queue", cpuStart);
+
+	printf("\nqueue statistics: %u transfers in %u bursts, gap between callback and next start mean %.2f us, max %.2f us\n",
+	       simQueue.transactions, simQueue.bursts,
+	       simQueue.gaps ? (double) simQueue.gap_ticks / simQueue.gaps / SIM_TICKS_PER_US : 0.0,
+	       (double) simQueue.gap_max / SIM_TICKS_PER_US);
+	printf("prom through the queue %s the blocking read\n", mismatch ? "DIFFERS from" : "matches");
+
+	return mismatch;
+}
+
+static void Sim_Usage(const char *argv0){
+	fprintf(stderr, "usage: %s [-n sensors] [-b buses] [-o osr] [-d decimation] [-m poll|timed] [-p poll_us]\n"
+	                "       [-T seconds] [-s spi_hz] [-c cpu_us] [-l load_us] [-e error_ppm] [-F outage_ms] [-I outage_every_s]\n"
+	                "       [-D deadline_us] [-t tolerance_pct] [-r seed] [-R reinit_s] [-Q | -L | -P]\n", argv0);
+}
+
+int main(int argc, char **argv){
+	uint32_t osrValue = 4096;
+	uint8_t osrIndex = 4;
+	uint8_t decimation = 8;
+	uint8_t buses = 1;
+	int timed = 0;
+	int compare = 0;
+	int lowPower = 0;
+	uint64_t initStart;
+	uint64_t initNs = 0;
+	uint32_t pollUs = 500;
+	double seconds = 3600.0;
+	int secondsSet = 0;
+	uint32_t cpuUs = 2;
+	uint32_t loadUs = 0;
+	uint32_t deadlineUs = 0;
+	uint32_t tolerancePct = 5;
+	double reinitSeconds = 0.0;
+	uint64_t reinitNs = UINT64_MAX;
+	uint64_t endNs;
+	uint32_t conversionUs;
+	double nominalHz;
+	uint64_t polls = 0;
+	uint8_t prevOsr = 0xFF;
+	uint64_t totalLate = 0;
+	uint64_t totalSamples = 0;
+	int opt;
+	uint8_t i;
+
+	while ((opt = getopt(argc, argv, "n:b:o:d:m:p:T:s:c:l:e:F:I:D:t:r:R:QLP")) != -1) {
+		switch (opt) {
+		case 'n': simSensors = (uint8_t) atoi(optarg); break;
+		case 'b': buses = (uint8_t) atoi(optarg); break;
+		case 'o': osrValue = (uint32_t) atol(optarg); break;
+		case 'd': decimation = (uint8_t) atoi(optarg); break;
+		case 'm': timed = (strcmp(optarg, "timed") == 0); break;
+		case 'p': pollUs = (uint32_t) atol(optarg); break;
+		case 'T': seconds = atof(optarg); secondsSet = 1; break;
+		case 's': spiHz = atof(optarg); break;
+		case 'c': cpuUs = (uint32_t) atol(optarg); break;
+		case 'l': loadUs = (uint32_t) atol(optarg); break;
+		case 'e': errorPpm = (uint32_t) atol(optarg); break;
+		case 'F': outageNs = (uint64_t) (atof(optarg) * 1e6); break;
+		case 'I': outagePeriodNs = (uint64_t) (atof(optarg) * 1e9); break;
+		case 'D': deadlineUs = (uint32_t) atol(optarg); break;
+		case 't': tolerancePct = (uint32_t) atol(optarg); break;
+		case 'r': rngState = strtoull(optarg, NULL, 0) | 1U; break;
+		case 'R': reinitSeconds = atof(optarg); break;
+		case 'Q': compare = 1; buses = 1; break;
+		case 'L': lowPower = 1; simSensors = 1; break;
+		case 'P': simProfile = 1; break;
+		default: Sim_Usage(argv[0]); return 2;
+		}
+	}
+
+	for (osrIndex = 0; osrIndex < 5 && (256U << osrIndex) != osrValue; osrIndex++)
+		;
+	if (simSensors == 0 || simSensors > SIM_MAX_SENSORS || buses == 0 || buses > SIM_MAX_BUSES ||
+	    osrIndex == 5 || decimation == 0 || pollUs == 0 || seconds <= 0.0 || spiHz <= 0.0 || outagePeriodNs <= outageNs) {
+		Sim_Usage(argv[0]);
+		return 2;
+	}
+
+	if (simProfile && !secondsSet)
+		seconds = SIM_PHASES * SIM_PHASE_NS * 1e-9;
+
+	simProm.crc = MS5611_Prom_CRC4(&simProm);
+	conversionUs = MS5611_Conversion_Time_Us((uint8_t) (osrIndex << 1));
+	nominalHz = 1e6 * decimation / ((double) conversionUs * (decimation + 1U));
+
+	/* Default deadline: the longest nominal interval, a pressure sample right after a D2 */
+	if (deadlineUs == 0)
+		deadlineUs = 2U * conversionUs;
+
+	for (i = 0; i < buses; i++) {
+		simSpi[i].bus = i;
+		simGpio[i].port = i;
+	}
+
+	for (i = 0; i < simSensors; i++) {
+		Sim_Device_TypeDef *dev = &simDevice[i];
+		Sim_Sensor_TypeDef *s = &simSensor[i];
+
+		memset(dev, 0, sizeof(*dev));
+		dev->bus = (uint8_t) (i % buses);
+		dev->phase = 0.7 * i;
+
+		memset(s, 0, sizeof(*s));
+		s->hw.SPIhandler = &simSpi[dev->bus];
+		s->hw.CS_GPIOport = &simGpio[dev->bus];
+		s->hw.CS_GPIOpin = (uint16_t) (1U << i);
+		s->hw.SPI_Timeout = 10;
+		s->hw.GetTimestamp = Sim_Timestamp;
+		s->hw.TicksPerUs = SIM_TICKS_PER_US;
+
+		initStart = simNs;
+		if (MS5611_Init(&s->hw) != MS5611_STATE_READY) {
+			fprintf(stderr, "sensor %u: init failed\n", i);
+			return 1;
+		}
+		initNs += simNs - initStart;
+
+		/* Fast OSR above 60 Pa/s, back to OSR 4096 after 500 ms below 25 Pa/s, as in the README */
+		MS5611_Adaptive_OSR_Init(&s->adaptive, 60, 25, 10);
+		MS5611_Acquisition_Init(&s->acq, &s->hw, (uint8_t) (osrIndex << 1), decimation, simProfile ? &s->adaptive : NULL);
+		s->acq.self_healing = 1;
+		MS5611_Stream_Init(&s->stream, deadlineUs * SIM_TICKS_PER_US, deadlineUs * tolerancePct / 100U * SIM_TICKS_PER_US);
+		s->next_wake = simNs;
+	}
+
+	if (compare) {
+		printf("MS5611_Init: %.1f us per sensor, including the reset wait\n", initNs / 1e3 / simSensors);
+		return Sim_Compare();
+	}
+	if (lowPower)
+		return Sim_LowPower(decimation, (seconds < 60.0) ? seconds : 60.0);
+
+	cpuNs = 0;
+	for (i = 0; i < buses; i++) {
+		busBusyNs[i] = 0;
+		busTransfers[i] = 0;
+	}
+	endNs = simNs + (uint64_t) (seconds * 1e9);
+	if (reinitSeconds > 0.0)
+		reinitNs = simNs + (uint64_t) (reinitSeconds * 1e9);
+
+	for (;;) {
+		Sim_Sensor_TypeDef *s = NULL;
+		MS5611_Sample_TypeDef sample;
+		uint32_t now;
+
+		/* Next event: the earliest wakeup, lowest sensor index on ties */
+		for (i = 0; i < simSensors; i++)
+			if (s == NULL || simSensor[i].next_wake < s->next_wake)
+				s = &simSensor[i];
+		if (s->next_wake >= endNs)
+			break;
+
+		if (s->next_wake >= reinitNs) {
+			for (i = 0; i < simSensors; i++) {
+				MS5611_Acquisition_Init(&simSensor[i].acq, &simSensor[i].hw, (uint8_t) (osrIndex << 1), decimation, NULL);
+				simSensor[i].acq.self_healing = 1;
+			}
+			reinitNs = UINT64_MAX;
+		}
+
+		if (s->next_wake > simNs)
+			simNs = s->next_wake;
+		if (loadUs != 0)
+			simNs += (Tool_Random(&rngState) % ((uint64_t) loadUs * 1000U + 1U));
+		simNs += (uint64_t) cpuUs * 1000U;
+		cpuNs += (uint64_t) cpuUs * 1000U;
+		polls++;
+
+		if (MS5611_Acquisition_Process_Sample(&s->acq, &sample) == MS5611_STATE_READY) {
+			if (s->samples == 0)
+				s->first_ns = simNs;
+			s->last_ns = simNs;
+			s->samples++;
+			if (sample.flags & MS5611_SAMPLE_INVALID)
+				s->invalid++;
+			MS5611_Stream_Check(&s->stream, &sample);
+			if (simProfile && s == &simSensor[0] && !(sample.flags & MS5611_SAMPLE_INVALID))
+				Sim_Profile_Account(&sample, prevOsr);
+			if (s == &simSensor[0])
+				prevOsr = sample.osr;
+		}
+
+		if (s->acq.recoveries != s->recoveries_seen) {
+			uint32_t ticks = s->acq.last_recovery_ticks;
+
+			if (s->recoveries_seen == 0 || ticks < s->recovery_min)
+				s->recovery_min = ticks;
+			if (ticks > s->recovery_max)
+				s->recovery_max = ticks;
+			s->recovery_sum += ticks;
+			s->recoveries_seen = s->acq.recoveries;
+		}
+
+		if (!timed) {
+			while (s->next_wake <= simNs)
+				s->next_wake += (uint64_t) pollUs * 1000U;
+			continue;
+		}
+
+		now = Sim_Timestamp();
+		switch (s->acq.state) {
+		case MS5611_ACQ_CONVERTING_D1:
+		case MS5611_ACQ_CONVERTING_D2:
+			s->next_wake = Sim_Wake_After_Ticks((int32_t) (s->hw.Stamp.conversion_start +
+			               MS5611_Conversion_Time_Us(s->acq.active_osr) * SIM_TICKS_PER_US - now));
+			break;
+		case MS5611_ACQ_RECOVER_RESET:
+		case MS5611_ACQ_RECOVER_BACKOFF:
+			s->next_wake = Sim_Wake_After_Ticks((int32_t) (s->acq.wait_start + s->acq.wait_us * SIM_TICKS_PER_US - now));
+			break;
+		default:
+			s->next_wake = simNs + SIM_RETRY_NS;
+			break;
+		}
+	}
+
+	printf("config: sensors %u, buses %u, osr %u, decimation %u, schedule %s", simSensors, buses, osrValue, decimation,
+	       timed ? "timed" : "poll");
+	if (!timed)
+		printf(" %u us", pollUs);
+	printf(", spi %.0f Hz, cpu %u us/poll, load %u us, errors %u ppm, seed fixed\n", spiHz, cpuUs, loadUs, errorPpm);
+	if (outageNs != 0)
+		printf("bus outages: %.3f ms every %.3f s\n", outageNs / 1e6, outagePeriodNs / 1e9);
+	printf("simulated %.3f s, %llu polls, deadline %u us +%u%%\n\n", seconds, (unsigned long long) polls, deadlineUs, tolerancePct);
+
+	printf("sensor  bus  samples   rate_hz  stream_hz  nominal_hz  lost  gaps  late  resyncs  stale  invalid  bus_errors  recoveries  early_reads\n");
+	for (i = 0; i < simSensors; i++) {
+		Sim_Sensor_TypeDef *s = &simSensor[i];
+		double span = (double) (s->last_ns - s->first_ns) * 1e-9;
+
+		printf("%6u  %3u  %7u  %8.2f  %9.3f  %10.2f  %4u  %4u  %4u  %7u  %5u  %7u  %10u  %10u  %11u\n", i, simDevice[i].bus,
+		       s->samples, (s->samples > 1 && span > 0.0) ? (s->samples - 1) / span : 0.0,
+		       MS5611_Stream_Rate_mHz(&s->stream, SIM_TICKS_PER_US * 1000000U) / 1e3, nominalHz, s->stream.lost,
+		       s->stream.gaps, s->stream.late, s->stream.resyncs, s->stream.stale, s->invalid, s->acq.errors,
+		       s->acq.recoveries, simDevice[i].early_reads);
+		totalLate += s->stream.late;
+		totalSamples += s->samples;
+	}
+
+	printf("\n");
+	for (i = 0; i < buses; i++)
+		printf("bus %u: utilization %.4f %%, %llu transfers\n", i, 100.0 * (double) busBusyNs[i] / (seconds * 1e9),
+		       (unsigned long long) busTransfers[i]);
+	printf("cpu: %.4f %% in driver polls and blocking SPI\n", 100.0 * (double) cpuNs / (seconds * 1e9));
+	for (i = 0; i < simSensors; i++) {
+		Sim_Sensor_TypeDef *s = &simSensor[i];
+		uint32_t us;
+
+		if (s->recoveries_seen == 0)
+			continue;
+		if (i == 0 || simSensor[i - 1].recoveries_seen == 0) {
+			printf("recovery: threshold %u errors, reset wait %u us, backoff", MS5611_RECOVERY_THRESHOLD, MS5611_RESET_TIME_US);
+			for (us = MS5611_RECOVERY_BACKOFF_US; us < MS5611_RECOVERY_BACKOFF_MAX_US; us <<= 1)
+				printf(" %u", us / 1000U);
+			printf(" %u ms, then %u ms per attempt\n", MS5611_RECOVERY_BACKOFF_MAX_US / 1000U, MS5611_RECOVERY_BACKOFF_MAX_US / 1000U);
+		}
+		printf("recovery: sensor %u, %u completed, duration min %.3f  avg %.3f  max %.3f ms\n", i, s->recoveries_seen,
+		       s->recovery_min / (SIM_TICKS_PER_US * 1e3), (double) s->recovery_sum / s->recoveries_seen / (SIM_TICKS_PER_US * 1e3),
+		       s->recovery_max / (SIM_TICKS_PER_US * 1e3));
+	}
+	printf("deadlines: %llu missed of %llu samples (%.1f ppm)\n", (unsigned long long) totalLate, (unsigned long long) totalSamples,
+	       totalSamples ? 1e6 * (double) totalLate / (double) totalSamples : 0.0);
+
+	if (simProfile)
+		Sim_Profile_Print(seconds);
+
+	if (latencyCount != 0) {
+		uint32_t lo = 0;
+		uint32_t hi = 1;
+
+		printf("read latency past earliest permitted read (us): mean %.1f  p50 %llu  p90 %llu  p99 %llu  p99.9 %llu  max %llu\n",
+		       (double) latencySumUs / (double) latencyCount, (unsigned long long) Sim_Latency_Percentile(0.5),
+		       (unsigned long long) Sim_Latency_Percentile(0.9), (unsigned long long) Sim_Latency_Percentile(0.99),
+		       (unsigned long long) Sim_Latency_Percentile(0.999), (unsigned long long) Sim_Latency_Percentile(1.0));
+		while (lo < SIM_LATENCY_BINS) {
+			uint64_t count = 0;
+			uint32_t k;
+
+			for (k = lo; k < hi && k < SIM_LATENCY_BINS; k++)
+				count += latencyBins[k];
+			if (count != 0)
+				printf("  [%5u, %5u) us  %10llu\n", lo, hi, (unsigned long long) count);
+			lo = hi;
+			hi <<= 1;
+		}
+	}
+
+	return 0;
+}